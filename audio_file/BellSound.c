@@ -1,6 +1,23 @@
-#include "main.h"
+#include <stddef.h>
+#include "BellSound.h"
 
-const unsigned char __attribute__((section(".myAudioFiles")))rawData[BELL_ARRAY_SIZE] = {
+const BellSound_Asset_t __attribute__((section(".myAudioFiles"), aligned(4)))bellSound = {
+	.header = {
+		.magic = MCP4822_ASSET_MAGIC,
+		.version = MCP4822_ASSET_VERSION,
+		.codec = MCP4822_CODEC_IMA_ADPCM,
+		.layout = MCP4822_LAYOUT_MONO,
+		.flags = 0,
+		.sample_rate = BELL_SAMPLE_RATE,
+		.sample_count = BELL_SAMPLE_COUNT,
+		.loop_start = 0,
+		.loop_end = BELL_SAMPLE_COUNT,
+		.block_size = 64,
+		.header_size = offsetof(BellSound_Asset_t, data),
+		.payload_size = BELL_ARRAY_SIZE,
+		.seek_interval = 0
+	},
+	.data = {
 	0xC3, 0x08, 0x84, 0xB8, 0x04, 0x0C, 0x0B, 0x3C, 0x60, 0xA8, 0x2A, 0x80,
 	0x80, 0x00, 0x04, 0xB0, 0x88, 0x4B, 0x80, 0x00, 0x04, 0xB0, 0x8D, 0x20,
 	0x00, 0x40, 0xC3, 0xB8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04,
@@ -1600,4 +1617,5 @@ const unsigned char __attribute__((section(".myAudioFiles")))rawData[BELL_ARRAY_
 	0x8D, 0x24, 0x8A, 0x88, 0x08, 0x84, 0x08, 0xC8, 0x08, 0x4B, 0xC3, 0x08,
 	0x0C, 0x30, 0xD2, 0x00, 0x04, 0xB8, 0xC8, 0x48, 0x3B, 0x00, 0x04, 0xB0,
 	0xD2, 0x0B, 0x79, 0x80, 0x08, 0x02, 0xB0, 0x80
+	}
 };
@@ -0,0 +1,35 @@
+/*
+ * BellSound.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __BELLSOUND_H_
+#define __BELLSOUND_H_
+
+#include "main.h"
+#include "MCP4822_asset.h"
+
+/** Bell sample properties */
+#define BELL_SAMPLE_RATE			   8000
+#define BELL_SAMPLE_COUNT			   (BELL_ARRAY_SIZE * 2)    //two IMA ADPCM codes per byte
+
+/**
+ * @brief Bell asset image, header followed by the packed ADPCM payload
+ */
+typedef struct
+{
+
+	MCP4822_Asset_Header_t header;
+
+	unsigned char data[BELL_ARRAY_SIZE];
+
+}BellSound_Asset_t;
+
+extern const BellSound_Asset_t bellSound;
+
+/** Packed ADPCM payload, the bytes of the former rawData array */
+#define BELL_RAW_DATA				   (bellSound.data)
+
+#endif /* __BELLSOUND_H_ */
@@ -9,7 +9,7 @@
 #define __MCP4822_H_
 
 #include <stdlib.h>
-#include "stm32l5xx_hal.h"
+#include "MCP4822_port.h"
 
 /** Bit Manipulation Macros */
 #define SHIFT_4    			       	   4
@@ -25,6 +25,14 @@
 #define MCP4822_DAC_MAX				   4095
 #define MCP4822_VREF				   2.048f
 #define MCP4822_SPI_TIMEOUT			   1    //1 msec timeout
+#define MCP4822_TIMER_MAX_PERIOD	   65536
+#define MCP4822_SPI_FRAMES_PER_MS	   256  //conservative frame rate used to scale burst timeouts
+
+/** 16-bit SPI frame (command word) layout */
+#define MCP4822_FRAME_CHAN_POS		   15
+#define MCP4822_FRAME_GAIN_POS		   13
+#define MCP4822_FRAME_SHDN_POS		   12
+#define MCP4822_FRAME_DATA_MASK		   0x0FFF
 
 /**
  * @brief MCP4822 channel select mapping
@@ -56,6 +64,27 @@ typedef enum
 
 }MCP4822_OUTPUT_MODE;
 
+/**
+ * @brief Fixed-point voltage unit mapping
+ */
+typedef enum
+{
+	MCP4822_UNIT_MILLIVOLTS			 = 0,
+	MCP4822_UNIT_MICROVOLTS			 = 1,
+	MCP4822_UNIT_Q16_VOLTS			 = 2
+
+}MCP4822_VOLT_UNIT;
+
+/**
+ * @brief MCP4822 chip select drive mapping
+ */
+typedef enum
+{
+	MCP4822_CS_SOFTWARE			     = 0,
+	MCP4822_CS_HARDWARE_NSS			 = 1
+
+}MCP4822_CS_MODE;
+
 /**
  * @brief Error mapping for driver functions
  */
@@ -63,7 +92,9 @@ typedef enum
 {
 	MCP4822_OK						 =  0,
     MCP4822_ERROR_INVALID_ARG   	 = -1,
-    MCP4822_ERROR_SPI 				 = -2
+    MCP4822_ERROR_SPI 				 = -2,
+    MCP4822_ERROR_BUSY 				 = -3,
+    MCP4822_ERROR_FORMAT 			 = -4
 
 }MCP4822_STATUS;
 
@@ -91,6 +122,26 @@ typedef struct
 
 }MCP4822_Chan_Configs_t;
 
+/**
+ * @brief Interrupt-driven write queue, see MCP4822_async.h
+ */
+typedef struct MCP4822_Async MCP4822_Async_t;
+
+/**
+ * @brief Lock-free frame FIFO, see MCP4822_fifo.h
+ */
+typedef struct MCP4822_Fifo MCP4822_Fifo_t;
+
+/**
+ * @brief Per-channel output calibration, see MCP4822_cal.h
+ */
+typedef struct MCP4822_Cal MCP4822_Cal_t;
+
+/**
+ * @brief Write path timing and error counters, see MCP4822_stats.h
+ */
+typedef struct MCP4822_Stats MCP4822_Stats_t;
+
 /**
  * @brief MCP4822 Driver Handle struct
  */
@@ -99,25 +150,100 @@ typedef struct
 
 	MCP4822_Chan_Configs_t chan_configs;
 
-	GPIO_TypeDef *CS_Port;
+	MCP4822_Gpio_t *CS_Port;
 
 	uint16_t CS_Pin;
 
-    SPI_HandleTypeDef *hspi;
+    MCP4822_Spi_t *hspi;
+
+    MCP4822_Timer_t *htim;
+
+    uint32_t timer_clock_hz;
+
+    uint32_t sample_rate;
+
+    uint16_t chan_headers[2];
+
+    MCP4822_Gpio_t *LDAC_Port;
+
+    uint16_t LDAC_Pin;
+
+    MCP4822_CS_MODE cs_mode;
+
+    MCP4822_Async_t *async;
+
+    MCP4822_Fifo_t *fifo;
+
+    MCP4822_Cal_t *cal;
+
+    uint16_t cal_codes[2];
+
+    uint16_t shadow_frames[2];
+
+    uint8_t shadow_valid;
+
+    uint8_t force_writes;
+
+    uint32_t frames_sent;
+
+    uint32_t frames_suppressed;
+
+#ifdef MCP4822_ENABLE_STATS
+    MCP4822_Stats_t *stats;
+#endif
 
 }MCP4822_Handle_t;
 
 /**
  * @brief Initializes the MCP4822 driver handle and enable the outputs
  *
+ * Every write is sent as a single 16-bit frame. If the SPI is set to another
+ * data size it is switched to 16 bits and re-initialized (HAL_SPI_Init with the
+ * default binding), so other devices sharing that SPI see the new data size
+ * too; an SPI already set to 16 bits is left untouched. If the SPI is already
+ * configured for hardware NSS output with NSS pulse mode and CPHA = 0 the
+ * handle starts in MCP4822_CS_HARDWARE_NSS mode.
+ *
+ * The function used to return void. The handle is fully initialized either
+ * way, MCP4822_ERROR_SPI only reports that the SPI could not be switched.
+ *
  * @param handle - handle for MCP4822 driver
  * @param cs_port - CS pin GPIO port
  * @param cs_pin - CS GPIO pin number
- * @param hspi - STM32x SPI peripheral handle
+ * @param hspi - SPI peripheral handle, an STM32x HAL handle with the default binding
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI if the SPI could not be re-initialized
+ */
+MCP4822_STATUS MCP4822_handle_init(MCP4822_Handle_t *handle, MCP4822_Gpio_t *cs_port, uint16_t cs_pin, MCP4822_Spi_t *hspi);
+
+/**
+ * @brief Builds the 16-bit SPI frame for a DAC value from the channel's cached header word
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param value - digital value to be encoded (masked to 12 bits)
+ * @param dac_channel - DAC channel the frame is addressed to
+ *
+ * @return Encoded frame, ready to be sent as one 16-bit SPI word
+ */
+static inline uint16_t MCP4822_encode_frame(const MCP4822_Handle_t *handle, uint16_t value, MCP4822_DAC_SELECT dac_channel){
+
+	return handle->chan_headers[dac_channel & FIRST_BIT_MASK] | (value & MCP4822_FRAME_DATA_MASK);
+}
+
+/**
+ * @brief Pulses LDAC low to move both input registers to the outputs, no-op without an LDAC pin
+ *
+ * @param handle - handle for MCP4822 driver
  *
  * @return None
  */
-void MCP4822_handle_init(MCP4822_Handle_t *handle, GPIO_TypeDef *cs_port, uint16_t cs_pin, SPI_HandleTypeDef *hspi);
+static inline void MCP4822_pulse_ldac(const MCP4822_Handle_t *handle){
+
+	if(handle->LDAC_Port != NULL){
+		MCP4822_port_pin_write(handle->LDAC_Port, handle->LDAC_Pin, 0);
+		MCP4822_port_pin_write(handle->LDAC_Port, handle->LDAC_Pin, 1);
+	}
+}
 
 /**
  * @brief Writes new DAC data to one of the MCP4822 device channels using SPI
@@ -133,6 +259,9 @@ MCP4822_STATUS MCP4822_write_to_chan(MCP4822_Handle_t *handle, uint16_t value, M
 /**
  * @brief Shutdowns one of the DAC channels
  *
+ * The last value sent to the channel is re-sent with the shutdown bit, so
+ * the input register keeps the level the channel will resume at.
+ *
  * @param handle - handle for MCP4822 driver
  * @param dac_channel - DAC channel to be shutdown
  *
@@ -143,6 +272,8 @@ MCP4822_STATUS MCP4822_shutdown_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELEC
 /**
  * @brief Activates one of the DAC channels
  *
+ * The output wakes at the last value sent to the channel instead of zero.
+ *
  * @param handle - handle for MCP4822 driver
  * @param dac_channel - DAC channel to be activated
  *
@@ -151,15 +282,37 @@ MCP4822_STATUS MCP4822_shutdown_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELEC
 MCP4822_STATUS MCP4822_activate_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel);
 
 /**
- * @brief Set the gain for one of the DAC channels
+ * @brief Set the gain for one of the DAC channels and apply it immediately
+ *
+ * The last value sent to the channel is re-sent with the new gain bit in one
+ * transaction.
+ *
+ * Unlike earlier versions, which returned void and only stored the gain for
+ * the next write, this performs an SPI transfer and reports its result.
+ * Before any value has been written the channel's last value is code 0, so
+ * a gain change then drives the output to 0 V.
  *
  * @param handle - handle for MCP4822 driver
  * @param dac_channel - DAC channel that's gain will be changed
  * @param gain_update - updated gain value (1X or 2X)
  *
- * @return None
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
  */
-void MCP4822_set_chan_gain(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain_update);
+MCP4822_STATUS MCP4822_set_chan_gain(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain_update);
+
+/**
+ * @brief Updates the gain and shutdown configuration of both channels in one burst
+ *
+ * Both channels are re-sent with their last values and the new configuration
+ * and latched together by one LDAC pulse. A channel whose frame does not
+ * change is not re-sent.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param configs - new configuration of channels A and B
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_configure(MCP4822_Handle_t *handle, const MCP4822_Chan_Configs_t *configs);
 
 /**
  * @brief Writes new DAC data to both of the MCP4822 device channels using SPI
@@ -171,6 +324,230 @@ void MCP4822_set_chan_gain(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_chan
  */
 MCP4822_STATUS MCP4822_write_to_both_chans(MCP4822_Handle_t *handle, uint16_t value);
 
+/**
+ * @brief Selects how CS is driven
+ *
+ * MCP4822_CS_HARDWARE_NSS reconfigures the SPI for hardware NSS output with NSS
+ * pulse mode, so consecutive frames each get their own CS edge and multi-frame
+ * bursts need no CPU help. The CS pin must then be the SPI NSS alternate
+ * function and the SPI must use CPHA = 0 (SPI_PHASE_1EDGE): the peripheral
+ * only pulses NSS between frames in that phase, so with CPHA = 1 the device
+ * would see one long frame and latch nothing. MCP4822_CS_SOFTWARE toggles the
+ * GPIO given to MCP4822_handle_init around every frame.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param cs_mode - chip select drive mode
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG for hardware NSS with CPHA = 1, MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_set_cs_mode(MCP4822_Handle_t *handle, MCP4822_CS_MODE cs_mode);
+
+/**
+ * @brief Sends a burst of pre-encoded frames, each latched by its own CS edge
+ *
+ * With an LDAC pin assigned, LDAC is pulsed once after the whole burst went
+ * out, so the outputs change together like after MCP4822_write_pair. A failed
+ * burst is not latched.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param frames - encoded frames (see MCP4822_encode_frame)
+ * @param count - number of frames to send
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_write_frames(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count);
+
+/**
+ * @brief Makes blocking writes send every frame, even one identical to the last frame sent to the channel
+ *
+ * Redundant writes are skipped by default: MCP4822_write_to_chan,
+ * MCP4822_write_pair and the functions built on them compare each frame,
+ * value and configuration bits together, with a shadow of the last frame
+ * sent to that channel. frames_sent and frames_suppressed in the handle
+ * count both outcomes.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param force - non-zero to always send, 0 to skip redundant frames
+ *
+ * @return None
+ */
+void MCP4822_set_force_writes(MCP4822_Handle_t *handle, uint8_t force);
+
+/**
+ * @brief Forgets the frames last sent so the next write to each channel is always sent
+ *
+ * Call after anything outside the blocking write functions may have changed
+ * the device, e.g. a power cycle. The driver's own DMA, async, stream and bus
+ * paths already do this.
+ *
+ * @param handle - handle for MCP4822 driver
+ *
+ * @return None
+ */
+static inline void MCP4822_invalidate_shadow(MCP4822_Handle_t *handle){
+
+	handle->shadow_valid = 0;
+}
+
+/**
+ * @brief Notes frames sent outside the blocking writes
+ *
+ * The frames become each channel's last value for configuration changes,
+ * while the shadows are invalidated since delivery is not confirmed yet.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param frames - encoded frames
+ * @param count - number of frames
+ *
+ * @return None
+ */
+static inline void MCP4822_note_frames(MCP4822_Handle_t *handle, const uint16_t *frames, uint32_t count){
+
+	for(uint32_t i = 0; i < count; i++){
+		handle->shadow_frames[frames[i] >> MCP4822_FRAME_CHAN_POS] = frames[i];
+	}
+
+	handle->shadow_valid = 0;
+}
+
+/**
+ * @brief Starts a DMA burst of pre-encoded frames without CPU involvement, hardware NSS mode only
+ *
+ * The frames must stay valid until HAL_SPI_TxCpltCallback is called. The
+ * burst is not latched: with an LDAC pin assigned, call MCP4822_pulse_ldac
+ * once the transfer completes.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param frames - encoded frames (see MCP4822_encode_frame)
+ * @param count - number of frames to send
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_write_frames_dma(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count);
+
+/**
+ * @brief Attaches a sample FIFO that feeds the handle's stream when no refill callback is given
+ *
+ * The FIFO's underrun frame is reset to a zero write on channel A so an
+ * underrun before the first frame never shuts a channel down.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param fifo - initialized FIFO, NULL to detach
+ *
+ * @return None
+ */
+void MCP4822_attach_fifo(MCP4822_Handle_t *handle, MCP4822_Fifo_t *fifo);
+
+/**
+ * @brief Attaches a calibration applied to the codes of subsequent writes
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param cal - initialized calibration, NULL to detach
+ *
+ * @return None
+ */
+void MCP4822_attach_cal(MCP4822_Handle_t *handle, MCP4822_Cal_t *cal);
+
+/**
+ * @brief Assigns the LDAC pin so both channels can be latched by a single pulse
+ *
+ * LDAC is held high between writes so frames only load the input registers.
+ * Single channel writes still pulse LDAC afterwards to update the output.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param ldac_port - LDAC pin GPIO port, NULL if LDAC is tied low
+ * @param ldac_pin - LDAC GPIO pin number
+ *
+ * @return None
+ */
+void MCP4822_set_ldac_pin(MCP4822_Handle_t *handle, MCP4822_Gpio_t *ldac_port, uint16_t ldac_pin);
+
+/**
+ * @brief Writes new DAC data to both channels and updates both outputs at the same instant
+ *
+ * Without an LDAC pin the channels are written back to back and channel A
+ * changes one SPI frame before channel B.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param a_value - digital value to be sent to channel A
+ * @param b_value - digital value to be sent to channel B
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_write_pair(MCP4822_Handle_t *handle, uint16_t a_value, uint16_t b_value);
+
+/**
+ * @brief Converts a voltage to DAC digital units using the channel's current gain
+ *
+ * The result is rounded to the nearest code and saturated to 0..MCP4822_DAC_MAX.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param volts - voltage value to be converted
+ * @param dac_channel - DAC channel whose gain is used
+ *
+ * @return Converted voltage value
+ */
+uint16_t MCP4822_volts_to_chan_units(MCP4822_Handle_t *handle, float volts, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Codes per volt for the channel's current gain
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - DAC channel whose gain is used
+ *
+ * @return DAC codes per volt
+ */
+float MCP4822_chan_volt_scale(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Converts a fixed-point voltage to DAC digital units using integer math only
+ *
+ * Uses a per-gain precomputed multiply/shift scale, rounds half up and
+ * saturates to 0..MCP4822_DAC_MAX.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param value - voltage in millivolts, microvolts or Q16.16 volts
+ * @param unit - unit of value
+ * @param dac_channel - DAC channel whose gain is used
+ * @param DAC_value - converted voltage value, left untouched on error
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG for an unknown unit
+ */
+MCP4822_STATUS MCP4822_fixed_volts_to_chan_units(MCP4822_Handle_t *handle, int32_t value, MCP4822_VOLT_UNIT unit, MCP4822_DAC_SELECT dac_channel, uint16_t *DAC_value);
+
+/**
+ * @brief Writes new DAC data, after converting from millivolts, to one of the MCP4822 device channels using SPI
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param millivolts - voltage in millivolts, saturated to the channel's output range
+ * @param dac_channel - DAC channel to be written to
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_write_millivolts_to_chan(MCP4822_Handle_t *handle, int32_t millivolts, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Writes new DAC data, after converting from microvolts, to one of the MCP4822 device channels using SPI
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param microvolts - voltage in microvolts, saturated to the channel's output range
+ * @param dac_channel - DAC channel to be written to
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_write_microvolts_to_chan(MCP4822_Handle_t *handle, int32_t microvolts, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Writes new DAC data, after converting from Q16.16 volts, to one of the MCP4822 device channels using SPI
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param volts_q16 - voltage in Q16.16 volts, saturated to the channel's output range
+ * @param dac_channel - DAC channel to be written to
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_write_q16_volts_to_chan(MCP4822_Handle_t *handle, int32_t volts_q16, MCP4822_DAC_SELECT dac_channel);
+
 /**
  * @brief Writes new DAC data, after converting from volts, to one of the MCP4822 device channels using SPI
  *
@@ -185,6 +562,9 @@ MCP4822_STATUS MCP4822_write_volts_to_chan(MCP4822_Handle_t *handle, float volts
 /**
  * @brief Writes new DAC data, after converting from volts, to both of the MCP4822 device channels using SPI
  *
+ * Each channel converts with its own gain and both frames go out through
+ * MCP4822_write_pair, so the outputs change together.
+ *
  * @param handle - handle for MCP4822 driver
  * @param volts - voltage value to be converted and sent to the DACs
  *
@@ -192,4 +572,29 @@ MCP4822_STATUS MCP4822_write_volts_to_chan(MCP4822_Handle_t *handle, float volts
  */
 MCP4822_STATUS MCP4822_write_volts_to_both_chans(MCP4822_Handle_t *handle, float volts);
 
+/**
+ * @brief Configures a timer as the sample clock for paced output
+ *
+ * The timer update event becomes the DMA request that moves each frame into the
+ * SPI data register, so the DAC update rate no longer depends on CPU load. The
+ * timer must have a DMA channel linked to its update request.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param htim - timer handle used as the sample clock
+ * @param timer_clock_hz - timer kernel clock frequency in Hz
+ * @param sample_rate - requested frame rate in Hz
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_set_sample_rate(MCP4822_Handle_t *handle, MCP4822_Timer_t *htim, uint32_t timer_clock_hz, uint32_t sample_rate);
+
+/**
+ * @brief Reports the frame rate the timer actually produces after prescaler rounding
+ *
+ * @param handle - handle for MCP4822 driver
+ *
+ * @return Achieved sample rate in Hz, 0 if no sample clock is configured
+ */
+float MCP4822_get_actual_sample_rate(MCP4822_Handle_t *handle);
+
 #endif /* __MCP4822_H_ */
@@ -0,0 +1,163 @@
+/*
+ * MCP4822_adpcm.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_ADPCM_H_
+#define __MCP4822_ADPCM_H_
+
+#include "MCP4822.h"
+
+/** IMA ADPCM table limits */
+#define MCP4822_ADPCM_STEP_INDEX_MAX   88
+#define MCP4822_ADPCM_NIBBLE_BITS	   4
+
+/**
+ * @brief Order of the two 4-bit codes packed in each byte
+ */
+typedef enum
+{
+	MCP4822_ADPCM_HIGH_NIBBLE_FIRST	 = 0,
+	MCP4822_ADPCM_LOW_NIBBLE_FIRST	 = 1
+
+}MCP4822_ADPCM_NIBBLE_ORDER;
+
+/**
+ * @brief IMA ADPCM decoder state
+ */
+typedef struct
+{
+
+	int16_t predictor;
+
+	uint8_t step_index;
+
+}MCP4822_ADPCM_State_t;
+
+/**
+ * @brief Streaming decoder for a packed nibble-coded asset kept in flash
+ *
+ * Decodes straight into MCP4822 frames, so the only RAM needed besides this
+ * struct is the stream's ping-pong frame buffer.
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	MCP4822_DAC_SELECT dac_channel;
+
+	const uint8_t *data;
+
+	uint32_t sample_count;
+
+	uint32_t position;
+
+	MCP4822_ADPCM_State_t state;
+
+	MCP4822_ADPCM_NIBBLE_ORDER nibble_order;
+
+	uint8_t loop;
+
+}MCP4822_ADPCM_Stream_t;
+
+/**
+ * @brief Decodes nibble-coded samples into 16-bit PCM
+ *
+ * @param state - decoder state, updated in place
+ * @param data - packed nibble stream
+ * @param first_sample - index of the first nibble to decode
+ * @param pcm - output samples
+ * @param count - number of samples to decode
+ * @param nibble_order - order of the nibbles within a byte
+ *
+ * @return None
+ */
+void MCP4822_adpcm_decode(MCP4822_ADPCM_State_t *state, const uint8_t *data, uint32_t first_sample, int16_t *pcm, uint32_t count,
+						  MCP4822_ADPCM_NIBBLE_ORDER nibble_order);
+
+/**
+ * @brief Decodes nibble-coded samples straight into MCP4822 frames
+ *
+ * @param state - decoder state, updated in place
+ * @param data - packed nibble stream
+ * @param first_sample - index of the first nibble to decode
+ * @param frames - output frames
+ * @param count - number of samples to decode
+ * @param nibble_order - order of the nibbles within a byte
+ * @param header - channel header word ORed into every frame
+ *
+ * @return None
+ */
+void MCP4822_adpcm_decode_frames(MCP4822_ADPCM_State_t *state, const uint8_t *data, uint32_t first_sample, uint16_t *frames, uint32_t count,
+								 MCP4822_ADPCM_NIBBLE_ORDER nibble_order, uint16_t header);
+
+/**
+ * @brief Advances the decoder state over samples without producing output
+ *
+ * @param state - decoder state, updated in place
+ * @param data - packed nibble stream
+ * @param first_sample - index of the first nibble to skip
+ * @param count - number of samples to skip
+ * @param nibble_order - order of the nibbles within a byte
+ *
+ * @return None
+ */
+void MCP4822_adpcm_skip(MCP4822_ADPCM_State_t *state, const uint8_t *data, uint32_t first_sample, uint32_t count,
+						MCP4822_ADPCM_NIBBLE_ORDER nibble_order);
+
+/**
+ * @brief Initializes a streaming decoder at the start of the asset
+ *
+ * @param stream - decoder to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - DAC channel the frames are addressed to
+ * @param data - packed nibble stream, e.g. BELL_RAW_DATA
+ * @param size - length of data in bytes, two samples per byte
+ * @param nibble_order - order of the nibbles within a byte
+ *
+ * @return None
+ */
+void MCP4822_adpcm_stream_init(MCP4822_ADPCM_Stream_t *stream, MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel,
+							   const uint8_t *data, uint32_t size, MCP4822_ADPCM_NIBBLE_ORDER nibble_order);
+
+/**
+ * @brief Restarts decoding from the first sample
+ *
+ * @param stream - decoder to be rewound
+ *
+ * @return None
+ */
+void MCP4822_adpcm_stream_rewind(MCP4822_ADPCM_Stream_t *stream);
+
+/**
+ * @brief Stream refill callback decoding the next block into MCP4822 frames
+ *
+ * Pass it to MCP4822_stream_init with the decoder as context. The work per
+ * call is a fixed cost per sample, so the refill time of a half buffer is
+ * bounded by its length. Returns a short count at the end of the asset
+ * unless looping is enabled.
+ *
+ * @param context - MCP4822_ADPCM_Stream_t to decode from
+ * @param frames - destination for the encoded frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written
+ */
+uint32_t MCP4822_adpcm_stream_refill(void *context, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Converts a signed 16-bit PCM sample to a 12-bit DAC value
+ *
+ * @param sample - signed PCM sample
+ *
+ * @return DAC value, 0 .. MCP4822_DAC_MAX
+ */
+static inline uint16_t MCP4822_pcm_to_DAC_units(int16_t sample){
+
+	return (uint16_t)(((int32_t)sample + 32768) >> (16 - MCP4822_RES));
+}
+
+#endif /* __MCP4822_ADPCM_H_ */
@@ -0,0 +1,243 @@
+/*
+ * MCP4822_asset.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_ASSET_H_
+#define __MCP4822_ASSET_H_
+
+#include "MCP4822.h"
+#include "MCP4822_adpcm.h"
+#include "MCP4822_source.h"
+
+/** Asset header identification, "MCPA" in memory order */
+#define MCP4822_ASSET_MAGIC			   0x4150434DUL
+#define MCP4822_ASSET_VERSION		   2
+
+/** Asset header flags */
+#define MCP4822_ASSET_FLAG_LOOP		   0x01    //loop between loop_start and loop_end by default
+#define MCP4822_ASSET_FLAG_LOW_NIBBLE  0x02    //ADPCM nibbles are stored low half first
+#define MCP4822_ASSET_FLAG_SEEK_TABLE  0x04    //ADPCM decoder snapshots every seek_interval samples follow the header
+
+/**
+ * @brief Payload codec mapping
+ */
+typedef enum
+{
+	MCP4822_CODEC_PCM12				 = 0,    //one little-endian uint16 per sample, 0 .. MCP4822_DAC_MAX
+	MCP4822_CODEC_IMA_ADPCM			 = 1,    //two 4-bit IMA ADPCM codes per byte, mono only
+	MCP4822_CODEC_ULAW				 = 2     //one G.711 mu-law byte per sample
+
+}MCP4822_ASSET_CODEC;
+
+/**
+ * @brief Channel layout mapping
+ */
+typedef enum
+{
+	MCP4822_LAYOUT_MONO				 = 1,
+	MCP4822_LAYOUT_STEREO			 = 2     //samples interleaved channel A, channel B
+
+}MCP4822_ASSET_LAYOUT;
+
+/**
+ * @brief Asset header placed in front of the payload in the .myAudioFiles section
+ *
+ * All fields are little-endian. Sample positions count per-channel samples.
+ * block_size is a decode block hint for sizing stream buffers and is not
+ * checked. With MCP4822_ASSET_FLAG_SEEK_TABLE the seek table sits between
+ * this header and the payload, one entry every seek_interval samples.
+ * Version 2 added seek_interval; version 1 kept the interval in block_size.
+ */
+typedef struct
+{
+
+	uint32_t magic;
+
+	uint8_t version;
+
+	uint8_t codec;
+
+	uint8_t layout;
+
+	uint8_t flags;
+
+	uint32_t sample_rate;
+
+	uint32_t sample_count;
+
+	uint32_t loop_start;
+
+	uint32_t loop_end;
+
+	uint16_t block_size;
+
+	uint16_t header_size;
+
+	uint32_t payload_size;
+
+	uint16_t seek_interval;
+
+	uint16_t reserved;
+
+}MCP4822_Asset_Header_t;
+
+/**
+ * @brief Seek table entry, the ADPCM decoder state before sample n * seek_interval
+ */
+typedef struct
+{
+
+	int16_t predictor;
+
+	uint8_t step_index;
+
+	uint8_t reserved;
+
+}MCP4822_Asset_Seek_t;
+
+/**
+ * @brief Validated view of an asset image
+ */
+typedef struct
+{
+
+	const MCP4822_Asset_Header_t *header;
+
+	const MCP4822_Asset_Seek_t *seek_table;    //NULL if the asset has none
+
+	const uint8_t *payload;
+
+}MCP4822_Asset_t;
+
+/**
+ * @brief Plays an asset through a stream, decoding its codec and honouring loop points
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	MCP4822_DAC_SELECT dac_channel;
+
+	MCP4822_Asset_t asset;
+
+	uint32_t position;
+
+	MCP4822_ADPCM_State_t state;
+
+	MCP4822_ADPCM_State_t loop_state;
+
+	uint8_t loop_state_valid;
+
+	uint8_t looping;
+
+}MCP4822_Asset_Player_t;
+
+/**
+ * @brief Validates an asset header without touching the payload
+ *
+ * Every check is a constant-time comparison of header fields, so the cost does
+ * not depend on the payload length.
+ *
+ * @param image - start of the asset image (its header)
+ * @param image_size - bytes available at image, 0 if unknown
+ * @param asset - filled with the header and payload pointers on success
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_FORMAT otherwise
+ */
+MCP4822_STATUS MCP4822_asset_load(const void *image, uint32_t image_size, MCP4822_Asset_t *asset);
+
+/**
+ * @brief Payload size in bytes implied by a codec, layout and sample count
+ *
+ * @param codec - payload codec
+ * @param layout - channel layout
+ * @param sample_count - samples per channel
+ *
+ * @return Payload size in bytes, 0 for an unknown codec or a size above UINT32_MAX
+ */
+uint32_t MCP4822_asset_payload_size(MCP4822_ASSET_CODEC codec, MCP4822_ASSET_LAYOUT layout, uint32_t sample_count);
+
+/**
+ * @brief Initializes a player at the start of a loaded asset
+ *
+ * Mono assets are sent to dac_channel. Stereo assets produce alternating
+ * channel A and channel B frames, suitable for MCP4822_stream_start_pairs.
+ *
+ * @param player - player to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - DAC channel for mono assets
+ * @param asset - asset returned by MCP4822_asset_load
+ *
+ * @return None
+ */
+void MCP4822_asset_player_init(MCP4822_Asset_Player_t *player, MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel,
+							   const MCP4822_Asset_t *asset);
+
+/**
+ * @brief Restarts playback from the first sample
+ *
+ * @param player - player to be rewound
+ *
+ * @return None
+ */
+void MCP4822_asset_player_rewind(MCP4822_Asset_Player_t *player);
+
+/**
+ * @brief Moves playback to any sample
+ *
+ * PCM12 and mu-law assets seek directly. ADPCM assets resume from the nearest
+ * seek table snapshot and decode fewer than seek_interval samples to reach the
+ * target, so the cost does not grow with the asset length. ADPCM assets
+ * without a seek table are decoded from the start.
+ *
+ * @param player - player to be moved
+ * @param sample - target sample, 0 .. sample_count
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_asset_player_seek(MCP4822_Asset_Player_t *player, uint32_t sample);
+
+/**
+ * @brief Number of seek table entries implied by a sample count and interval
+ *
+ * @param sample_count - samples per channel
+ * @param interval - samples between snapshots
+ *
+ * @return Entry count
+ */
+static inline uint32_t MCP4822_asset_seek_entries(uint32_t sample_count, uint32_t interval){
+
+	//Rounded up without the sum that would wrap for counts near UINT32_MAX
+	return sample_count / interval + (sample_count % interval != 0);
+}
+
+/**
+ * @brief Stream refill callback producing the asset's next frames
+ *
+ * @param context - MCP4822_Asset_Player_t to read from
+ * @param frames - destination for the encoded frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written, short at the end of a non-looping asset
+ */
+uint32_t MCP4822_asset_player_refill(void *context, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Source callback producing the asset's next samples as signed 16-bit PCM
+ *
+ * Matches MCP4822_Source_Cb so an asset can feed the mixer or resampler.
+ * Stereo assets are averaged to one channel.
+ *
+ * @param context - MCP4822_Asset_Player_t to read from
+ * @param samples - destination for the samples
+ * @param count - number of samples requested
+ *
+ * @return Number of samples written, short at the end of a non-looping asset
+ */
+uint32_t MCP4822_asset_player_read(void *context, int16_t *samples, uint32_t count);
+
+#endif /* __MCP4822_ASSET_H_ */
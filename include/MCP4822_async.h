@@ -0,0 +1,168 @@
+/*
+ * MCP4822_async.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_ASYNC_H_
+#define __MCP4822_ASYNC_H_
+
+#include "MCP4822.h"
+
+/** Queue depth in frames, must be a power of 2 */
+#ifndef MCP4822_ASYNC_QUEUE_LEN
+#define MCP4822_ASYNC_QUEUE_LEN		   16
+#endif
+
+#define MCP4822_ASYNC_QUEUE_MASK	   (MCP4822_ASYNC_QUEUE_LEN - 1)
+
+/**
+ * @brief Completion callback for asynchronous writes
+ *
+ * Called from the SPI interrupt once every frame of the request has been sent.
+ *
+ * @param context - user pointer given with the request
+ * @param status - MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ *
+ * @return None
+ */
+typedef void (*MCP4822_Async_Cb)(void *context, MCP4822_STATUS status);
+
+/**
+ * @brief One queued frame
+ */
+typedef struct
+{
+
+	uint16_t frame;
+
+	uint8_t last;
+
+	MCP4822_Async_Cb callback;
+
+	void *context;
+
+#ifdef MCP4822_ENABLE_STATS
+	uint32_t queued_at;
+#endif
+
+}MCP4822_Async_Entry_t;
+
+/**
+ * @brief Interrupt-driven write queue
+ */
+struct MCP4822_Async
+{
+
+	MCP4822_Handle_t *handle;
+
+	MCP4822_Async_Entry_t entries[MCP4822_ASYNC_QUEUE_LEN];
+
+	volatile uint32_t head;
+
+	volatile uint32_t tail;
+
+	volatile uint8_t busy;
+
+	MCP4822_STATUS request_status;
+
+	uint16_t tx_frame;
+
+};
+
+/**
+ * @brief Attaches an async write queue to the handle
+ *
+ * The queue claims the handle's SPI in MCP4822_dispatch.h, which routes the
+ * SPI interrupts to MCP4822_async_tx_complete_handler and
+ * MCP4822_async_error_handler. Passing NULL detaches the queue and releases
+ * the SPI once the queue is empty.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param async - queue storage, owned by the handle afterwards, NULL to detach
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_BUSY if a stream or bus owns the SPI or the queue is still sending
+ */
+MCP4822_STATUS MCP4822_async_init(MCP4822_Handle_t *handle, MCP4822_Async_t *async);
+
+/**
+ * @brief Queues a write to one channel and returns immediately
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param value - digital value to be sent to DAC
+ * @param dac_channel - DAC channel to be written to
+ * @param callback - completion callback, may be NULL
+ * @param context - user pointer passed to the callback
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_BUSY if the queue is full
+ */
+MCP4822_STATUS MCP4822_write_to_chan_async(MCP4822_Handle_t *handle, uint16_t value, MCP4822_DAC_SELECT dac_channel,
+										   MCP4822_Async_Cb callback, void *context);
+
+/**
+ * @brief Queues a write to both channels, latched together when an LDAC pin is assigned
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param value - digital value to be sent to the DACs
+ * @param callback - completion callback, called once after both frames, may be NULL
+ * @param context - user pointer passed to the callback
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_BUSY if the queue is full
+ */
+MCP4822_STATUS MCP4822_write_to_both_chans_async(MCP4822_Handle_t *handle, uint16_t value, MCP4822_Async_Cb callback, void *context);
+
+/**
+ * @brief Queues a write to one channel, after converting from volts, and returns immediately
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param volts - voltage value to be converted and sent to the DAC
+ * @param dac_channel - DAC channel to be written to
+ * @param callback - completion callback, may be NULL
+ * @param context - user pointer passed to the callback
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_BUSY if the queue is full
+ */
+MCP4822_STATUS MCP4822_write_volts_to_chan_async(MCP4822_Handle_t *handle, float volts, MCP4822_DAC_SELECT dac_channel,
+												 MCP4822_Async_Cb callback, void *context);
+
+/**
+ * @brief Queues a write to both channels, after converting from volts, and returns immediately
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param volts - voltage value to be converted and sent to the DACs
+ * @param callback - completion callback, called once after both frames, may be NULL
+ * @param context - user pointer passed to the callback
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_BUSY if the queue is full
+ */
+MCP4822_STATUS MCP4822_write_volts_to_both_chans_async(MCP4822_Handle_t *handle, float volts, MCP4822_Async_Cb callback, void *context);
+
+/**
+ * @brief Number of frames queued or in flight
+ *
+ * @param handle - handle for MCP4822 driver
+ *
+ * @return Pending frame count
+ */
+uint32_t MCP4822_async_pending(MCP4822_Handle_t *handle);
+
+/**
+ * @brief Finishes the frame in flight and starts the next one, called by MCP4822_dispatch_tx_complete
+ *
+ * @param handle - handle for MCP4822 driver
+ *
+ * @return None
+ */
+void MCP4822_async_tx_complete_handler(MCP4822_Handle_t *handle);
+
+/**
+ * @brief Fails the frame in flight and starts the next one, called by MCP4822_dispatch_error
+ *
+ * @param handle - handle for MCP4822 driver
+ *
+ * @return None
+ */
+void MCP4822_async_error_handler(MCP4822_Handle_t *handle);
+
+#endif /* __MCP4822_ASYNC_H_ */
@@ -0,0 +1,168 @@
+/*
+ * MCP4822_bank.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_BANK_H_
+#define __MCP4822_BANK_H_
+
+#include "MCP4822_asset.h"
+
+/** Bank header identification, "MCPB" in memory order */
+#define MCP4822_BANK_MAGIC			   0x4250434DUL
+#define MCP4822_BANK_VERSION		   1
+
+/** Name hash slot holding no entry */
+#define MCP4822_BANK_SLOT_EMPTY		   0xFFFF
+
+/** 32-bit FNV-1a parameters used for name hashing */
+#define MCP4822_FNV_OFFSET_BASIS	   0x811C9DC5UL
+#define MCP4822_FNV_PRIME			   0x01000193UL
+
+/**
+ * @brief Bank header, placed at the start of the .myAudioFiles section
+ *
+ * Followed by asset_count table of contents entries, then hash_slots name
+ * slots (uint16_t entry IDs, open addressing with linear probing), then the
+ * NUL terminated names and the asset images. Offsets are from the bank start.
+ */
+typedef struct
+{
+
+	uint32_t magic;
+
+	uint8_t version;
+
+	uint8_t reserved;
+
+	uint16_t asset_count;
+
+	uint16_t hash_slots;
+
+	uint16_t header_size;
+
+	uint32_t total_size;
+
+}MCP4822_Bank_Header_t;
+
+/**
+ * @brief Table of contents entry, indexed by asset ID
+ */
+typedef struct
+{
+
+	uint32_t offset;
+
+	uint32_t length;
+
+	uint32_t name_hash;
+
+	uint32_t name_offset;
+
+	uint8_t codec;
+
+	uint8_t layout;
+
+	uint16_t reserved;
+
+}MCP4822_Bank_Entry_t;
+
+/**
+ * @brief Validated view of a bank image
+ */
+typedef struct
+{
+
+	const uint8_t *image;
+
+	const MCP4822_Bank_Header_t *header;
+
+	const MCP4822_Bank_Entry_t *entries;
+
+	const uint16_t *slots;
+
+}MCP4822_Bank_t;
+
+/**
+ * @brief Validates a bank header and locates its tables
+ *
+ * Only the header is checked, the cost does not depend on the number of assets.
+ *
+ * @param image - start of the bank image
+ * @param image_size - bytes available at image, 0 if unknown
+ * @param bank - filled with the table pointers on success
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_FORMAT otherwise
+ */
+MCP4822_STATUS MCP4822_bank_open(const void *image, uint32_t image_size, MCP4822_Bank_t *bank);
+
+/**
+ * @brief Loads an asset by ID, a direct index into the table of contents
+ *
+ * @param bank - bank returned by MCP4822_bank_open
+ * @param id - asset ID, 0 .. asset_count - 1
+ * @param asset - filled with the asset on success
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_FORMAT otherwise
+ */
+MCP4822_STATUS MCP4822_bank_get(const MCP4822_Bank_t *bank, uint16_t id, MCP4822_Asset_t *asset);
+
+/**
+ * @brief Finds an asset ID by name through the name hash table
+ *
+ * At most hash_slots slots are probed, so a table without an empty slot
+ * still ends the search.
+ *
+ * @param bank - bank returned by MCP4822_bank_open
+ * @param name - NUL terminated asset name
+ * @param id - set to the asset ID on success
+ *
+ * @return MCP4822_OK if found, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_bank_find(const MCP4822_Bank_t *bank, const char *name, uint16_t *id);
+
+/**
+ * @brief Loads an asset by name
+ *
+ * @param bank - bank returned by MCP4822_bank_open
+ * @param name - NUL terminated asset name
+ * @param asset - filled with the asset on success
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_FORMAT otherwise
+ */
+MCP4822_STATUS MCP4822_bank_get_by_name(const MCP4822_Bank_t *bank, const char *name, MCP4822_Asset_t *asset);
+
+/**
+ * @brief Returns the name stored for an asset ID
+ *
+ * @param bank - bank returned by MCP4822_bank_open
+ * @param id - asset ID
+ *
+ * @return NUL terminated name, NULL if the ID is out of range
+ */
+const char *MCP4822_bank_name(const MCP4822_Bank_t *bank, uint16_t id);
+
+/**
+ * @brief 32-bit FNV-1a hash of an asset name
+ *
+ * @param name - NUL terminated asset name
+ *
+ * @return Name hash
+ */
+uint32_t MCP4822_bank_hash(const char *name);
+
+/**
+ * @brief Number of assets in a bank
+ *
+ * @param bank - bank returned by MCP4822_bank_open
+ *
+ * @return Asset count
+ */
+static inline uint16_t MCP4822_bank_count(const MCP4822_Bank_t *bank){
+
+	return bank->header->asset_count;
+}
+
+#endif /* __MCP4822_BANK_H_ */
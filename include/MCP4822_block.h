@@ -0,0 +1,81 @@
+/*
+ * MCP4822_block.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_BLOCK_H_
+#define __MCP4822_BLOCK_H_
+
+#include "MCP4822.h"
+
+/**
+ * Conversion kernel, picked at compile time. The portable C kernel is the
+ * default on Arm; define MCP4822_BLOCK_USE_MVE (Helium with float, Cortex-M55/M85)
+ * or MCP4822_BLOCK_USE_DSP (FPU, Cortex-M4F/M7/M33) to opt in to an Arm kernel.
+ * Host builds use AVX2 or SSE2 when the compiler targets them.
+ * Define MCP4822_BLOCK_FORCE_SCALAR to always use the portable kernel.
+ */
+#if defined(MCP4822_BLOCK_FORCE_SCALAR)
+#define MCP4822_BLOCK_KERNEL_SCALAR
+#elif defined(MCP4822_BLOCK_USE_MVE)
+#if !defined(__ARM_FEATURE_MVE) || !(__ARM_FEATURE_MVE & 2)
+#error "MCP4822_BLOCK_USE_MVE needs a target with floating-point MVE"
+#endif
+#define MCP4822_BLOCK_KERNEL_MVE
+#elif defined(MCP4822_BLOCK_USE_DSP)
+#if !defined(__ARM_FP)
+#error "MCP4822_BLOCK_USE_DSP needs a target with an FPU"
+#endif
+#define MCP4822_BLOCK_KERNEL_DSP
+#elif defined(__AVX2__)
+#define MCP4822_BLOCK_KERNEL_AVX2
+#elif defined(__SSE2__)
+#define MCP4822_BLOCK_KERNEL_SSE2
+#else
+#define MCP4822_BLOCK_KERNEL_SCALAR
+#endif
+
+/** Normalized samples span -1.0 .. 1.0 over the full code range */
+#define MCP4822_NORMALIZED_SCALE	   ((MCP4822_DAC_MAX) / 2.0f)
+#define MCP4822_NORMALIZED_OFFSET	   ((MCP4822_DAC_MAX) / 2.0f)
+
+/**
+ * @brief Converts an array of voltages into ready-to-send frames for one channel
+ *
+ * Each sample is rounded to the nearest code and saturated to
+ * 0..MCP4822_DAC_MAX, matching MCP4822_volts_to_chan_units. A calibration
+ * attached to the handle is applied to the codes afterwards.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param volts - input voltages
+ * @param frames - output frames, may not overlap volts
+ * @param count - number of samples
+ * @param dac_channel - DAC channel the frames are addressed to
+ *
+ * @return None
+ */
+void MCP4822_volts_to_frames(MCP4822_Handle_t *handle, const float *volts, uint16_t *frames, uint32_t count, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Converts an array of normalized samples (-1.0 .. 1.0) into ready-to-send frames for one channel
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param samples - input samples, saturated outside -1.0 .. 1.0
+ * @param frames - output frames, may not overlap samples
+ * @param count - number of samples
+ * @param dac_channel - DAC channel the frames are addressed to
+ *
+ * @return None
+ */
+void MCP4822_normalized_to_frames(MCP4822_Handle_t *handle, const float *samples, uint16_t *frames, uint32_t count, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Name of the kernel compiled in, for benchmark reports
+ *
+ * @return "mve", "dsp", "avx2", "sse2" or "scalar"
+ */
+const char *MCP4822_block_kernel_name(void);
+
+#endif /* __MCP4822_BLOCK_H_ */
@@ -0,0 +1,185 @@
+/*
+ * MCP4822_bus.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_BUS_H_
+#define __MCP4822_BUS_H_
+
+#include "MCP4822.h"
+
+/**
+ * @brief One device attached to a shared bus
+ *
+ * queue is a single-producer ring of encoded frames: head is only written by
+ * the task writing to the device and tail only by the bus interrupt. Both
+ * indices run freely and are masked on access.
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	uint16_t *queue;
+
+	uint32_t mask;
+
+	volatile uint32_t head;
+
+	volatile uint32_t tail;
+
+	uint32_t sent;
+
+	uint32_t errors;
+
+}MCP4822_Bus_Device_t;
+
+/**
+ * @brief Scheduler serializing several MCP4822 devices on one SPI peripheral
+ *
+ * Devices are served round-robin. Each turn sends up to quantum queued frames
+ * to one device, framing every frame with that device's CS pin, and pulses
+ * its LDAC once at the end of the turn so the frames are latched together.
+ * A turn is stretched rather than ending inside one write call's frames. A
+ * device that has nothing queued is skipped without using bus time.
+ */
+typedef struct
+{
+
+	MCP4822_Spi_t *hspi;
+
+	MCP4822_Bus_Device_t *devices;
+
+	uint32_t device_count;
+
+	uint32_t quantum;
+
+	uint32_t current;
+
+	uint32_t turn_left;
+
+	uint32_t turn_sent;
+
+	volatile uint8_t busy;
+
+	uint16_t tx_frame;
+
+}MCP4822_Bus_t;
+
+/**
+ * @brief Initializes a bus with no devices attached
+ *
+ * The bus claims hspi in MCP4822_dispatch.h, which routes the SPI interrupts
+ * to MCP4822_bus_tx_complete_handler and MCP4822_bus_error_handler until
+ * MCP4822_bus_deinit.
+ *
+ * @param bus - bus to be initialized
+ * @param hspi - SPI peripheral shared by the devices
+ * @param devices - device storage, one entry per device
+ * @param device_count - number of entries in devices
+ * @param quantum - most frames sent to one device before the next device gets a turn
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG for bad arguments, MCP4822_ERROR_BUSY if another owner holds hspi
+ */
+MCP4822_STATUS MCP4822_bus_init(MCP4822_Bus_t *bus, MCP4822_Spi_t *hspi, MCP4822_Bus_Device_t *devices, uint32_t device_count,
+								uint32_t quantum);
+
+/**
+ * @brief Releases the bus SPI for other owners
+ *
+ * @param bus - bus
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_BUSY while a frame is in flight
+ */
+MCP4822_STATUS MCP4822_bus_deinit(MCP4822_Bus_t *bus);
+
+/**
+ * @brief Attaches a device to a bus slot
+ *
+ * The handle must use the bus SPI and MCP4822_CS_SOFTWARE mode, since each
+ * device needs its own CS pin. Once attached, the device should only be
+ * written through the bus.
+ *
+ * @param bus - bus
+ * @param device - slot index
+ * @param handle - handle for MCP4822 driver
+ * @param queue - frame storage for the device
+ * @param capacity - storage length in frames, must be a power of 2
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_bus_attach(MCP4822_Bus_t *bus, uint32_t device, MCP4822_Handle_t *handle, uint16_t *queue, uint32_t capacity);
+
+/**
+ * @brief Queues encoded frames for a device and starts the bus if idle
+ *
+ * A frame is sent within ceil((level + 1) / quantum) rounds, level being the
+ * device's queue level when it was queued. A round takes at most
+ * device_count * quantum frame times, plus count - 1 for writes longer than
+ * quantum.
+ *
+ * @param bus - bus
+ * @param device - slot index
+ * @param frames - encoded frames, see MCP4822_encode_frame
+ * @param count - number of frames
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG for bad arguments or count above the queue capacity,
+ *         MCP4822_ERROR_BUSY if the queue has no room for every frame yet
+ */
+MCP4822_STATUS MCP4822_bus_write_frames(MCP4822_Bus_t *bus, uint32_t device, const uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Queues a write to one channel of a device
+ *
+ * @param bus - bus
+ * @param device - slot index
+ * @param value - digital value to be sent to DAC
+ * @param dac_channel - DAC channel to be written to
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_BUSY if the queue is full
+ */
+MCP4822_STATUS MCP4822_bus_write_to_chan(MCP4822_Bus_t *bus, uint32_t device, uint16_t value, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Queues a write to both channels of a device, latched together
+ *
+ * @param bus - bus
+ * @param device - slot index
+ * @param a_value - digital value for channel A
+ * @param b_value - digital value for channel B
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_BUSY if the queue is full
+ */
+MCP4822_STATUS MCP4822_bus_write_pair(MCP4822_Bus_t *bus, uint32_t device, uint16_t a_value, uint16_t b_value);
+
+/**
+ * @brief Number of frames queued or in flight for a device
+ *
+ * @param bus - bus
+ * @param device - slot index
+ *
+ * @return Pending frame count
+ */
+uint32_t MCP4822_bus_pending(MCP4822_Bus_t *bus, uint32_t device);
+
+/**
+ * @brief Finishes the frame in flight and starts the next one, called by MCP4822_dispatch_tx_complete
+ *
+ * @param bus - bus owning the SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_bus_tx_complete_handler(MCP4822_Bus_t *bus);
+
+/**
+ * @brief Drops the frame in flight and starts the next one, called by MCP4822_dispatch_error
+ *
+ * @param bus - bus owning the SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_bus_error_handler(MCP4822_Bus_t *bus);
+
+#endif /* __MCP4822_BUS_H_ */
@@ -0,0 +1,169 @@
+/*
+ * MCP4822_cal.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_CAL_H_
+#define __MCP4822_CAL_H_
+
+#include "MCP4822.h"
+
+/** Entries in a full correction table, one per code */
+#define MCP4822_CAL_LUT_SIZE		   (MCP4822_DAC_MAX + 1)
+
+/** Q16 gain leaving codes unchanged */
+#define MCP4822_CAL_GAIN_UNITY		   65536
+
+/**
+ * @brief Correction of one channel, mapping an ideal code to the code to send
+ *
+ * Without a table the code is scaled by gain_q16 and offset_q16 is added,
+ * both Q16, with rounding and clamping to 0 .. MCP4822_DAC_MAX. gain_q16 must
+ * stay below 4.0. A table replaces both with one lookup per code and usually
+ * folds them in together with the INL correction; a const table stays in
+ * flash.
+ */
+typedef struct
+{
+
+	int32_t gain_q16;
+
+	int32_t offset_q16;
+
+	const uint16_t *lut;
+
+}MCP4822_Cal_Chan_t;
+
+/**
+ * @brief Calibration of both channels of a device at both gains
+ *
+ * The output amplifier's gain and offset errors differ between the 1x and 2x
+ * settings, so each channel has one correction per gain, indexed
+ * [dac_channel][gain]. The one matching the channel's current gain is used.
+ *
+ * Attached to a handle with MCP4822_attach_cal, it is applied by the blocking
+ * and async code and volt writes, the shared bus writes and the block
+ * conversions. Pre-encoded frames, streams and the audio paths are sent as is.
+ */
+typedef struct MCP4822_Cal
+{
+
+	MCP4822_Cal_Chan_t chans[2][2];
+
+}MCP4822_Cal_t;
+
+/**
+ * @brief Resets a calibration to the identity for both channels and gains
+ *
+ * @param cal - calibration to be initialized
+ *
+ * @return None
+ */
+void MCP4822_cal_init(MCP4822_Cal_t *cal);
+
+/**
+ * @brief Fits gain and offset to measured points by least squares
+ *
+ * Each point is a code sent with the channel uncorrected and the voltage
+ * measured at the output. Any table is left in place.
+ *
+ * @param chan - channel calibration to be set
+ * @param codes - codes sent
+ * @param volts - voltages measured for codes
+ * @param count - number of points, at least 2 with different codes
+ * @param codes_per_volt - ideal slope at the channel's gain, see MCP4822_chan_volt_scale
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_cal_fit(MCP4822_Cal_Chan_t *chan, const uint16_t *codes, const float *volts, uint32_t count, float codes_per_volt);
+
+/**
+ * @brief Builds a full correction table from measured points
+ *
+ * The measured transfer curve is interpolated linearly between points and
+ * inverted, so each entry is the code whose output is closest to the ideal
+ * voltage of its index. Gain, offset and INL are all folded in. The table can
+ * be built once on a host and stored as a const array.
+ *
+ * @param lut - MCP4822_CAL_LUT_SIZE entries to be filled
+ * @param codes - codes sent, strictly increasing
+ * @param volts - voltages measured for codes, non-decreasing
+ * @param count - number of points, at least 2
+ * @param codes_per_volt - ideal slope at the channel's gain, see MCP4822_chan_volt_scale
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_cal_build_lut(uint16_t *lut, const uint16_t *codes, const float *volts, uint32_t count, float codes_per_volt);
+
+/**
+ * @brief Corrects the data field of a block of frames for one channel in place
+ *
+ * @param cal - calibration
+ * @param dac_channel - channel every frame is addressed to
+ * @param gain - gain of the channel
+ * @param frames - encoded frames
+ * @param count - number of frames
+ *
+ * @return None
+ */
+void MCP4822_cal_apply_frames(const MCP4822_Cal_t *cal, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain, uint16_t *frames,
+							  uint32_t count);
+
+/**
+ * @brief Corrects one code
+ *
+ * @param cal - calibration
+ * @param dac_channel - channel the code is sent to
+ * @param gain - gain of the channel
+ * @param code - ideal code, 0 .. MCP4822_DAC_MAX
+ *
+ * @return Code to send
+ */
+static inline uint16_t MCP4822_cal_apply(const MCP4822_Cal_t *cal, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain, uint16_t code){
+
+	const MCP4822_Cal_Chan_t *chan = &cal->chans[dac_channel & FIRST_BIT_MASK][gain & FIRST_BIT_MASK];
+
+	if(chan->lut != NULL){
+		return chan->lut[code & MCP4822_FRAME_DATA_MASK];
+	}
+
+	int32_t corrected = ((int32_t)code * chan->gain_q16 + chan->offset_q16 + (1 << 15)) >> 16;
+
+	if(corrected < 0){
+		return 0;
+	}
+	else if(corrected > MCP4822_DAC_MAX){
+		return MCP4822_DAC_MAX;
+	}
+
+	return (uint16_t)corrected;
+}
+
+/**
+ * @brief Corrects a code with the calibration attached to a handle, if any
+ *
+ * The ideal code is kept in the handle, so a later gain change can send the
+ * same level corrected for the new gain.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - channel the code is sent to
+ * @param code - ideal code, 0 .. MCP4822_DAC_MAX
+ *
+ * @return Code to send
+ */
+static inline uint16_t MCP4822_calibrate(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel, uint16_t code){
+
+	if(handle->cal == NULL){
+		return code;
+	}
+
+	const MCP4822_Config_t *config = (dac_channel == MCP4822_CHANNEL_A) ? &handle->chan_configs.chan_A_config : &handle->chan_configs.chan_B_config;
+
+	handle->cal_codes[dac_channel & FIRST_BIT_MASK] = code;
+
+	return MCP4822_cal_apply(handle->cal, dac_channel, config->gain, code);
+}
+
+#endif /* __MCP4822_CAL_H_ */
@@ -0,0 +1,190 @@
+/*
+ * MCP4822_dds.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_DDS_H_
+#define __MCP4822_DDS_H_
+
+#include "MCP4822.h"
+#include "MCP4822_source.h"
+
+/** Built-in sine table, one Q15 cycle of 2^MCP4822_DDS_SINE_BITS entries */
+#define MCP4822_DDS_SINE_BITS		   10
+
+/** Bits of phase below the table index used for linear interpolation */
+#define MCP4822_DDS_FRAC_BITS		   16
+
+/** Q15 amplitude for full scale */
+#define MCP4822_DDS_FULL_SCALE		   32768
+
+/**
+ * @brief Waveform mapping
+ */
+typedef enum
+{
+	MCP4822_WAVE_SINE				 = 0,
+	MCP4822_WAVE_TRIANGLE			 = 1,
+	MCP4822_WAVE_SAWTOOTH			 = 2,
+	MCP4822_WAVE_SQUARE				 = 3,
+	MCP4822_WAVE_TABLE				 = 4     //user table set with MCP4822_dds_set_table
+
+}MCP4822_WAVEFORM;
+
+/**
+ * @brief Oscillator state of one DAC channel
+ *
+ * The phase wraps at 2^32 and advances by tuning_word every sample, so the
+ * frequency step is sample_rate / 2^32.
+ */
+typedef struct
+{
+
+	uint32_t phase;
+
+	uint32_t tuning_word;
+
+	MCP4822_WAVEFORM waveform;
+
+	const uint16_t *table;
+
+	uint8_t table_bits;
+
+	uint16_t amplitude;
+
+	uint8_t enabled;
+
+}MCP4822_DDS_Chan_t;
+
+/**
+ * @brief Direct digital synthesis engine driving both DAC channels
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	uint32_t sample_rate;
+
+	MCP4822_DDS_Chan_t chans[2];
+
+	uint8_t held;
+
+	uint16_t held_frame;
+
+}MCP4822_DDS_t;
+
+/**
+ * @brief Initializes the engine with both oscillators disabled
+ *
+ * @param dds - engine to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param sample_rate - rate the rendered samples will be played at, in Hz
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_dds_init(MCP4822_DDS_t *dds, MCP4822_Handle_t *handle, uint32_t sample_rate);
+
+/**
+ * @brief Sets and enables the oscillator of a channel
+ *
+ * @param dds - engine
+ * @param dac_channel - DAC channel
+ * @param waveform - waveform to generate
+ * @param millihertz - frequency in mHz, below half the sample rate
+ * @param amplitude - Q15 amplitude around mid-scale, 0 .. MCP4822_DDS_FULL_SCALE
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_dds_configure(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, MCP4822_WAVEFORM waveform,
+									 uint32_t millihertz, uint16_t amplitude);
+
+/**
+ * @brief Changes the frequency of a channel without resetting its phase
+ *
+ * @param dds - engine
+ * @param dac_channel - DAC channel
+ * @param millihertz - frequency in mHz, below half the sample rate
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_dds_set_frequency(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, uint32_t millihertz);
+
+/**
+ * @brief Sets the phase of a channel, e.g. for quadrature outputs
+ *
+ * @param dds - engine
+ * @param dac_channel - DAC channel
+ * @param phase - phase, 2^32 is one full cycle
+ *
+ * @return None
+ */
+void MCP4822_dds_set_phase(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, uint32_t phase);
+
+/**
+ * @brief Selects a user wavetable for MCP4822_WAVE_TABLE, call before MCP4822_dds_configure
+ *
+ * @param dds - engine
+ * @param dac_channel - DAC channel
+ * @param table - one cycle of 12-bit codes, kept by reference
+ * @param table_bits - log2 of the table length, 1 .. 16
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_dds_set_table(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, const uint16_t *table, uint8_t table_bits);
+
+/**
+ * @brief Disables the oscillator of a channel
+ *
+ * @param dds - engine
+ * @param dac_channel - DAC channel
+ *
+ * @return None
+ */
+void MCP4822_dds_disable(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Renders a block of one channel straight into MCP4822 frames
+ *
+ * @param dds - engine
+ * @param dac_channel - DAC channel
+ * @param frames - output frames
+ * @param count - number of frames
+ *
+ * @return None
+ */
+void MCP4822_dds_render(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Stream refill callback rendering the enabled channels
+ *
+ * Produces interleaved A, B frames when both oscillators are enabled, use
+ * MCP4822_stream_start_pairs for that case. An odd count then ends on a
+ * channel A frame and its channel B frame opens the next refill, so the pairs
+ * stay aligned. With one oscillator enabled the frames all address its
+ * channel. Never returns a short count.
+ *
+ * @param context - MCP4822_DDS_t to render
+ * @param frames - destination for the encoded frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written
+ */
+uint32_t MCP4822_dds_refill(void *context, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Source callback rendering one oscillator as signed 16-bit samples
+ *
+ * Lets an oscillator feed the mixer, e.g. MCP4822_mixer_play(..., MCP4822_dds_read, &dds.chans[0], ...).
+ *
+ * @param context - MCP4822_DDS_Chan_t to render
+ * @param samples - destination for the samples
+ * @param count - number of samples requested
+ *
+ * @return count
+ */
+uint32_t MCP4822_dds_read(void *context, int16_t *samples, uint32_t count);
+
+#endif /* __MCP4822_DDS_H_ */
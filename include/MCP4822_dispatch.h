@@ -0,0 +1,107 @@
+/*
+ * MCP4822_dispatch.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_DISPATCH_H_
+#define __MCP4822_DISPATCH_H_
+
+#include "MCP4822.h"
+
+/**
+ * Single routing point for SPI interrupts. The async queue, the DMA streams
+ * and the bus all finish their transfers from HAL_SPI_TxCpltCallback, so an
+ * SPI peripheral is owned by one of them at a time:
+ *
+ * - an async queue from MCP4822_async_init until it is detached
+ * - a stream from MCP4822_stream_start or MCP4822_stream_start_pairs until it stops
+ * - a bus from MCP4822_bus_init until MCP4822_bus_deinit
+ *
+ * A second owner is refused with MCP4822_ERROR_BUSY. The application
+ * forwards the HAL callbacks once:
+ *
+ *   void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi){ MCP4822_dispatch_tx_complete(hspi); }
+ *   void HAL_SPI_TxHalfCpltCallback(SPI_HandleTypeDef *hspi){ MCP4822_dispatch_tx_half_complete(hspi); }
+ *   void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){ MCP4822_dispatch_error(hspi); }
+ *
+ * or defines MCP4822_DISPATCH_HAL_CALLBACKS to have the driver define exactly
+ * these three callbacks. Interrupts of an SPI without an owner are ignored.
+ */
+
+/** Number of SPI peripherals that can be owned at the same time */
+#ifndef MCP4822_DISPATCH_SLOTS
+#define MCP4822_DISPATCH_SLOTS		   4
+#endif
+
+/**
+ * @brief SPI owner mapping
+ */
+typedef enum
+{
+	MCP4822_DISPATCH_NONE			 = 0,
+	MCP4822_DISPATCH_ASYNC			 = 1,
+	MCP4822_DISPATCH_STREAM			 = 2,
+	MCP4822_DISPATCH_BUS			 = 3
+
+}MCP4822_DISPATCH_OWNER;
+
+/**
+ * @brief Makes an owner the receiver of an SPI's interrupts
+ *
+ * @param spi - SPI peripheral
+ * @param type - kind of owner
+ * @param owner - MCP4822_Handle_t of an async queue, MCP4822_Stream_t or MCP4822_Bus_t
+ *
+ * @return MCP4822_OK if claimed or already owned by owner, MCP4822_ERROR_BUSY if another owner holds it or no slot is free
+ */
+MCP4822_STATUS MCP4822_dispatch_claim(MCP4822_Spi_t *spi, MCP4822_DISPATCH_OWNER type, void *owner);
+
+/**
+ * @brief Gives up an SPI, nothing happens unless owner holds it
+ *
+ * @param spi - SPI peripheral
+ * @param owner - owner given to MCP4822_dispatch_claim
+ *
+ * @return None
+ */
+void MCP4822_dispatch_release(MCP4822_Spi_t *spi, const void *owner);
+
+/**
+ * @brief Current owner of an SPI
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return Kind of owner, MCP4822_DISPATCH_NONE if free
+ */
+MCP4822_DISPATCH_OWNER MCP4822_dispatch_owner(const MCP4822_Spi_t *spi);
+
+/**
+ * @brief Routes a transfer complete interrupt, call from HAL_SPI_TxCpltCallback
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_dispatch_tx_complete(MCP4822_Spi_t *spi);
+
+/**
+ * @brief Routes a half transfer interrupt, call from HAL_SPI_TxHalfCpltCallback
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_dispatch_tx_half_complete(MCP4822_Spi_t *spi);
+
+/**
+ * @brief Routes a transfer error interrupt, call from HAL_SPI_ErrorCallback
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_dispatch_error(MCP4822_Spi_t *spi);
+
+#endif /* __MCP4822_DISPATCH_H_ */
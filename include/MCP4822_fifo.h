@@ -0,0 +1,151 @@
+/*
+ * MCP4822_fifo.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_FIFO_H_
+#define __MCP4822_FIFO_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+/**
+ * @brief Watermark callback, called from the side (producer or consumer) whose operation crossed the level
+ *
+ * @param context - user pointer given to MCP4822_fifo_set_watermarks
+ * @param level - fill level right after the crossing, in frames
+ *
+ * @return None
+ */
+typedef void (*MCP4822_Fifo_Watermark_Cb)(void *context, uint32_t level);
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring of encoded frames
+ *
+ * head is only written by the producer and tail only by the consumer, so push
+ * and pop are wait-free and need no critical section. Both indices run freely
+ * and are masked on access.
+ */
+typedef struct MCP4822_Fifo
+{
+
+	uint16_t *buffer;
+
+	uint32_t mask;
+
+	atomic_uint_least32_t head;
+
+	atomic_uint_least32_t tail;
+
+	uint32_t high_watermark;
+
+	uint32_t low_watermark;
+
+	MCP4822_Fifo_Watermark_Cb high_callback;
+
+	MCP4822_Fifo_Watermark_Cb low_callback;
+
+	void *context;
+
+	uint16_t last_frame;
+
+	uint32_t underruns;
+
+}MCP4822_Fifo_t;
+
+/**
+ * @brief Initializes an empty FIFO
+ *
+ * @param fifo - FIFO to be initialized
+ * @param buffer - frame storage
+ * @param capacity - storage length in frames, must be a power of 2
+ *
+ * @return true in case of success, false if capacity is not a power of 2
+ */
+bool MCP4822_fifo_init(MCP4822_Fifo_t *fifo, uint16_t *buffer, uint32_t capacity);
+
+/**
+ * @brief Sets the watermark levels and callbacks, call before producer and consumer start
+ *
+ * The high callback fires on the push that makes the level reach high_watermark,
+ * the low callback on the pop that makes it drop to low_watermark.
+ *
+ * @param fifo - FIFO to be configured
+ * @param high_watermark - level in frames for the high callback
+ * @param high_callback - producer-side callback, may be NULL
+ * @param low_watermark - level in frames for the low callback
+ * @param low_callback - consumer-side callback, may be NULL
+ * @param context - user pointer passed to the callbacks
+ *
+ * @return None
+ */
+void MCP4822_fifo_set_watermarks(MCP4822_Fifo_t *fifo, uint32_t high_watermark, MCP4822_Fifo_Watermark_Cb high_callback,
+								 uint32_t low_watermark, MCP4822_Fifo_Watermark_Cb low_callback, void *context);
+
+/**
+ * @brief Copies as many frames as fit into the FIFO, producer side only
+ *
+ * @param fifo - FIFO to be written
+ * @param frames - encoded frames
+ * @param count - number of frames offered
+ *
+ * @return Number of frames pushed
+ */
+uint32_t MCP4822_fifo_push(MCP4822_Fifo_t *fifo, const uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Copies up to count frames out of the FIFO, consumer side only
+ *
+ * @param fifo - FIFO to be read
+ * @param frames - destination for the frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames popped
+ */
+uint32_t MCP4822_fifo_pop(MCP4822_Fifo_t *fifo, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Stream refill callback that drains the FIFO given as context
+ *
+ * Never ends the stream: when the FIFO runs dry the remaining slots repeat the
+ * last frame and the underrun counter is incremented.
+ *
+ * @param context - FIFO to be drained
+ * @param frames - destination for the frames
+ * @param count - number of frames requested
+ *
+ * @return count
+ */
+uint32_t MCP4822_fifo_stream_refill(void *context, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Number of frames currently stored, exact from either side
+ *
+ * @param fifo - FIFO to be queried
+ *
+ * @return Fill level in frames
+ */
+static inline uint32_t MCP4822_fifo_level(MCP4822_Fifo_t *fifo){
+
+	uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+	uint32_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+
+	return head - tail;
+}
+
+/**
+ * @brief Number of free frame slots
+ *
+ * @param fifo - FIFO to be queried
+ *
+ * @return Free space in frames
+ */
+static inline uint32_t MCP4822_fifo_space(MCP4822_Fifo_t *fifo){
+
+	return (fifo->mask + 1) - MCP4822_fifo_level(fifo);
+}
+
+#endif /* __MCP4822_FIFO_H_ */
@@ -0,0 +1,172 @@
+/*
+ * MCP4822_mixer.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_MIXER_H_
+#define __MCP4822_MIXER_H_
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "MCP4822.h"
+#include "MCP4822_source.h"
+
+/** Samples mixed per pass, also the size of the mixer's scratch buffers */
+#ifndef MCP4822_MIXER_BLOCK
+#define MCP4822_MIXER_BLOCK			   32
+#endif
+
+/** Q15 volume for unity gain */
+#define MCP4822_MIXER_UNITY			   32768
+
+/** Pan positions, channel A only to channel B only */
+#define MCP4822_MIXER_PAN_A			   (-32768)
+#define MCP4822_MIXER_PAN_CENTER	   0
+#define MCP4822_MIXER_PAN_B			   32767
+
+/**
+ * @brief One mixer input
+ *
+ * gains packs the Q15 channel A gain in the low half and channel B in the high
+ * half, so the refill sees both change together in a single word store.
+ * in_source is set while the refill may be calling source.
+ */
+typedef struct
+{
+
+	MCP4822_Source_Cb source;
+
+	void *context;
+
+	atomic_uint_least32_t gains;
+
+	atomic_bool active;
+
+	atomic_bool in_source;
+
+}MCP4822_Mixer_Voice_t;
+
+/**
+ * @brief Mixes any number of sources onto DAC channels A and B
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	MCP4822_Mixer_Voice_t *voices;
+
+	uint32_t voice_count;
+
+	int16_t scratch[MCP4822_MIXER_BLOCK];
+
+	int64_t mix_a[MCP4822_MIXER_BLOCK];
+
+	int64_t mix_b[MCP4822_MIXER_BLOCK];
+
+	uint8_t held;
+
+	uint16_t held_frame;
+
+}MCP4822_Mixer_t;
+
+/**
+ * @brief Initializes a mixer with all voices idle
+ *
+ * @param mixer - mixer to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param voices - voice storage, one entry per simultaneous source
+ * @param voice_count - number of entries in voices
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_mixer_init(MCP4822_Mixer_t *mixer, MCP4822_Handle_t *handle, MCP4822_Mixer_Voice_t *voices, uint32_t voice_count);
+
+/**
+ * @brief Starts a source on an idle voice
+ *
+ * The voice is only marked active once its source and gains are in place, so
+ * this may be called while the mixer is running. The voice stops by itself
+ * when its source returns a short count.
+ *
+ * @param mixer - mixer to play on
+ * @param voice - voice index, must be idle
+ * @param source - sample producer
+ * @param context - user pointer handed to source
+ * @param volume - Q15 volume, 0 .. MCP4822_MIXER_UNITY
+ * @param pan - MCP4822_MIXER_PAN_A .. MCP4822_MIXER_PAN_B, centre plays at full volume on both channels
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG for a bad argument, MCP4822_ERROR_BUSY if the voice is playing
+ *         or its previous source is still being called
+ */
+MCP4822_STATUS MCP4822_mixer_play(MCP4822_Mixer_t *mixer, uint32_t voice, MCP4822_Source_Cb source, void *context, uint16_t volume, int16_t pan);
+
+/**
+ * @brief Changes the volume and pan of a voice
+ *
+ * @param mixer - mixer holding the voice
+ * @param voice - voice index
+ * @param volume - Q15 volume, 0 .. MCP4822_MIXER_UNITY
+ * @param pan - MCP4822_MIXER_PAN_A .. MCP4822_MIXER_PAN_B
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_mixer_set_level(MCP4822_Mixer_t *mixer, uint32_t voice, uint16_t volume, int16_t pan);
+
+/**
+ * @brief Stops a voice, its source is not called again after the current block
+ *
+ * Called from code the refill interrupt can preempt, the source is finished
+ * when this returns. Called from a higher priority interrupt or another core,
+ * the refill may still be inside the source: wait for
+ * MCP4822_mixer_voice_released before reusing the source's context.
+ *
+ * @param mixer - mixer holding the voice
+ * @param voice - voice index
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_mixer_stop(MCP4822_Mixer_t *mixer, uint32_t voice);
+
+/**
+ * @brief Tells whether a voice is stopped and the refill is done with its source
+ *
+ * @param mixer - mixer holding the voice
+ * @param voice - voice index
+ *
+ * @return true if the voice is idle and its source is not being called
+ */
+bool MCP4822_mixer_voice_released(MCP4822_Mixer_t *mixer, uint32_t voice);
+
+/**
+ * @brief Finds an idle voice
+ *
+ * @param mixer - mixer to search
+ *
+ * @return Voice index, -1 if every voice is playing
+ */
+int32_t MCP4822_mixer_free_voice(MCP4822_Mixer_t *mixer);
+
+/**
+ * @brief Stream refill callback producing mixed channel A/B frame pairs
+ *
+ * Pass it to MCP4822_stream_init with the mixer as context and start the
+ * stream with MCP4822_stream_start_pairs. Voices are mixed in blocks of
+ * MCP4822_MIXER_BLOCK samples: the full Q30 products are summed in 64 bits
+ * (SMLAL on Cortex-M), then each output sample is rounded to a code and
+ * saturated to 0 .. MCP4822_DAC_MAX once. Silence is produced while no voice
+ * plays, so the stream never ends on its own. An odd count ends on a channel A
+ * frame and its channel B frame opens the next refill, so the pairs stay
+ * aligned.
+ *
+ * @param context - MCP4822_Mixer_t to mix
+ * @param frames - destination for interleaved A, B frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written, always count
+ */
+uint32_t MCP4822_mixer_refill(void *context, uint16_t *frames, uint32_t count);
+
+#endif /* __MCP4822_MIXER_H_ */
@@ -0,0 +1,69 @@
+/*
+ * MCP4822_port.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_PORT_H_
+#define __MCP4822_PORT_H_
+
+#include <stdint.h>
+
+/**
+ * Transport binding. The driver reaches the SPI peripheral, GPIO pins, timer,
+ * critical sections and tick counter only through the MCP4822_port_* functions
+ * of one binding, chosen at compile time:
+ *
+ * - default: STM32 HAL, see MCP4822_port_stm32.h
+ * - MCP4822_PORT_POSIX: host build, see MCP4822_port_posix.h
+ *
+ * Every binding function is static inline, so the driver compiles to direct
+ * HAL calls or register accesses without any function pointer in between.
+ *
+ * A binding provides the types MCP4822_Gpio_t, MCP4822_Spi_t, MCP4822_Timer_t,
+ * MCP4822_Dma_t, MCP4822_Port_Dma_Cb and MCP4822_Port_Dma_Hooks_t, the
+ * constant MCP4822_PORT_SPI_16BIT and these functions:
+ *
+ * - MCP4822_port_pin_write(port, pin, high)
+ * - MCP4822_port_spi_set_16bit(spi)
+ * - MCP4822_port_spi_get_format(spi), MCP4822_port_spi_set_format(spi, format)
+ * - MCP4822_port_spi_hardware_nss(spi)
+ * - MCP4822_port_spi_clock_phase_first(spi)
+ * - MCP4822_port_spi_set_nss(spi, hardware)
+ * - MCP4822_port_spi_transmit(spi, frames, count, timeout_ms)
+ * - MCP4822_port_spi_transmit_it(spi, frames, count)
+ * - MCP4822_port_spi_transmit_dma(spi, frames, count)
+ * - MCP4822_port_spi_tx_dma(spi), MCP4822_port_spi_stop_dma(spi)
+ * - MCP4822_port_timer_set_timebase(timer, prescaler, period)
+ * - MCP4822_port_timer_get_timebase(timer, prescaler, period)
+ * - MCP4822_port_timer_dma(timer), MCP4822_port_timer_enable_dma(timer, enable)
+ * - MCP4822_port_timer_start(timer, interrupt), MCP4822_port_timer_stop(timer, interrupt)
+ * - MCP4822_port_dma_circular(dma), MCP4822_port_dma_16bit(dma)
+ * - MCP4822_port_dma_hook(dma, context, half, full, saved),
+ *   MCP4822_port_dma_unhook(dma, saved), MCP4822_port_dma_context(dma)
+ * - MCP4822_port_dma_start_to_spi(dma, spi, frames, count), MCP4822_port_dma_abort(dma)
+ * - MCP4822_port_irq_save(), MCP4822_port_irq_restore(state)
+ * - MCP4822_port_barrier()
+ * - MCP4822_port_ticks_enable(), MCP4822_port_ticks(), MCP4822_port_tick_hz(),
+ *   only with MCP4822_ENABLE_STATS
+ */
+
+/**
+ * @brief Transfer result mapping for binding functions
+ */
+typedef enum
+{
+	MCP4822_PORT_OK					 = 0,
+	MCP4822_PORT_ERROR				 = 1,
+	MCP4822_PORT_TIMEOUT			 = 2
+
+}MCP4822_PORT_STATUS;
+
+#if defined(MCP4822_PORT_POSIX)
+#include "MCP4822_port_posix.h"
+#else
+#include "MCP4822_port_stm32.h"
+#endif
+
+#endif /* __MCP4822_PORT_H_ */
@@ -0,0 +1,598 @@
+/*
+ * MCP4822_port_posix.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_PORT_POSIX_H_
+#define __MCP4822_PORT_POSIX_H_
+
+//clock_gettime and write are POSIX, so ask for them before the first system header even in ISO C modes
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE				   200809L
+#endif
+
+#include <errno.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * Host binding for building, testing and benchmarking the driver without an
+ * MCU. Frames are counted and, when the SPI has a file descriptor, written to
+ * it as raw 16-bit words in host byte order, e.g. into a pipe feeding a
+ * device model. A non-blocking descriptor that is full times the transfer out.
+ *
+ * There are no interrupts. A plain SPI completes transfers as soon as they
+ * start, and MCP4822_port_spi_transmit_it and MCP4822_port_spi_transmit_dma
+ * set pending instead. The application plays the interrupt by clearing
+ * pending and calling MCP4822_dispatch_tx_complete, from the same thread as
+ * the writes.
+ *
+ * DMA channels and timers are software stand-ins driven by the application:
+ * MCP4822_port_posix_dma_run moves frames of an SPI TX DMA transfer, as the
+ * SPI clock would, and MCP4822_port_posix_timer_tick plays one update event,
+ * moving one frame through the update DMA channel. Transfer events call the
+ * callbacks installed with MCP4822_port_dma_hook or, on an SPI TX DMA channel
+ * without them, set half_pending and pending on the SPI like the HAL SPI
+ * callbacks would fire. A GPIO port calls its changed callback, if set, on
+ * every level change, so a device model can follow CS and LDAC.
+ *
+ * The binding functions behave as documented in MCP4822_port_stm32.h.
+ */
+
+/** SPI frame format of one 16-bit word per frame, the host SPI keeps the word size in bits */
+#define MCP4822_PORT_SPI_16BIT		   16
+
+typedef struct MCP4822_Port_Dma MCP4822_Dma_t;
+
+/**
+ * @brief DMA transfer callback, the owner is read back with MCP4822_port_dma_context
+ */
+typedef void (*MCP4822_Port_Dma_Cb)(MCP4822_Dma_t *dma);
+
+/**
+ * @brief Owner and transfer callbacks of a DMA channel, kept while the driver borrows it
+ */
+typedef struct
+{
+
+	void *context;
+
+	MCP4822_Port_Dma_Cb half;
+
+	MCP4822_Port_Dma_Cb full;
+
+}MCP4822_Port_Dma_Hooks_t;
+
+/**
+ * @brief Host GPIO level change callback
+ */
+typedef void (*MCP4822_Port_Pin_Cb)(void *context, uint16_t pin, uint8_t high);
+
+/**
+ * @brief Host GPIO port, one level bit per pin mask
+ */
+typedef struct
+{
+
+	uint32_t levels;
+
+	MCP4822_Port_Pin_Cb changed;
+
+	void *context;
+
+}MCP4822_Gpio_t;
+
+/**
+ * @brief Host SPI, a frame sink
+ */
+typedef struct
+{
+
+	int fd;
+
+	uint32_t frames;
+
+	uint16_t last_frame;
+
+	uint8_t hardware_nss;
+
+	uint8_t cpha;
+
+	uint32_t format;
+
+	MCP4822_Dma_t *tx_dma;
+
+	volatile uint8_t half_pending;
+
+	volatile uint8_t pending;
+
+}MCP4822_Spi_t;
+
+/**
+ * @brief Host DMA channel, moves frames into an SPI when stepped
+ */
+struct MCP4822_Port_Dma
+{
+
+	void *parent;
+
+	MCP4822_Port_Dma_Cb half;
+
+	MCP4822_Port_Dma_Cb full;
+
+	uint8_t circular;
+
+	uint8_t width_16bit;
+
+	uint8_t active;
+
+	MCP4822_Spi_t *target;
+
+	const uint16_t *source;
+
+	uint16_t length;
+
+	uint16_t index;
+
+};
+
+/**
+ * @brief Host timer, keeps the programmed timebase and plays update events on request
+ */
+typedef struct
+{
+
+	uint32_t prescaler;
+
+	uint32_t period;
+
+	MCP4822_Dma_t *update_dma;
+
+	uint8_t running;
+
+	uint8_t interrupt;
+
+	uint8_t dma_enabled;
+
+	uint32_t updates;
+
+	uint64_t clocks;
+
+}MCP4822_Timer_t;
+
+/**
+ * @brief Initializes a host GPIO port, every pin low and no change callback
+ *
+ * @param port - GPIO port to be initialized
+ *
+ * @return None
+ */
+static inline void MCP4822_port_posix_gpio_init(MCP4822_Gpio_t *port){
+
+	port->levels = 0;
+	port->changed = NULL;
+	port->context = NULL;
+}
+
+/**
+ * @brief Initializes a host SPI
+ *
+ * @param spi - SPI to be initialized
+ * @param fd - descriptor receiving the frames, -1 to only count them
+ * @param tx_dma - DMA channel linked to the transmitter, NULL for transfers that complete at once
+ *
+ * @return None
+ */
+static inline void MCP4822_port_posix_spi_init(MCP4822_Spi_t *spi, int fd, MCP4822_Dma_t *tx_dma){
+
+	spi->fd = fd;
+	spi->frames = 0;
+	spi->last_frame = 0;
+	spi->hardware_nss = 0;
+	spi->cpha = 0;
+	spi->format = MCP4822_PORT_SPI_16BIT;
+	spi->tx_dma = tx_dma;
+	spi->half_pending = 0;
+	spi->pending = 0;
+}
+
+/**
+ * @brief Initializes a host DMA channel with half-word widths
+ *
+ * @param dma - DMA channel to be initialized
+ * @param circular - non-zero to wrap around the buffer
+ *
+ * @return None
+ */
+static inline void MCP4822_port_posix_dma_init(MCP4822_Dma_t *dma, uint8_t circular){
+
+	dma->parent = NULL;
+	dma->half = NULL;
+	dma->full = NULL;
+	dma->circular = (circular != 0);
+	dma->width_16bit = 1;
+	dma->active = 0;
+	dma->target = NULL;
+	dma->source = NULL;
+	dma->length = 0;
+	dma->index = 0;
+}
+
+/**
+ * @brief Initializes a host timer, stopped
+ *
+ * @param timer - timer to be initialized
+ * @param update_dma - DMA channel linked to the update event, may be NULL
+ *
+ * @return None
+ */
+static inline void MCP4822_port_posix_timer_init(MCP4822_Timer_t *timer, MCP4822_Dma_t *update_dma){
+
+	timer->prescaler = 0;
+	timer->period = 1;
+	timer->update_dma = update_dma;
+	timer->running = 0;
+	timer->interrupt = 0;
+	timer->dma_enabled = 0;
+	timer->updates = 0;
+	timer->clocks = 0;
+}
+
+static inline void MCP4822_port_pin_write(MCP4822_Gpio_t *port, uint16_t pin, uint8_t high){
+
+	uint32_t before = port->levels;
+
+	if(high){
+		port->levels |= pin;
+	}
+	else{
+		port->levels &= ~(uint32_t)pin;
+	}
+
+	if(port->changed != NULL && port->levels != before){
+		port->changed(port->context, pin, high);
+	}
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_set_16bit(MCP4822_Spi_t *spi){
+
+	spi->format = MCP4822_PORT_SPI_16BIT;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline uint32_t MCP4822_port_spi_get_format(const MCP4822_Spi_t *spi){
+
+	return spi->format;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_set_format(MCP4822_Spi_t *spi, uint32_t format){
+
+	spi->format = format;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline uint8_t MCP4822_port_spi_hardware_nss(const MCP4822_Spi_t *spi){
+
+	return spi->hardware_nss;
+}
+
+static inline uint8_t MCP4822_port_spi_clock_phase_first(const MCP4822_Spi_t *spi){
+
+	return (spi->cpha == 0);
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_set_nss(MCP4822_Spi_t *spi, uint8_t hardware){
+
+	spi->hardware_nss = (hardware != 0);
+
+	return MCP4822_PORT_OK;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count, uint32_t timeout_ms){
+
+	(void)timeout_ms;
+
+	if(count == 0){
+		return MCP4822_PORT_OK;
+	}
+
+	if(spi->fd >= 0){
+		const uint8_t *bytes = (const uint8_t *)frames;
+		size_t left = (size_t)count * sizeof(uint16_t);
+
+		//Pipes and sockets may take the burst in pieces, a full non-blocking one is a device that stopped taking frames
+		while(left > 0){
+			ssize_t written = write(spi->fd, bytes, left);
+			if(written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+				return MCP4822_PORT_TIMEOUT;
+			}
+			if(written <= 0){
+				return MCP4822_PORT_ERROR;
+			}
+			bytes += written;
+			left -= (size_t)written;
+		}
+	}
+
+	spi->frames += count;
+	spi->last_frame = frames[count - 1];
+
+	return MCP4822_PORT_OK;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit_it(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count){
+
+	if(spi->pending){
+		return MCP4822_PORT_ERROR;
+	}
+
+	MCP4822_PORT_STATUS status = MCP4822_port_spi_transmit(spi, frames, count, 0);
+	if(status == MCP4822_PORT_OK){
+		spi->pending = 1;
+	}
+
+	return status;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit_dma(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count){
+
+	MCP4822_Dma_t *dma = spi->tx_dma;
+
+	if(dma == NULL){
+		return MCP4822_port_spi_transmit_it(spi, frames, count);
+	}
+
+	if(dma->active || count == 0){
+		return MCP4822_PORT_ERROR;
+	}
+
+	//The frames leave as MCP4822_port_posix_dma_run steps the channel
+	dma->half = NULL;
+	dma->full = NULL;
+	dma->target = spi;
+	dma->source = frames;
+	dma->length = count;
+	dma->index = 0;
+	dma->active = 1;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline MCP4822_Dma_t *MCP4822_port_spi_tx_dma(MCP4822_Spi_t *spi){
+
+	return spi->tx_dma;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_stop_dma(MCP4822_Spi_t *spi){
+
+	if(spi->tx_dma != NULL){
+		spi->tx_dma->active = 0;
+	}
+	spi->half_pending = 0;
+	spi->pending = 0;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline void MCP4822_port_timer_set_timebase(MCP4822_Timer_t *timer, uint32_t prescaler, uint32_t period){
+
+	timer->prescaler = prescaler;
+	timer->period = period;
+}
+
+static inline void MCP4822_port_timer_get_timebase(const MCP4822_Timer_t *timer, uint32_t *prescaler, uint32_t *period){
+
+	*prescaler = timer->prescaler;
+	*period = timer->period;
+}
+
+static inline MCP4822_Dma_t *MCP4822_port_timer_dma(MCP4822_Timer_t *timer){
+
+	return timer->update_dma;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_timer_start(MCP4822_Timer_t *timer, uint8_t interrupt){
+
+	if(timer->running){
+		return MCP4822_PORT_ERROR;
+	}
+
+	timer->interrupt = (interrupt != 0);
+	timer->running = 1;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_timer_stop(MCP4822_Timer_t *timer, uint8_t interrupt){
+
+	(void)interrupt;
+
+	timer->running = 0;
+	timer->interrupt = 0;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline void MCP4822_port_timer_enable_dma(MCP4822_Timer_t *timer, uint8_t enable){
+
+	timer->dma_enabled = (enable != 0);
+}
+
+static inline uint8_t MCP4822_port_dma_circular(const MCP4822_Dma_t *dma){
+
+	return dma->circular;
+}
+
+static inline uint8_t MCP4822_port_dma_16bit(const MCP4822_Dma_t *dma){
+
+	return dma->width_16bit;
+}
+
+static inline void MCP4822_port_dma_hook(MCP4822_Dma_t *dma, void *context, MCP4822_Port_Dma_Cb half, MCP4822_Port_Dma_Cb full,
+										 MCP4822_Port_Dma_Hooks_t *saved){
+
+	saved->context = dma->parent;
+	saved->half = dma->half;
+	saved->full = dma->full;
+
+	dma->parent = context;
+	dma->half = half;
+	dma->full = full;
+}
+
+static inline void MCP4822_port_dma_unhook(MCP4822_Dma_t *dma, const MCP4822_Port_Dma_Hooks_t *saved){
+
+	dma->parent = saved->context;
+	dma->half = saved->half;
+	dma->full = saved->full;
+}
+
+static inline void *MCP4822_port_dma_context(const MCP4822_Dma_t *dma){
+
+	return dma->parent;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_dma_start_to_spi(MCP4822_Dma_t *dma, MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count){
+
+	if(dma->active || count == 0){
+		return MCP4822_PORT_ERROR;
+	}
+
+	dma->target = spi;
+	dma->source = frames;
+	dma->length = count;
+	dma->index = 0;
+	dma->active = 1;
+
+	return MCP4822_PORT_OK;
+}
+
+static inline MCP4822_PORT_STATUS MCP4822_port_dma_abort(MCP4822_Dma_t *dma){
+
+	dma->active = 0;
+
+	return MCP4822_PORT_OK;
+}
+
+/**
+ * @brief Moves frames of a running DMA transfer into its SPI, raising the transfer events on the way
+ *
+ * @param dma - DMA channel
+ * @param frames - maximum number of frames to move
+ *
+ * @return Number of frames moved, fewer once a normal mode transfer ends
+ */
+static inline uint32_t MCP4822_port_posix_dma_run(MCP4822_Dma_t *dma, uint32_t frames){
+
+	uint32_t moved = 0;
+
+	while(moved < frames && dma->active){
+
+		if(MCP4822_port_spi_transmit(dma->target, &dma->source[dma->index], 1, 0) != MCP4822_PORT_OK){
+			dma->active = 0;
+			break;
+		}
+		moved++;
+
+		uint8_t hooked = (dma->half != NULL || dma->full != NULL);
+		dma->index++;
+
+		if(dma->index == dma->length / 2){
+			if(dma->half != NULL){
+				dma->half(dma);
+			}
+			else if(!hooked){
+				dma->target->half_pending = 1;
+			}
+		}
+
+		if(dma->index == dma->length){
+			dma->index = 0;
+			if(!dma->circular){
+				dma->active = 0;
+			}
+
+			if(dma->full != NULL){
+				dma->full(dma);
+			}
+			else if(!hooked){
+				dma->target->pending = 1;
+			}
+		}
+	}
+
+	return moved;
+}
+
+/**
+ * @brief Plays one timer update event, moving one frame through the update DMA channel when enabled
+ *
+ * The kernel clocks a real timer would have counted, (prescaler + 1) * period,
+ * are added to clocks so tests can time the frames.
+ *
+ * @param timer - timer
+ *
+ * @return 1 if the update interrupt is enabled and its handler is due, 0 otherwise
+ */
+static inline uint8_t MCP4822_port_posix_timer_tick(MCP4822_Timer_t *timer){
+
+	if(!timer->running){
+		return 0;
+	}
+
+	timer->updates++;
+	timer->clocks += (uint64_t)(timer->prescaler + 1) * timer->period;
+
+	if(timer->dma_enabled && timer->update_dma != NULL){
+		MCP4822_port_posix_dma_run(timer->update_dma, 1);
+	}
+
+	return timer->interrupt;
+}
+
+static inline uint32_t MCP4822_port_irq_save(void){
+
+	return 0;
+}
+
+static inline void MCP4822_port_irq_restore(uint32_t state){
+
+	(void)state;
+}
+
+static inline void MCP4822_port_barrier(void){
+
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#ifdef MCP4822_ENABLE_STATS
+static inline void MCP4822_port_ticks_enable(void){
+
+}
+
+static inline uint32_t MCP4822_port_ticks(void){
+
+	struct timespec now;
+#ifdef CLOCK_MONOTONIC
+	clock_gettime(CLOCK_MONOTONIC, &now);
+#else
+	//A system header included ahead of the driver's fixed the feature set without POSIX, use the C11 clock
+	timespec_get(&now, TIME_UTC);
+#endif
+
+	//Wraps every 4.29 s, which unsigned differences of shorter durations tolerate
+	return (uint32_t)((uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec);
+}
+
+static inline uint32_t MCP4822_port_tick_hz(void){
+
+	return 1000000000U;
+}
+#endif
+
+#endif /* __MCP4822_PORT_POSIX_H_ */
@@ -0,0 +1,575 @@
+/*
+ * MCP4822_port_stm32.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_PORT_STM32_H_
+#define __MCP4822_PORT_STM32_H_
+
+/** HAL header of the target family, e.g. "stm32g4xx_hal.h" */
+#ifndef MCP4822_PORT_HAL_HEADER
+#define MCP4822_PORT_HAL_HEADER		   "stm32l5xx_hal.h"
+#endif
+
+#include MCP4822_PORT_HAL_HEADER
+
+/**
+ * SPI transmit backend. Define MCP4822_USE_LL_SPI to drive the SPI data register
+ * and status flags directly instead of going through HAL_SPI_Transmit.
+ */
+#ifndef MCP4822_LL_SPI_SPIN_LIMIT
+#define MCP4822_LL_SPI_SPIN_LIMIT	   10000    //flag polls before a transfer is abandoned
+#endif
+
+/** The HAL handles are used as they are, so existing HAL setup code keeps working */
+typedef GPIO_TypeDef MCP4822_Gpio_t;
+
+typedef SPI_HandleTypeDef MCP4822_Spi_t;
+
+typedef TIM_HandleTypeDef MCP4822_Timer_t;
+
+typedef DMA_HandleTypeDef MCP4822_Dma_t;
+
+/** SPI frame format of one 16-bit word per frame, see MCP4822_port_spi_get_format */
+#define MCP4822_PORT_SPI_16BIT		   SPI_DATASIZE_16BIT
+
+/**
+ * @brief DMA transfer callback, the owner is read back with MCP4822_port_dma_context
+ */
+typedef void (*MCP4822_Port_Dma_Cb)(MCP4822_Dma_t *dma);
+
+/**
+ * @brief Owner and transfer callbacks of a DMA channel, kept while the driver borrows it
+ */
+typedef struct
+{
+
+	void *context;
+
+	MCP4822_Port_Dma_Cb half;
+
+	MCP4822_Port_Dma_Cb full;
+
+}MCP4822_Port_Dma_Hooks_t;
+
+/**
+ * @brief Maps a HAL status to a binding status
+ *
+ * @param status - HAL status
+ *
+ * @return Binding status
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_status(HAL_StatusTypeDef status){
+
+	if(status == HAL_OK){
+		return MCP4822_PORT_OK;
+	}
+
+	return (status == HAL_TIMEOUT) ? MCP4822_PORT_TIMEOUT : MCP4822_PORT_ERROR;
+}
+
+/**
+ * @brief Drives a GPIO pin
+ *
+ * @param port - GPIO port
+ * @param pin - GPIO pin mask
+ * @param high - non-zero for high, 0 for low
+ *
+ * @return None
+ */
+static inline void MCP4822_port_pin_write(MCP4822_Gpio_t *port, uint16_t pin, uint8_t high){
+
+	HAL_GPIO_WritePin(port, pin, high ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+/**
+ * @brief Switches the SPI to 16-bit frames, re-initializing it only when needed
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_set_16bit(MCP4822_Spi_t *spi){
+
+	if(spi->Init.DataSize == SPI_DATASIZE_16BIT){
+		return MCP4822_PORT_OK;
+	}
+
+	spi->Init.DataSize = SPI_DATASIZE_16BIT;
+
+	return MCP4822_port_status(HAL_SPI_Init(spi));
+}
+
+/**
+ * @brief Reads the SPI frame format
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return Data size setting, MCP4822_PORT_SPI_16BIT for 16-bit frames
+ */
+static inline uint32_t MCP4822_port_spi_get_format(const MCP4822_Spi_t *spi){
+
+	return spi->Init.DataSize;
+}
+
+/**
+ * @brief Changes the SPI frame format, re-initializing the peripheral only when needed
+ *
+ * @param spi - SPI peripheral
+ * @param format - data size setting from MCP4822_port_spi_get_format
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_set_format(MCP4822_Spi_t *spi, uint32_t format){
+
+	if(spi->Init.DataSize == format){
+		return MCP4822_PORT_OK;
+	}
+
+	spi->Init.DataSize = format;
+
+	return MCP4822_port_status(HAL_SPI_Init(spi));
+}
+
+/**
+ * @brief Reports whether the SPI already drives NSS in pulse mode
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return 1 for hardware NSS with a pulse between frames, 0 otherwise
+ */
+static inline uint8_t MCP4822_port_spi_hardware_nss(const MCP4822_Spi_t *spi){
+
+	return (spi->Init.NSS == SPI_NSS_HARD_OUTPUT && spi->Init.NSSPMode == SPI_NSS_PULSE_ENABLE);
+}
+
+/**
+ * @brief Reports whether data is captured on the first clock edge (CPHA = 0)
+ *
+ * NSS pulse mode only inserts its pulse between frames in this phase.
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return 1 for CPHA = 0, 0 otherwise
+ */
+static inline uint8_t MCP4822_port_spi_clock_phase_first(const MCP4822_Spi_t *spi){
+
+	return (spi->Init.CLKPhase == SPI_PHASE_1EDGE);
+}
+
+/**
+ * @brief Selects hardware NSS with a pulse between frames, or software NSS
+ *
+ * @param spi - SPI peripheral
+ * @param hardware - non-zero for hardware NSS
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_set_nss(MCP4822_Spi_t *spi, uint8_t hardware){
+
+	if(hardware){
+		spi->Init.NSS = SPI_NSS_HARD_OUTPUT;
+		spi->Init.NSSPMode = SPI_NSS_PULSE_ENABLE;
+	}
+	else{
+		spi->Init.NSS = SPI_NSS_SOFT;
+		spi->Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+	}
+
+	return MCP4822_port_status(HAL_SPI_Init(spi));
+}
+
+#ifdef MCP4822_USE_LL_SPI
+/**
+ * @brief Clocks frames out of the SPI without touching CS, returning once the last one has left the shift register
+ *
+ * @param spi - SPI peripheral
+ * @param frames - encoded 16-bit frames
+ * @param count - number of frames to send
+ * @param timeout_ms - unused, every flag wait is bounded by MCP4822_LL_SPI_SPIN_LIMIT polls
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_TIMEOUT otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count, uint32_t timeout_ms){
+
+	SPI_TypeDef *regs = spi->Instance;
+	uint32_t spins = MCP4822_LL_SPI_SPIN_LIMIT;
+
+	//A 16-bit access keeps the frame from being packed as two bytes, taken through a pointer as LL_SPI_TransmitData16 does
+	__IO uint16_t *data = (__IO uint16_t *)&regs->DR;
+
+	(void)timeout_ms;
+
+	//The HAL leaves the peripheral disabled until its first transfer
+	if(!READ_BIT(regs->CR1, SPI_CR1_SPE)){
+		SET_BIT(regs->CR1, SPI_CR1_SPE);
+	}
+
+	for(uint16_t i = 0; i < count; i++){
+
+		while(!READ_BIT(regs->SR, SPI_SR_TXE)){
+			if(--spins == 0){
+				return MCP4822_PORT_TIMEOUT;
+			}
+		}
+
+		*data = frames[i];
+
+		//Discard received words as they arrive so the RX FIFO never overruns
+		while(READ_BIT(regs->SR, SPI_SR_RXNE)){
+			(void)*data;
+		}
+
+		spins = MCP4822_LL_SPI_SPIN_LIMIT;
+	}
+
+	//CS may only rise once the last frame has fully left the shift register
+	while(READ_BIT(regs->SR, SPI_SR_FTLVL) || READ_BIT(regs->SR, SPI_SR_BSY)){
+		if(--spins == 0){
+			return MCP4822_PORT_TIMEOUT;
+		}
+	}
+
+	while(READ_BIT(regs->SR, SPI_SR_RXNE)){
+		(void)*data;
+	}
+	(void)regs->SR;
+
+	return MCP4822_PORT_OK;
+}
+#else
+/**
+ * @brief Clocks frames out of the SPI without touching CS, returning once they are sent
+ *
+ * @param spi - SPI peripheral
+ * @param frames - encoded 16-bit frames
+ * @param count - number of frames to send
+ * @param timeout_ms - time allowed for the whole transfer
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_TIMEOUT or MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count, uint32_t timeout_ms){
+
+	return MCP4822_port_status(HAL_SPI_Transmit(spi, (uint8_t *)frames, count, timeout_ms));
+}
+#endif
+
+/**
+ * @brief Starts an interrupt driven transfer, HAL_SPI_TxCpltCallback or HAL_SPI_ErrorCallback follows
+ *
+ * @param spi - SPI peripheral
+ * @param frames - encoded 16-bit frames, valid until the transfer ends
+ * @param count - number of frames to send
+ *
+ * @return MCP4822_PORT_OK if started, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit_it(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count){
+
+	return MCP4822_port_status(HAL_SPI_Transmit_IT(spi, (uint8_t *)frames, count));
+}
+
+/**
+ * @brief Starts a DMA transfer, HAL_SPI_TxCpltCallback or HAL_SPI_ErrorCallback follows
+ *
+ * @param spi - SPI peripheral
+ * @param frames - encoded 16-bit frames, valid until the transfer ends
+ * @param count - number of frames to send
+ *
+ * @return MCP4822_PORT_OK if started, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_transmit_dma(MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count){
+
+	return MCP4822_port_status(HAL_SPI_Transmit_DMA(spi, (uint8_t *)frames, count));
+}
+
+/**
+ * @brief DMA channel linked to the SPI transmitter
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return DMA channel, NULL if none is linked
+ */
+static inline MCP4822_Dma_t *MCP4822_port_spi_tx_dma(MCP4822_Spi_t *spi){
+
+	return spi->hdmatx;
+}
+
+/**
+ * @brief Aborts the SPI DMA transfers
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_spi_stop_dma(MCP4822_Spi_t *spi){
+
+	return MCP4822_port_status(HAL_SPI_DMAStop(spi));
+}
+
+/**
+ * @brief Loads a new timebase immediately instead of at the next update event
+ *
+ * @param timer - timer
+ * @param prescaler - prescaler register value, the clock is divided by prescaler + 1
+ * @param period - update period in prescaled ticks, 1 .. 65536
+ *
+ * @return None
+ */
+static inline void MCP4822_port_timer_set_timebase(MCP4822_Timer_t *timer, uint32_t prescaler, uint32_t period){
+
+	//Keep the init struct in step so a later HAL_TIM_Base_Init does not bring back the old rate
+	timer->Init.Prescaler = prescaler;
+	timer->Init.Period = period - 1;
+	__HAL_TIM_SET_PRESCALER(timer, prescaler);
+	__HAL_TIM_SET_AUTORELOAD(timer, period - 1);
+	__HAL_TIM_SET_COUNTER(timer, 0);
+	timer->Instance->EGR = TIM_EGR_UG;
+	__HAL_TIM_CLEAR_FLAG(timer, TIM_FLAG_UPDATE);
+}
+
+/**
+ * @brief Reads back the timebase the timer is running with
+ *
+ * @param timer - timer
+ * @param prescaler - prescaler register value
+ * @param period - update period in prescaled ticks
+ *
+ * @return None
+ */
+static inline void MCP4822_port_timer_get_timebase(const MCP4822_Timer_t *timer, uint32_t *prescaler, uint32_t *period){
+
+	*prescaler = timer->Instance->PSC;
+	*period = timer->Instance->ARR + 1;
+}
+
+/**
+ * @brief DMA channel linked to the timer update event
+ *
+ * @param timer - timer
+ *
+ * @return DMA channel, NULL if none is linked
+ */
+static inline MCP4822_Dma_t *MCP4822_port_timer_dma(MCP4822_Timer_t *timer){
+
+	return timer->hdma[TIM_DMA_ID_UPDATE];
+}
+
+/**
+ * @brief Starts the timer
+ *
+ * @param timer - timer
+ * @param interrupt - non-zero to also raise the update interrupt, HAL_TIM_PeriodElapsedCallback follows each update
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_timer_start(MCP4822_Timer_t *timer, uint8_t interrupt){
+
+	return MCP4822_port_status(interrupt ? HAL_TIM_Base_Start_IT(timer) : HAL_TIM_Base_Start(timer));
+}
+
+/**
+ * @brief Stops the timer
+ *
+ * @param timer - timer
+ * @param interrupt - non-zero if it was started with the update interrupt
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_timer_stop(MCP4822_Timer_t *timer, uint8_t interrupt){
+
+	return MCP4822_port_status(interrupt ? HAL_TIM_Base_Stop_IT(timer) : HAL_TIM_Base_Stop(timer));
+}
+
+/**
+ * @brief Enables or disables the DMA request of the timer update event
+ *
+ * @param timer - timer
+ * @param enable - non-zero to enable
+ *
+ * @return None
+ */
+static inline void MCP4822_port_timer_enable_dma(MCP4822_Timer_t *timer, uint8_t enable){
+
+	if(enable){
+		__HAL_TIM_ENABLE_DMA(timer, TIM_DMA_UPDATE);
+	}
+	else{
+		__HAL_TIM_DISABLE_DMA(timer, TIM_DMA_UPDATE);
+	}
+}
+
+/**
+ * @brief Reports whether a DMA channel wraps around its buffer
+ *
+ * @param dma - DMA channel
+ *
+ * @return 1 in circular mode, 0 otherwise
+ */
+static inline uint8_t MCP4822_port_dma_circular(const MCP4822_Dma_t *dma){
+
+	return (dma->Init.Mode == DMA_CIRCULAR);
+}
+
+/**
+ * @brief Reports whether a DMA channel moves whole 16-bit frames
+ *
+ * @param dma - DMA channel
+ *
+ * @return 1 for half-word memory and peripheral widths, 0 otherwise
+ */
+static inline uint8_t MCP4822_port_dma_16bit(const MCP4822_Dma_t *dma){
+
+	return (dma->Init.PeriphDataAlignment == DMA_PDATAALIGN_HALFWORD && dma->Init.MemDataAlignment == DMA_MDATAALIGN_HALFWORD);
+}
+
+/**
+ * @brief Installs an owner and transfer callbacks on a DMA channel, keeping the previous ones
+ *
+ * @param dma - DMA channel
+ * @param context - owner, read back with MCP4822_port_dma_context
+ * @param half - half transfer callback
+ * @param full - transfer complete callback
+ * @param saved - receives the previous owner and callbacks
+ *
+ * @return None
+ */
+static inline void MCP4822_port_dma_hook(MCP4822_Dma_t *dma, void *context, MCP4822_Port_Dma_Cb half, MCP4822_Port_Dma_Cb full,
+										 MCP4822_Port_Dma_Hooks_t *saved){
+
+	saved->context = dma->Parent;
+	saved->half = dma->XferHalfCpltCallback;
+	saved->full = dma->XferCpltCallback;
+
+	dma->Parent = context;
+	dma->XferHalfCpltCallback = half;
+	dma->XferCpltCallback = full;
+}
+
+/**
+ * @brief Puts back the owner and callbacks saved by MCP4822_port_dma_hook
+ *
+ * @param dma - DMA channel
+ * @param saved - owner and callbacks to restore
+ *
+ * @return None
+ */
+static inline void MCP4822_port_dma_unhook(MCP4822_Dma_t *dma, const MCP4822_Port_Dma_Hooks_t *saved){
+
+	dma->Parent = saved->context;
+	dma->XferHalfCpltCallback = saved->half;
+	dma->XferCpltCallback = saved->full;
+}
+
+/**
+ * @brief Owner installed by MCP4822_port_dma_hook
+ *
+ * @param dma - DMA channel
+ *
+ * @return Owner
+ */
+static inline void *MCP4822_port_dma_context(const MCP4822_Dma_t *dma){
+
+	return dma->Parent;
+}
+
+/**
+ * @brief Starts a DMA transfer into the SPI data register, one frame per request of the channel
+ *
+ * @param dma - DMA channel
+ * @param spi - SPI peripheral, enabled before the first request
+ * @param frames - encoded 16-bit frames, valid until the transfer ends
+ * @param count - number of frames to move
+ *
+ * @return MCP4822_PORT_OK if started, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_dma_start_to_spi(MCP4822_Dma_t *dma, MCP4822_Spi_t *spi, const uint16_t *frames, uint16_t count){
+
+	__HAL_SPI_ENABLE(spi);
+
+	return MCP4822_port_status(HAL_DMA_Start_IT(dma, (uint32_t)frames, (uint32_t)&spi->Instance->DR, count));
+}
+
+/**
+ * @brief Aborts a DMA transfer
+ *
+ * @param dma - DMA channel
+ *
+ * @return MCP4822_PORT_OK in case of success, MCP4822_PORT_ERROR otherwise
+ */
+static inline MCP4822_PORT_STATUS MCP4822_port_dma_abort(MCP4822_Dma_t *dma){
+
+	return MCP4822_port_status(HAL_DMA_Abort(dma));
+}
+
+/**
+ * @brief Masks interrupts
+ *
+ * @return Previous interrupt mask, for MCP4822_port_irq_restore
+ */
+static inline uint32_t MCP4822_port_irq_save(void){
+
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	return primask;
+}
+
+/**
+ * @brief Restores the interrupt mask saved by MCP4822_port_irq_save
+ *
+ * @param state - saved interrupt mask
+ *
+ * @return None
+ */
+static inline void MCP4822_port_irq_restore(uint32_t state){
+
+	__set_PRIMASK(state);
+}
+
+/**
+ * @brief Orders memory accesses before and after it, as seen by interrupts and DMA
+ *
+ * @return None
+ */
+static inline void MCP4822_port_barrier(void){
+
+	__DMB();
+}
+
+#ifdef MCP4822_ENABLE_STATS
+/**
+ * @brief Starts the DWT cycle counter
+ *
+ * @return None
+ */
+static inline void MCP4822_port_ticks_enable(void){
+
+	//The cycle counter only runs once trace is enabled
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief Reads the DWT cycle counter
+ *
+ * @return Core clock cycles, wrapping at 2^32
+ */
+static inline uint32_t MCP4822_port_ticks(void){
+
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief Tick rate of MCP4822_port_ticks
+ *
+ * @return Core clock frequency in Hz
+ */
+static inline uint32_t MCP4822_port_tick_hz(void){
+
+	return SystemCoreClock;
+}
+#endif
+
+#endif /* __MCP4822_PORT_STM32_H_ */
@@ -0,0 +1,154 @@
+/*
+ * MCP4822_resample.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_RESAMPLE_H_
+#define __MCP4822_RESAMPLE_H_
+
+#include "MCP4822.h"
+#include "MCP4822_source.h"
+
+/** Input samples pulled from the source per call */
+#ifndef MCP4822_RESAMPLE_BLOCK
+#define MCP4822_RESAMPLE_BLOCK		   32
+#endif
+
+/** Longest filter, sets the history kept between source calls and the deepest downward ratio */
+#ifndef MCP4822_RESAMPLE_TAPS_MAX
+#define MCP4822_RESAMPLE_TAPS_MAX	   64
+#endif
+
+/**
+ * @brief Interpolation quality mapping
+ */
+typedef enum
+{
+	MCP4822_RESAMPLE_NEAREST		 = 0,     //repeats or drops samples
+	MCP4822_RESAMPLE_LINEAR			 = 1,
+	MCP4822_RESAMPLE_SINC8			 = 2,     //8-tap polyphase windowed sinc
+	MCP4822_RESAMPLE_SINC16			 = 3      //16-tap polyphase windowed sinc
+
+}MCP4822_RESAMPLE_QUALITY;
+
+/**
+ * @brief Streaming sample-rate converter
+ *
+ * The read position advances by step, the input to output rate ratio in
+ * 32.32 fixed point, for every output sample. For a downward conversion the
+ * sinc kernels are stretched so their cutoff scales by output / input rate,
+ * which takes input / output times as many taps. Nearest and linear do not
+ * band-limit and alias when converting down.
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	MCP4822_DAC_SELECT dac_channel;
+
+	MCP4822_Source_Cb source;
+
+	void *context;
+
+	MCP4822_RESAMPLE_QUALITY quality;
+
+	uint8_t taps;
+
+	uint8_t base_taps;
+
+	uint32_t scale_q16;
+
+	uint32_t step_int;
+
+	uint32_t step_frac;
+
+	uint32_t frac;
+
+	uint32_t index;
+
+	uint32_t filled;
+
+	uint32_t limit;
+
+	uint8_t ended;
+
+	int16_t input[MCP4822_RESAMPLE_BLOCK + 2 * MCP4822_RESAMPLE_TAPS_MAX];
+
+}MCP4822_Resampler_t;
+
+/**
+ * @brief Initializes a resampler reading from a source
+ *
+ * The tap count is fixed here from the ratio, so a sinc quality converting
+ * down by more than MCP4822_RESAMPLE_TAPS_MAX / 8 or / 16 is rejected.
+ *
+ * @param resampler - resampler to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - DAC channel addressed by MCP4822_resample_refill
+ * @param source - sample producer at the input rate
+ * @param context - user pointer handed to source
+ * @param quality - interpolation quality
+ * @param input_rate - rate of the source in Hz
+ * @param output_rate - rate the output is played at in Hz
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_resample_init(MCP4822_Resampler_t *resampler, MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel,
+									 MCP4822_Source_Cb source, void *context, MCP4822_RESAMPLE_QUALITY quality,
+									 uint32_t input_rate, uint32_t output_rate);
+
+/**
+ * @brief Changes the conversion ratio without disturbing the stream
+ *
+ * Meant for following a DAC update rate measured at run time, e.g. after the
+ * SPI clock or timer period changes. The cutoff follows the new ratio as far
+ * as the taps chosen at init allow and stops lowering past that.
+ *
+ * @param resampler - resampler
+ * @param input_rate - rate of the source in Hz
+ * @param output_rate - rate the output is played at in Hz
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_resample_set_rates(MCP4822_Resampler_t *resampler, uint32_t input_rate, uint32_t output_rate);
+
+/**
+ * @brief Drops the history and restarts from the source's current position
+ *
+ * Call after rewinding or seeking the source.
+ *
+ * @param resampler - resampler
+ *
+ * @return None
+ */
+void MCP4822_resample_reset(MCP4822_Resampler_t *resampler);
+
+/**
+ * @brief Source callback producing signed 16-bit samples at the output rate
+ *
+ * Chains the converter in front of the mixer or another stage. Once the
+ * source ends the filter tail is flushed and a short count is returned.
+ *
+ * @param context - MCP4822_Resampler_t to read
+ * @param samples - destination for the samples
+ * @param count - number of samples requested
+ *
+ * @return Number of samples written, less than count once the source has ended
+ */
+uint32_t MCP4822_resample_read(void *context, int16_t *samples, uint32_t count);
+
+/**
+ * @brief Stream refill callback encoding the converted samples for dac_channel
+ *
+ * @param context - MCP4822_Resampler_t to read
+ * @param frames - destination for the encoded frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written, less than count once the source has ended
+ */
+uint32_t MCP4822_resample_refill(void *context, uint16_t *frames, uint32_t count);
+
+#endif /* __MCP4822_RESAMPLE_H_ */
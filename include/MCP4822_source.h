@@ -0,0 +1,23 @@
+/*
+ * MCP4822_source.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_SOURCE_H_
+#define __MCP4822_SOURCE_H_
+
+#include <stdint.h>
+
+/**
+ * @brief Producer of signed 16-bit (Q15) mono samples
+ *
+ * Called with the producer's context, a destination and the number of samples
+ * wanted. Returns the number written, a short count marks the end of the source.
+ * Asset players, generators and resamplers all share this signature so they
+ * can be chained and mixed.
+ */
+typedef uint32_t (*MCP4822_Source_Cb)(void *context, int16_t *samples, uint32_t count);
+
+#endif /* __MCP4822_SOURCE_H_ */
@@ -0,0 +1,202 @@
+/*
+ * MCP4822_stats.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_STATS_H_
+#define __MCP4822_STATS_H_
+
+#include "MCP4822.h"
+
+/**
+ * Write path instrumentation. Define MCP4822_ENABLE_STATS to time every write
+ * call and count transfer failures. Without it the hooks below compile to
+ * nothing and the handle has no stats pointer.
+ *
+ * Times are in ticks of the transport binding: core clock cycles from the DWT
+ * cycle counter with the STM32 binding, nanoseconds from the monotonic clock
+ * with the POSIX binding.
+ */
+
+/** Histogram buckets, bucket i counts durations of 2^(i-1) up to 2^i - 1 ticks */
+#define MCP4822_STATS_BUCKETS		   32
+
+/**
+ * @brief Instrumented write paths
+ */
+typedef enum
+{
+	MCP4822_STATS_WRITE_TO_CHAN		 = 0,
+	MCP4822_STATS_WRITE_PAIR		 = 1,
+	MCP4822_STATS_CONFIGURE			 = 2,
+	MCP4822_STATS_WRITE_FRAMES		 = 3,
+	MCP4822_STATS_WRITE_FRAMES_DMA	 = 4,
+	MCP4822_STATS_ASYNC_ENQUEUE		 = 5,
+	MCP4822_STATS_ASYNC_COMPLETE	 = 6,
+	MCP4822_STATS_BUS_WRITE			 = 7,
+	MCP4822_STATS_API_COUNT			 = 8
+
+}MCP4822_STATS_API;
+
+/**
+ * @brief Duration summary of one write path
+ *
+ * min is UINT32_MAX while count is 0.
+ */
+typedef struct
+{
+
+	uint32_t count;
+
+	uint32_t min;
+
+	uint32_t max;
+
+	uint64_t total;
+
+	uint32_t histogram[MCP4822_STATS_BUCKETS];
+
+}MCP4822_Stats_Api_t;
+
+/**
+ * @brief Write statistics of one handle
+ *
+ * The blocking writes count MCP4822_ERROR_SPI results in spi_errors or, when
+ * the transfer ran out of time, in timeouts. Failed interrupt and DMA
+ * transfers are counted in spi_errors.
+ */
+struct MCP4822_Stats
+{
+
+	MCP4822_Stats_Api_t apis[MCP4822_STATS_API_COUNT];
+
+	uint32_t spi_errors;
+
+	uint32_t timeouts;
+
+};
+
+#ifdef MCP4822_ENABLE_STATS
+
+/**
+ * @brief Clears a stats block and attaches it to the handle, starting the cycle counter on target
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param stats - stats storage, NULL to detach
+ *
+ * @return None
+ */
+void MCP4822_stats_attach(MCP4822_Handle_t *handle, MCP4822_Stats_t *stats);
+
+/**
+ * @brief Copies the handle's stats as one consistent set
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param snapshot - copy to be filled
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG if no stats are attached
+ */
+MCP4822_STATUS MCP4822_stats_snapshot(const MCP4822_Handle_t *handle, MCP4822_Stats_t *snapshot);
+
+/**
+ * @brief Clears the handle's stats
+ *
+ * @param handle - handle for MCP4822 driver
+ *
+ * @return None
+ */
+void MCP4822_stats_reset(MCP4822_Handle_t *handle);
+
+/**
+ * @brief Mean duration of one write path
+ *
+ * @param api - duration summary
+ *
+ * @return Mean in ticks, 0 if nothing was recorded
+ */
+uint32_t MCP4822_stats_mean(const MCP4822_Stats_Api_t *api);
+
+/**
+ * @brief Tick rate of the recorded durations
+ *
+ * @return Ticks per second
+ */
+uint32_t MCP4822_stats_tick_hz(void);
+
+/**
+ * @brief Adds one duration to a write path, see MCP4822_stats_record
+ *
+ * @param stats - stats block
+ * @param api - write path
+ * @param ticks - duration
+ *
+ * @return None
+ */
+void MCP4822_stats_add(MCP4822_Stats_t *stats, MCP4822_STATS_API api, uint32_t ticks);
+
+#endif
+
+/**
+ * @brief Reads the free running tick counter
+ *
+ * @return Current tick count, 0 without MCP4822_ENABLE_STATS
+ */
+static inline uint32_t MCP4822_stats_now(void){
+
+#ifdef MCP4822_ENABLE_STATS
+	return MCP4822_port_ticks();
+#else
+	return 0;
+#endif
+}
+
+/**
+ * @brief Records the duration of a write started at start
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param api - write path
+ * @param start - tick count from MCP4822_stats_now taken when the write began
+ *
+ * @return None
+ */
+static inline void MCP4822_stats_record(MCP4822_Handle_t *handle, MCP4822_STATS_API api, uint32_t start){
+
+#ifdef MCP4822_ENABLE_STATS
+	if(handle->stats != NULL){
+		MCP4822_stats_add(handle->stats, api, MCP4822_stats_now() - start);
+	}
+#else
+	(void)handle;
+	(void)api;
+	(void)start;
+#endif
+}
+
+/**
+ * @brief Counts a failed transfer
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param timeout - non-zero if the transfer ran out of time
+ *
+ * @return None
+ */
+static inline void MCP4822_stats_error(MCP4822_Handle_t *handle, uint8_t timeout){
+
+#ifdef MCP4822_ENABLE_STATS
+	if(handle->stats != NULL){
+		if(timeout){
+			handle->stats->timeouts++;
+		}
+		else{
+			handle->stats->spi_errors++;
+		}
+	}
+#else
+	(void)handle;
+	(void)timeout;
+#endif
+}
+
+#endif /* __MCP4822_STATS_H_ */
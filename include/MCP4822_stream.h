@@ -0,0 +1,279 @@
+/*
+ * MCP4822_stream.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __MCP4822_STREAM_H_
+#define __MCP4822_STREAM_H_
+
+#include "MCP4822.h"
+
+/**
+ * @brief Refill callback used by the streaming engine
+ *
+ * Called from the SPI DMA interrupt whenever one half of the stream buffer has
+ * been sent. The callback must write up to count encoded frames (see
+ * MCP4822_encode_frame) and return how many it wrote. Returning fewer than
+ * count marks the end of the stream: the remaining slots hold the last frame
+ * (in pair mode the last A and B frames, alternately) and the stream halts its timer and DMA once that data has been played out.
+ * Call MCP4822_stream_stop afterwards to hand the SPI back in its original
+ * frame size; that re-initializes the peripheral, which is never done from
+ * the interrupt.
+ *
+ * @param context - user pointer given to MCP4822_stream_init
+ * @param frames - destination for the encoded frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written
+ */
+typedef uint32_t (*MCP4822_Stream_Refill_Cb)(void *context, uint16_t *frames, uint32_t count);
+
+/**
+ * @brief Streaming engine state mapping
+ */
+typedef enum
+{
+	MCP4822_STREAM_IDLE				 = 0,
+	MCP4822_STREAM_RUNNING			 = 1,
+	MCP4822_STREAM_DRAINING			 = 2
+
+}MCP4822_STREAM_STATE;
+
+/**
+ * @brief MCP4822 circular DMA stream struct
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	uint16_t *buffer;
+
+	uint32_t buffer_len;
+
+	MCP4822_Stream_Refill_Cb refill;
+
+	void *context;
+
+	volatile MCP4822_STREAM_STATE state;
+
+	uint8_t drain_count;
+
+	uint16_t last_frames[2];
+
+	uint8_t last_channel;
+
+	uint8_t last_valid;
+
+	uint32_t saved_format;
+
+	uint8_t format_saved;
+
+	MCP4822_Dma_t *paced_dma;
+
+	MCP4822_Port_Dma_Hooks_t saved_dma_hooks;
+
+	uint8_t pair_mode;
+
+	uint32_t read_index;
+
+	volatile uint8_t pair_busy;
+
+	volatile uint8_t pair_loaded;
+
+	uint32_t underruns;
+
+}MCP4822_Stream_t;
+
+/**
+ * @brief Interleaved stereo sample buffer played through a pair-mode stream
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t *handle;
+
+	const int16_t *samples;
+
+	uint32_t pairs;
+
+	uint32_t position;
+
+	uint8_t loop;
+
+	uint8_t held;
+
+	uint16_t held_frame;
+
+}MCP4822_Stereo_t;
+
+/**
+ * @brief Initializes a circular DMA stream
+ *
+ * The handle must be in MCP4822_CS_HARDWARE_NSS mode (see MCP4822_set_cs_mode)
+ * so that every 16-bit frame is latched by the device without CPU help.
+ *
+ * Without a sample clock the SPI TX DMA channel (circular mode) sends frames
+ * back to back and MCP4822_dispatch.h routes the SPI interrupts to the stream
+ * handlers.
+ * With a sample clock set by MCP4822_set_sample_rate the timer update DMA
+ * channel (circular mode) moves one frame per update into the SPI data
+ * register and the handlers are installed on that DMA channel automatically;
+ * its own parent and callbacks are put back when the stream stops. Either
+ * channel must move half-words on both sides.
+ *
+ * @param stream - stream to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param buffer - frame buffer, split into two halves that are refilled alternately
+ * @param buffer_len - total buffer length in frames (even, at most 65534)
+ * @param refill - callback producing encoded frames, NULL to drain the FIFO attached to the handle
+ * @param context - user pointer passed to the refill callback
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_stream_init(MCP4822_Stream_t *stream, MCP4822_Handle_t *handle, uint16_t *buffer, uint32_t buffer_len,
+								   MCP4822_Stream_Refill_Cb refill, void *context);
+
+/**
+ * @brief Pre-fills both buffer halves and starts the circular DMA transfer
+ *
+ * The stream owns the SPI (see MCP4822_dispatch.h) until it stops.
+ *
+ * @param stream - stream to be started
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_BUSY if running or another owner holds the SPI, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_stream_start(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Starts streaming interleaved A/B frame pairs latched together by LDAC
+ *
+ * The buffer holds channel A and channel B frames alternately. On every sample
+ * clock tick the pair loaded on the previous tick is latched with one LDAC
+ * pulse and the next pair is moved to the device by a two-frame SPI TX DMA
+ * transfer (normal mode). Requires a sample clock, an LDAC pin and
+ * MCP4822_CS_HARDWARE_NSS mode; the buffer length must be a multiple of 4.
+ * The stream owns the SPI (see MCP4822_dispatch.h) until it stops.
+ *
+ * @param stream - stream to be started
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_BUSY if running or another owner holds the SPI, MCP4822_ERROR_INVALID_ARG or MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_stream_start_pairs(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Latches the previous pair and sends the next one, call from HAL_TIM_PeriodElapsedCallback in pair mode
+ *
+ * LDAC is only pulsed once the pair sent on the previous tick has completed.
+ * If it is still being clocked out, the DAC holds a half-loaded pair: the tick
+ * neither latches nor starts the next pair, it only counts an underrun in the
+ * stream's underruns field, and the pair is latched on the following tick, so
+ * channels A and B always change together and no data is skipped. A pair cut
+ * short by an SPI error is never latched.
+ *
+ * @param stream - stream owning the sample clock
+ *
+ * @return None
+ */
+void MCP4822_stream_pair_tick_handler(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Marks the pair sent by the tick as finished, called by MCP4822_dispatch_tx_complete and MCP4822_dispatch_error in pair mode
+ *
+ * @param stream - stream owning the SPI peripheral
+ * @param complete - 1 if both frames were sent, 0 if the transfer failed
+ *
+ * @return None
+ */
+void MCP4822_stream_pair_complete_handler(MCP4822_Stream_t *stream, uint8_t complete);
+
+/**
+ * @brief Stops the DMA transfer and restores the SPI frame size, call from thread context
+ *
+ * Whenever a stream stops, by itself or here, the last frame it sent to each
+ * channel is recorded in the handle (see MCP4822_note_frames), so shutdown,
+ * activate and gain changes afterwards resume at the streamed level.
+ *
+ * Also completes a stream that ended by itself, which leaves the SPI in 16-bit
+ * frames until then.
+ *
+ * @param stream - stream to be stopped
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+MCP4822_STATUS MCP4822_stream_stop(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Refills the first buffer half, called by MCP4822_dispatch_tx_half_complete in unpaced mode
+ *
+ * @param stream - stream owning the SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_stream_half_transfer_handler(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Refills the second buffer half, called by MCP4822_dispatch_tx_complete in unpaced mode
+ *
+ * @param stream - stream owning the SPI peripheral
+ *
+ * @return None
+ */
+void MCP4822_stream_transfer_complete_handler(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Encodes interleaved L/R samples into alternating channel A/B frames
+ *
+ * Each L/R pair is loaded as one word and both frames are built with a
+ * single offset, shift, mask and header OR, so no per-channel lookups are
+ * made. Left goes to channel A and right to channel B.
+ *
+ * The word trick relies on the left sample being the low half of the loaded
+ * word, which holds on little-endian targets such as Cortex-M. Big-endian
+ * builds (__BYTE_ORDER__) assemble and split the word explicitly instead.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param samples - interleaved signed 16-bit L/R samples
+ * @param frames - output frames, may be the same buffer as samples
+ * @param pairs - number of L/R pairs
+ *
+ * @return None
+ */
+void MCP4822_stereo_encode(const MCP4822_Handle_t *handle, const int16_t *samples, uint16_t *frames, uint32_t pairs);
+
+/**
+ * @brief Sets up a stereo buffer to be played with MCP4822_stereo_refill
+ *
+ * @param stereo - stereo player to be initialized
+ * @param handle - handle for MCP4822 driver
+ * @param samples - interleaved signed 16-bit L/R samples, kept by reference
+ * @param pairs - number of L/R pairs in samples
+ * @param loop - non-zero to restart from the first pair at the end
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_INVALID_ARG otherwise
+ */
+MCP4822_STATUS MCP4822_stereo_init(MCP4822_Stereo_t *stereo, MCP4822_Handle_t *handle, const int16_t *samples, uint32_t pairs, uint8_t loop);
+
+/**
+ * @brief Stream refill callback producing A/B frame pairs from a stereo buffer
+ *
+ * Pass it to MCP4822_stream_init with the MCP4822_Stereo_t as context and
+ * start the stream with MCP4822_stream_start_pairs, which sends each pair as
+ * one two-frame DMA transfer latched by a single LDAC pulse.
+ *
+ * With MCP4822_stream_start a buffer half may hold an odd number of frames.
+ * The pair that does not fit is split: its channel A frame ends this refill
+ * and its channel B frame starts the next one, so the A/B order runs on
+ * unbroken and the count is only short once the samples run out.
+ *
+ * @param context - MCP4822_Stereo_t to play
+ * @param frames - destination for interleaved A, B frames
+ * @param count - number of frames requested
+ *
+ * @return Number of frames written, count unless the samples have run out
+ */
+uint32_t MCP4822_stereo_refill(void *context, uint16_t *frames, uint32_t count);
+
+#endif /* __MCP4822_STREAM_H_ */
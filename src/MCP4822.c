@@ -5,6 +5,45 @@
  *      Author: Ben Francis
  */
 #include "MCP4822.h"
+#include "MCP4822_fifo.h"
+#include "MCP4822_cal.h"
+#include "MCP4822_stats.h"
+
+/**
+ * @brief Integer scale converting one voltage unit to DAC codes as (value * mult + rounding) >> shift
+ */
+typedef struct
+{
+
+	uint32_t mult;
+
+	uint8_t shift;
+
+	int32_t limit;
+
+}MCP4822_Fixed_Scale_t;
+
+/**
+ * Codes per volt are 4096 / (2.048 V * gain), i.e. 2000 at 1X and 1000 at 2X.
+ * Each entry reproduces that ratio exactly for its unit. limit is the first
+ * input whose unrounded code is 4096 or more and is clamped before scaling;
+ * inputs just below it that round up to 4096 are clamped after scaling.
+ * Indexed by [unit][gain].
+ */
+static const MCP4822_Fixed_Scale_t fixed_volt_scales[3][2] =
+{
+	//Millivolts: 1 code per mV at 2X, 2 codes per mV at 1X
+	{ { 1, 0, 4096 }, { 2, 0, 2048 } },
+
+	//Microvolts: divide by 1000 or 500 using ceil(2^32 / divisor)
+	{ { 4294968, 32, 4096000 }, { 8589935, 32, 2048000 } },
+
+	//Q16.16 volts: 1000 / 65536 = 125 / 8192 and 2000 / 65536 = 125 / 4096
+	{ { 125, 13, 268436 }, { 125, 12, 134218 } }
+};
+
+/** Floating point codes per volt, indexed by gain */
+static const float volt_scales[2] = { (MCP4822_DAC_MAX + 1) / (MCP4822_VREF * 2), (MCP4822_DAC_MAX + 1) / MCP4822_VREF };
 
 /**
  * @brief Retrieves the pointer to the correct channel configuration
@@ -26,7 +65,66 @@ static inline MCP4822_Config_t *get_chan_config(MCP4822_Handle_t *handle, MCP482
  */
 static inline uint16_t volts_to_DAC_units(float volts, MCP4822_OUTPUT_GAIN gain);
 
-void MCP4822_handle_init(MCP4822_Handle_t *handle, GPIO_TypeDef *cs_port, uint16_t cs_pin, SPI_HandleTypeDef *hspi){
+/**
+ * @brief Rebuilds the cached 16-bit header word after a channel configuration change
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - channel whose header word is refreshed
+ *
+ * @return None
+ */
+static inline void update_chan_header(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Sends up to two frames that differ from the channel shadows, then latches them
+ *
+ * Frames equal to the last frame sent to their channel are dropped unless
+ * force_writes is set. Nothing is sent and LDAC is not pulsed when every
+ * frame is redundant, the outputs already hold those values.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param frames - encoded frames, one per channel
+ * @param count - number of frames, 1 or 2
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+static MCP4822_STATUS write_tracked(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count);
+
+/**
+ * @brief Re-sends the last value of a channel with its current configuration bits
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - channel whose configuration changed
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+static inline MCP4822_STATUS resend_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Code that keeps the last level of a channel under its current configuration
+ *
+ * A level that went out corrected for the other gain is corrected again from
+ * its ideal code, as long as the calibration still maps that code to it.
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param dac_channel - channel to be re-sent
+ *
+ * @return Code to send
+ */
+static inline uint16_t resend_code(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel);
+
+/**
+ * @brief Sends encoded frames to the device input registers, one CS edge per frame
+ *
+ * @param handle - handle for MCP4822 driver
+ * @param frames - encoded 16-bit frames
+ * @param count - number of frames to send
+ *
+ * @return MCP4822_OK in case of success, MCP4822_ERROR_SPI otherwise
+ */
+static MCP4822_STATUS transmit_frames(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count);
+
+MCP4822_STATUS MCP4822_handle_init(MCP4822_Handle_t *handle, MCP4822_Gpio_t *cs_port, uint16_t cs_pin, MCP4822_Spi_t *hspi){
 
 	//Assign the port and pins for the SPI CS pin
 	handle->CS_Port = cs_port;
@@ -34,12 +132,57 @@ void MCP4822_handle_init(MCP4822_Handle_t *handle, GPIO_TypeDef *cs_port, uint16
 
 	handle->hspi = hspi;
 
+	//Output is unpaced until a sample clock is configured
+	handle->htim = NULL;
+	handle->timer_clock_hz = 0;
+	handle->sample_rate = 0;
+
+	//Outputs follow each write until an LDAC pin is assigned
+	handle->LDAC_Port = NULL;
+	handle->LDAC_Pin = 0;
+
+	//Keep a hardware NSS setup made by the SPI init code, as long as its pulses land between frames
+	if(MCP4822_port_spi_hardware_nss(hspi) && MCP4822_port_spi_clock_phase_first(hspi)){
+		handle->cs_mode = MCP4822_CS_HARDWARE_NSS;
+	}
+	else{
+		handle->cs_mode = MCP4822_CS_SOFTWARE;
+	}
+
+	//Writes block until an async queue is attached
+	handle->async = NULL;
+	handle->fifo = NULL;
+	handle->cal = NULL;
+	handle->cal_codes[0] = 0;
+	handle->cal_codes[1] = 0;
+#ifdef MCP4822_ENABLE_STATS
+	handle->stats = NULL;
+#endif
+
+	//The device state is unknown, so the first write to each channel is always sent
+	handle->shadow_frames[0] = 0;
+	handle->shadow_frames[1] = 0;
+	handle->shadow_valid = 0;
+	handle->force_writes = 0;
+	handle->frames_sent = 0;
+	handle->frames_suppressed = 0;
+
 	//Initialize both channel configurations
 	handle->chan_configs.chan_A_config.gain = MCP4822_GAIN_1X;
 	handle->chan_configs.chan_A_config.shutdown = MCP4822_ACTIVE_MODE;
 
 	handle->chan_configs.chan_B_config.gain = MCP4822_GAIN_1X;
 	handle->chan_configs.chan_B_config.shutdown = MCP4822_ACTIVE_MODE;
+
+	update_chan_header(handle, MCP4822_CHANNEL_A);
+	update_chan_header(handle, MCP4822_CHANNEL_B);
+
+	//Send each command word as one 16-bit SPI frame, the SPI is only re-initialized if it uses another data size
+	if(MCP4822_port_spi_set_16bit(hspi) != MCP4822_PORT_OK){
+		return MCP4822_ERROR_SPI;
+	}
+
+	return MCP4822_OK;
 }
 
 MCP4822_STATUS MCP4822_write_to_chan(MCP4822_Handle_t *handle, uint16_t value, MCP4822_DAC_SELECT dac_channel){
@@ -49,29 +192,15 @@ MCP4822_STATUS MCP4822_write_to_chan(MCP4822_Handle_t *handle, uint16_t value, M
 		 return MCP4822_ERROR_INVALID_ARG;
 	}
 
-	//Receive the correct DAC channel configuration
-	MCP4822_Config_t *curr_chan_config = get_chan_config(handle, dac_channel);
-
-	uint8_t tx_data[2];
+	uint32_t start = MCP4822_stats_now();
 
-	//Prepare the tx buffer to be transmitted over SPI to the device
-	tx_data[0] = ((uint8_t)((dac_channel) & FIRST_BIT_MASK) << SHIFT_7) |
-				 ((uint8_t)((curr_chan_config->gain) & FIRST_BIT_MASK) << SHIFT_5) |
-				 ((uint8_t)((curr_chan_config->shutdown) & FIRST_BIT_MASK) << SHIFT_4) |
-				 (uint8_t)((value >> SHIFT_8) & LOW_HALF_BYTE_MASK);
+	//OR the corrected value into the cached header word for this channel
+	uint16_t frame = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, dac_channel, value), dac_channel);
 
-	tx_data[1] = (uint8_t)(value & FIRST_BYTE_MASK);
-
-	//Transmit the tx buffer over SPI
-	HAL_GPIO_WritePin(handle->CS_Port, handle->CS_Pin, GPIO_PIN_RESET);
-	HAL_StatusTypeDef spi_status = HAL_SPI_Transmit(handle->hspi, tx_data, sizeof(tx_data), MCP4822_SPI_TIMEOUT);
-	HAL_GPIO_WritePin(handle->CS_Port, handle->CS_Pin, GPIO_PIN_SET);
-
-	if(spi_status != HAL_OK){
-		return MCP4822_ERROR_SPI;
-	}
+	MCP4822_STATUS status = write_tracked(handle, &frame, 1);
+	MCP4822_stats_record(handle, MCP4822_STATS_WRITE_TO_CHAN, start);
 
-	return MCP4822_OK;
+	return status;
 }
 
 MCP4822_STATUS MCP4822_shutdown_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
@@ -81,12 +210,10 @@ MCP4822_STATUS MCP4822_shutdown_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELEC
 
 	//Set the channel and its circuitry to be shutdown
 	curr_chan_config->shutdown = MCP4822_SHUTDOWN_MODE;
+	update_chan_header(handle, dac_channel);
 
 	//Write the channel shutdown condition to the device
-	const uint16_t dummy_value = 0x0000;
-	MCP4822_STATUS status = MCP4822_write_to_chan(handle, dummy_value, dac_channel);
-
-	return status;
+	return resend_chan(handle, dac_channel);
 }
 
 MCP4822_STATUS MCP4822_activate_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
@@ -96,37 +223,173 @@ MCP4822_STATUS MCP4822_activate_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELEC
 
 	//Set the channel and its circuitry to be activated
 	curr_chan_config->shutdown = MCP4822_ACTIVE_MODE;
+	update_chan_header(handle, dac_channel);
 
 	//Write the channel activation condition to the device
-	const uint16_t dummy_value = 0x0000;
-	MCP4822_STATUS status = MCP4822_write_to_chan(handle, dummy_value, dac_channel);
-
-	return status;
+	return resend_chan(handle, dac_channel);
 }
 
-void MCP4822_set_chan_gain(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain_update){
+MCP4822_STATUS MCP4822_set_chan_gain(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain_update){
 
 	//Receive the correct DAC channel configuration
 	MCP4822_Config_t *curr_chan_config = get_chan_config(handle, dac_channel);
 
 	//Update the DAC channel gain
 	curr_chan_config->gain = gain_update;
+	update_chan_header(handle, dac_channel);
+
+	//Apply the gain to the current level straight away
+	return resend_chan(handle, dac_channel);
+}
+
+MCP4822_STATUS MCP4822_configure(MCP4822_Handle_t *handle, const MCP4822_Chan_Configs_t *configs){
+
+	if(configs == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint32_t start = MCP4822_stats_now();
+
+	handle->chan_configs = *configs;
+	update_chan_header(handle, MCP4822_CHANNEL_A);
+	update_chan_header(handle, MCP4822_CHANNEL_B);
+
+	//Both channels keep their levels and switch configuration on the same LDAC pulse
+	uint16_t frames[2];
+	frames[0] = MCP4822_encode_frame(handle, resend_code(handle, MCP4822_CHANNEL_A), MCP4822_CHANNEL_A);
+	frames[1] = MCP4822_encode_frame(handle, resend_code(handle, MCP4822_CHANNEL_B), MCP4822_CHANNEL_B);
+
+	MCP4822_STATUS status = write_tracked(handle, frames, 2);
+	MCP4822_stats_record(handle, MCP4822_STATS_CONFIGURE, start);
+
+	return status;
 }
 
 MCP4822_STATUS MCP4822_write_to_both_chans(MCP4822_Handle_t *handle, uint16_t value){
 
-	//Write the value to channel A
-	MCP4822_STATUS status = MCP4822_write_to_chan(handle, value, MCP4822_CHANNEL_A);
-	if(status != MCP4822_OK){
-			return status;
+	//Write the value to both channels with a single output update
+	return MCP4822_write_pair(handle, value, value);
+}
+
+MCP4822_STATUS MCP4822_set_cs_mode(MCP4822_Handle_t *handle, MCP4822_CS_MODE cs_mode){
+
+	//NSS pulse mode only separates frames when data is captured on the first clock edge
+	if(cs_mode == MCP4822_CS_HARDWARE_NSS && !MCP4822_port_spi_clock_phase_first(handle->hspi)){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Let the peripheral raise NSS after every frame, or leave CS to the GPIO
+	if(MCP4822_port_spi_set_nss(handle->hspi, cs_mode == MCP4822_CS_HARDWARE_NSS) != MCP4822_PORT_OK){
+		return MCP4822_ERROR_SPI;
+	}
+
+	handle->cs_mode = cs_mode;
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_write_frames(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count){
+
+	if(frames == NULL || count == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint32_t start = MCP4822_stats_now();
+
+	//Raw frames bypass the shadow check, so the shadows no longer describe the outputs
+	MCP4822_note_frames(handle, frames, count);
+
+	MCP4822_STATUS status = transmit_frames(handle, frames, count);
+
+	//Latch the whole burst at once, as write_tracked does, when LDAC is not tied low
+	if(status == MCP4822_OK){
+		MCP4822_pulse_ldac(handle);
+	}
+	MCP4822_stats_record(handle, MCP4822_STATS_WRITE_FRAMES, start);
+
+	return status;
+}
+
+MCP4822_STATUS MCP4822_write_frames_dma(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count){
+
+	//Only hardware NSS can give each frame of a DMA burst its own CS edge
+	if(frames == NULL || count == 0 || handle->cs_mode != MCP4822_CS_HARDWARE_NSS){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint32_t start = MCP4822_stats_now();
+
+	MCP4822_note_frames(handle, frames, count);
+
+	if(MCP4822_port_spi_transmit_dma(handle->hspi, frames, count) != MCP4822_PORT_OK){
+		MCP4822_stats_error(handle, 0);
+		return MCP4822_ERROR_SPI;
+	}
+
+	//Only the start is timed, the burst itself runs without the CPU
+	MCP4822_stats_record(handle, MCP4822_STATS_WRITE_FRAMES_DMA, start);
+
+	return MCP4822_OK;
+}
+
+void MCP4822_set_force_writes(MCP4822_Handle_t *handle, uint8_t force){
+
+	handle->force_writes = force;
+}
+
+void MCP4822_attach_fifo(MCP4822_Handle_t *handle, MCP4822_Fifo_t *fifo){
+
+	handle->fifo = fifo;
+
+	if(fifo != NULL){
+		fifo->last_frame = MCP4822_encode_frame(handle, 0, MCP4822_CHANNEL_A);
+	}
+}
+
+void MCP4822_attach_cal(MCP4822_Handle_t *handle, MCP4822_Cal_t *cal){
+
+	handle->cal = cal;
+}
+
+void MCP4822_set_ldac_pin(MCP4822_Handle_t *handle, MCP4822_Gpio_t *ldac_port, uint16_t ldac_pin){
+
+	handle->LDAC_Port = ldac_port;
+	handle->LDAC_Pin = ldac_pin;
+
+	//Hold LDAC high so frames only load the input registers
+	if(ldac_port != NULL){
+		MCP4822_port_pin_write(ldac_port, ldac_pin, 1);
 	}
+}
+
+MCP4822_STATUS MCP4822_write_pair(MCP4822_Handle_t *handle, uint16_t a_value, uint16_t b_value){
+
+	//Limit values to the max input for MCP4822
+	if(a_value > MCP4822_DAC_MAX || b_value > MCP4822_DAC_MAX){
+		 return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint32_t start = MCP4822_stats_now();
+
+	//Load both input registers before touching the outputs, write_tracked latches them with one LDAC pulse
+	uint16_t frames[2];
+	frames[0] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_A, a_value), MCP4822_CHANNEL_A);
+	frames[1] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_B, b_value), MCP4822_CHANNEL_B);
 
-	//Write the value to channel B
-	status = MCP4822_write_to_chan(handle, value, MCP4822_CHANNEL_B);
+	MCP4822_STATUS status = write_tracked(handle, frames, 2);
+	MCP4822_stats_record(handle, MCP4822_STATS_WRITE_PAIR, start);
 
 	return status;
 }
 
+uint16_t MCP4822_volts_to_chan_units(MCP4822_Handle_t *handle, float volts, MCP4822_DAC_SELECT dac_channel){
+
+	//Receive the correct DAC channel configuration
+	MCP4822_Config_t *curr_chan_config = get_chan_config(handle, dac_channel);
+
+	return volts_to_DAC_units(volts, curr_chan_config->gain);
+}
+
 MCP4822_STATUS MCP4822_write_volts_to_chan(MCP4822_Handle_t *handle, float volts, MCP4822_DAC_SELECT dac_channel){
 
 	//Receive the correct DAC channel configuration
@@ -141,18 +404,119 @@ MCP4822_STATUS MCP4822_write_volts_to_chan(MCP4822_Handle_t *handle, float volts
 	return status;
 }
 
+float MCP4822_chan_volt_scale(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
+
+	//Receive the correct DAC channel configuration
+	MCP4822_Config_t *curr_chan_config = get_chan_config(handle, dac_channel);
+
+	return volt_scales[curr_chan_config->gain & FIRST_BIT_MASK];
+}
+
+MCP4822_STATUS MCP4822_fixed_volts_to_chan_units(MCP4822_Handle_t *handle, int32_t value, MCP4822_VOLT_UNIT unit, MCP4822_DAC_SELECT dac_channel, uint16_t *DAC_value){
+
+	//The unit indexes the scale table
+	if((uint32_t)unit >= sizeof(fixed_volt_scales) / sizeof(fixed_volt_scales[0])){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Receive the correct DAC channel configuration
+	MCP4822_Config_t *curr_chan_config = get_chan_config(handle, dac_channel);
+	const MCP4822_Fixed_Scale_t *scale = &fixed_volt_scales[unit][curr_chan_config->gain & FIRST_BIT_MASK];
+
+	//Saturate before scaling so the product can never overflow or wrap
+	if(value <= 0){
+		*DAC_value = 0;
+	}
+	else if(value >= scale->limit){
+		*DAC_value = MCP4822_DAC_MAX;
+	}
+	else{
+		uint64_t rounding = (scale->shift > 0) ? ((uint64_t)1 << (scale->shift - 1)) : 0;
+		uint32_t code = (uint32_t)(((uint64_t)value * scale->mult + rounding) >> scale->shift);
+
+		*DAC_value = (code > MCP4822_DAC_MAX) ? MCP4822_DAC_MAX : (uint16_t)code;
+	}
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_write_millivolts_to_chan(MCP4822_Handle_t *handle, int32_t millivolts, MCP4822_DAC_SELECT dac_channel){
+
+	uint16_t DAC_value;
+
+	MCP4822_fixed_volts_to_chan_units(handle, millivolts, MCP4822_UNIT_MILLIVOLTS, dac_channel, &DAC_value);
+
+	return MCP4822_write_to_chan(handle, DAC_value, dac_channel);
+}
+
+MCP4822_STATUS MCP4822_write_microvolts_to_chan(MCP4822_Handle_t *handle, int32_t microvolts, MCP4822_DAC_SELECT dac_channel){
+
+	uint16_t DAC_value;
+
+	MCP4822_fixed_volts_to_chan_units(handle, microvolts, MCP4822_UNIT_MICROVOLTS, dac_channel, &DAC_value);
+
+	return MCP4822_write_to_chan(handle, DAC_value, dac_channel);
+}
+
+MCP4822_STATUS MCP4822_write_q16_volts_to_chan(MCP4822_Handle_t *handle, int32_t volts_q16, MCP4822_DAC_SELECT dac_channel){
+
+	uint16_t DAC_value;
+
+	MCP4822_fixed_volts_to_chan_units(handle, volts_q16, MCP4822_UNIT_Q16_VOLTS, dac_channel, &DAC_value);
+
+	return MCP4822_write_to_chan(handle, DAC_value, dac_channel);
+}
+
 MCP4822_STATUS MCP4822_write_volts_to_both_chans(MCP4822_Handle_t *handle, float volts){
 
-	//Convert and write the voltage to channel A
-	MCP4822_STATUS status = MCP4822_write_volts_to_chan(handle, volts, MCP4822_CHANNEL_A);
-	if(status != MCP4822_OK){
-		return status;
+	//Each channel converts with its own gain, then both are latched together like MCP4822_write_pair
+	uint16_t A_value = volts_to_DAC_units(volts, get_chan_config(handle, MCP4822_CHANNEL_A)->gain);
+	uint16_t B_value = volts_to_DAC_units(volts, get_chan_config(handle, MCP4822_CHANNEL_B)->gain);
+
+	return MCP4822_write_pair(handle, A_value, B_value);
+}
+
+MCP4822_STATUS MCP4822_set_sample_rate(MCP4822_Handle_t *handle, MCP4822_Timer_t *htim, uint32_t timer_clock_hz, uint32_t sample_rate){
+
+	if(htim == NULL || sample_rate == 0 || sample_rate > timer_clock_hz){
+		return MCP4822_ERROR_INVALID_ARG;
 	}
 
-	//Convert and write the voltage to channel A
-	status = MCP4822_write_volts_to_chan(handle, volts, MCP4822_CHANNEL_B);
+	//Split the total tick count into the smallest prescaler that lets the period fit 16 bits
+	uint32_t ticks = (uint32_t)(((uint64_t)timer_clock_hz + sample_rate / 2) / sample_rate);
+	uint32_t prescaler = (ticks - 1) / MCP4822_TIMER_MAX_PERIOD;
+	uint64_t divided_rate = (uint64_t)sample_rate * (prescaler + 1);
+	uint32_t period = (uint32_t)(((uint64_t)timer_clock_hz + divided_rate / 2) / divided_rate);
 
-	return status;
+	if(period == 0){
+		period = 1;
+	}
+	else if(period > MCP4822_TIMER_MAX_PERIOD){
+		period = MCP4822_TIMER_MAX_PERIOD;
+	}
+
+	//Load the new timebase immediately instead of at the next update event
+	MCP4822_port_timer_set_timebase(htim, prescaler, period);
+
+	handle->htim = htim;
+	handle->timer_clock_hz = timer_clock_hz;
+	handle->sample_rate = sample_rate;
+
+	return MCP4822_OK;
+}
+
+float MCP4822_get_actual_sample_rate(MCP4822_Handle_t *handle){
+
+	if(handle->htim == NULL){
+		return 0.0f;
+	}
+
+	//Rate after the integer prescaler and period rounding
+	uint32_t prescaler;
+	uint32_t period;
+	MCP4822_port_timer_get_timebase(handle->htim, &prescaler, &period);
+
+	return (float)handle->timer_clock_hz / ((float)(prescaler + 1) * (float)period);
 }
 
 static inline MCP4822_Config_t *get_chan_config(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
@@ -171,8 +535,131 @@ static inline MCP4822_Config_t *get_chan_config(MCP4822_Handle_t *handle, MCP482
 
 static inline uint16_t volts_to_DAC_units(float volts, MCP4822_OUTPUT_GAIN gain){
 
-	//Calculate the DAC value based on the voltage
-	uint8_t gain_mult = (gain == MCP4822_GAIN_2X) ? 2 : 1;
+	//Multiply by the precomputed codes per volt and round to the nearest code
+	float code = volts * volt_scales[gain & FIRST_BIT_MASK] + 0.5f;
+
+	//Saturate instead of wrapping, NaN ends up at 0
+	if(!(code > 0.0f)){
+		return 0;
+	}
+	if(code >= (float)MCP4822_DAC_MAX){
+		return MCP4822_DAC_MAX;
+	}
+
+	return (uint16_t)code;
+}
+
+static MCP4822_STATUS write_tracked(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count){
+
+	uint16_t pending[2];
+	uint16_t pending_count = 0;
+
+	for(uint16_t i = 0; i < count; i++){
+
+		//The channel bit of the frame selects its shadow
+		uint8_t chan = (uint8_t)(frames[i] >> MCP4822_FRAME_CHAN_POS);
+
+		if(!handle->force_writes && (handle->shadow_valid & (1U << chan)) && handle->shadow_frames[chan] == frames[i]){
+			handle->frames_suppressed++;
+			continue;
+		}
+
+		pending[pending_count++] = frames[i];
+	}
+
+	if(pending_count == 0){
+		return MCP4822_OK;
+	}
+
+	MCP4822_STATUS status = transmit_frames(handle, pending, pending_count);
+	if(status != MCP4822_OK){
+
+		//Part of the burst may have reached the device
+		MCP4822_invalidate_shadow(handle);
+		return status;
+	}
+
+	for(uint16_t i = 0; i < pending_count; i++){
+		uint8_t chan = (uint8_t)(pending[i] >> MCP4822_FRAME_CHAN_POS);
+		handle->shadow_frames[chan] = pending[i];
+		handle->shadow_valid |= (uint8_t)(1U << chan);
+	}
+	handle->frames_sent += pending_count;
+
+	//Move the input registers to the outputs when LDAC is not tied low
+	MCP4822_pulse_ldac(handle);
+
+	return MCP4822_OK;
+}
+
+static inline MCP4822_STATUS resend_chan(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
+
+	uint32_t start = MCP4822_stats_now();
+
+	uint16_t frame = MCP4822_encode_frame(handle, resend_code(handle, dac_channel), dac_channel);
+
+	MCP4822_STATUS status = write_tracked(handle, &frame, 1);
+	MCP4822_stats_record(handle, MCP4822_STATS_CONFIGURE, start);
+
+	return status;
+}
+
+static inline uint16_t resend_code(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
+
+	uint8_t chan = dac_channel & FIRST_BIT_MASK;
+	uint16_t shadow = handle->shadow_frames[chan];
+	uint16_t code = shadow & MCP4822_FRAME_DATA_MASK;
+
+	if(handle->cal == NULL || !(handle->shadow_valid & (1U << chan))){
+		return code;
+	}
+
+	//The shadow frame carries the gain it was corrected for
+	MCP4822_OUTPUT_GAIN sent_gain = (MCP4822_OUTPUT_GAIN)((shadow >> MCP4822_FRAME_GAIN_POS) & FIRST_BIT_MASK);
+	MCP4822_OUTPUT_GAIN gain = get_chan_config(handle, dac_channel)->gain;
+
+	//A raw frame or a refused write since the last corrected one leaves the code as it is
+	if(sent_gain != gain && MCP4822_cal_apply(handle->cal, dac_channel, sent_gain, handle->cal_codes[chan]) == code){
+		code = MCP4822_cal_apply(handle->cal, dac_channel, gain, handle->cal_codes[chan]);
+	}
+
+	return code;
+}
+
+static MCP4822_STATUS transmit_frames(MCP4822_Handle_t *handle, const uint16_t *frames, uint16_t count){
+
+	MCP4822_PORT_STATUS spi_status = MCP4822_PORT_OK;
+
+	if(handle->cs_mode == MCP4822_CS_HARDWARE_NSS){
+
+		//The peripheral pulses NSS between frames so the whole burst goes in one transfer, give long bursts enough time
+		spi_status = MCP4822_port_spi_transmit(handle->hspi, frames, count, MCP4822_SPI_TIMEOUT + count / MCP4822_SPI_FRAMES_PER_MS);
+	}
+	else{
+
+		//Frame each word with the CS GPIO so the device latches it
+		for(uint16_t i = 0; i < count && spi_status == MCP4822_PORT_OK; i++){
+			MCP4822_port_pin_write(handle->CS_Port, handle->CS_Pin, 0);
+			spi_status = MCP4822_port_spi_transmit(handle->hspi, &frames[i], 1, MCP4822_SPI_TIMEOUT);
+			MCP4822_port_pin_write(handle->CS_Port, handle->CS_Pin, 1);
+		}
+	}
+
+	if(spi_status != MCP4822_PORT_OK){
+		MCP4822_stats_error(handle, spi_status == MCP4822_PORT_TIMEOUT);
+		return MCP4822_ERROR_SPI;
+	}
+
+	return MCP4822_OK;
+}
+
+static inline void update_chan_header(MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel){
+
+	//Receive the correct DAC channel configuration
+	MCP4822_Config_t *curr_chan_config = get_chan_config(handle, dac_channel);
 
-    return (uint16_t)(volts * (MCP4822_DAC_MAX + 1)/(MCP4822_VREF * gain_mult));
+	//Pack the channel, gain and shutdown bits ahead of the 12-bit data field
+	handle->chan_headers[dac_channel & FIRST_BIT_MASK] = (uint16_t)(((dac_channel & FIRST_BIT_MASK) << MCP4822_FRAME_CHAN_POS) |
+																	((curr_chan_config->gain & FIRST_BIT_MASK) << MCP4822_FRAME_GAIN_POS) |
+																	((curr_chan_config->shutdown & FIRST_BIT_MASK) << MCP4822_FRAME_SHDN_POS));
 }
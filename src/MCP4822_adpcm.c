@@ -0,0 +1,169 @@
+/*
+ * MCP4822_adpcm.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "MCP4822_adpcm.h"
+
+/** IMA ADPCM quantizer step sizes */
+static const int16_t adpcm_steps[MCP4822_ADPCM_STEP_INDEX_MAX + 1] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+	253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+	3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+	12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/** IMA ADPCM step index adjustment per code */
+static const int8_t adpcm_index_steps[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/**
+ * @brief Decodes one 4-bit code and advances the decoder state
+ *
+ * @param state - decoder state
+ * @param code - 4-bit ADPCM code
+ *
+ * @return Decoded 16-bit sample
+ */
+static inline int16_t decode_nibble(MCP4822_ADPCM_State_t *state, uint8_t code);
+
+/**
+ * @brief Extracts the 4-bit code of one sample from the packed stream
+ *
+ * @param data - packed nibble stream
+ * @param sample - sample index
+ * @param nibble_order - order of the nibbles within a byte
+ *
+ * @return 4-bit ADPCM code
+ */
+static inline uint8_t get_nibble(const uint8_t *data, uint32_t sample, MCP4822_ADPCM_NIBBLE_ORDER nibble_order);
+
+void MCP4822_adpcm_decode(MCP4822_ADPCM_State_t *state, const uint8_t *data, uint32_t first_sample, int16_t *pcm, uint32_t count,
+						  MCP4822_ADPCM_NIBBLE_ORDER nibble_order){
+
+	for(uint32_t i = 0; i < count; i++){
+		pcm[i] = decode_nibble(state, get_nibble(data, first_sample + i, nibble_order));
+	}
+}
+
+void MCP4822_adpcm_decode_frames(MCP4822_ADPCM_State_t *state, const uint8_t *data, uint32_t first_sample, uint16_t *frames, uint32_t count,
+								 MCP4822_ADPCM_NIBBLE_ORDER nibble_order, uint16_t header){
+
+	for(uint32_t i = 0; i < count; i++){
+		int16_t sample = decode_nibble(state, get_nibble(data, first_sample + i, nibble_order));
+		frames[i] = header | MCP4822_pcm_to_DAC_units(sample);
+	}
+}
+
+void MCP4822_adpcm_skip(MCP4822_ADPCM_State_t *state, const uint8_t *data, uint32_t first_sample, uint32_t count,
+						MCP4822_ADPCM_NIBBLE_ORDER nibble_order){
+
+	for(uint32_t i = 0; i < count; i++){
+		decode_nibble(state, get_nibble(data, first_sample + i, nibble_order));
+	}
+}
+
+void MCP4822_adpcm_stream_init(MCP4822_ADPCM_Stream_t *stream, MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel,
+							   const uint8_t *data, uint32_t size, MCP4822_ADPCM_NIBBLE_ORDER nibble_order){
+
+	stream->handle = handle;
+	stream->dac_channel = dac_channel;
+	stream->data = data;
+	stream->sample_count = size * 2;
+	stream->nibble_order = nibble_order;
+	stream->loop = 0;
+
+	MCP4822_adpcm_stream_rewind(stream);
+}
+
+void MCP4822_adpcm_stream_rewind(MCP4822_ADPCM_Stream_t *stream){
+
+	stream->position = 0;
+	stream->state.predictor = 0;
+	stream->state.step_index = 0;
+}
+
+uint32_t MCP4822_adpcm_stream_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_ADPCM_Stream_t *stream = (MCP4822_ADPCM_Stream_t *)context;
+	uint16_t header = MCP4822_encode_frame(stream->handle, 0, stream->dac_channel);
+	uint32_t written = 0;
+
+	while(written < count){
+
+		if(stream->position >= stream->sample_count){
+			if(!stream->loop || stream->sample_count == 0){
+				break;
+			}
+			MCP4822_adpcm_stream_rewind(stream);
+		}
+
+		//Decode the block straight into frames, never past the end of the asset
+		uint32_t block = stream->sample_count - stream->position;
+		if(block > count - written){
+			block = count - written;
+		}
+
+		MCP4822_adpcm_decode_frames(&stream->state, stream->data, stream->position, &frames[written], block, stream->nibble_order, header);
+
+		stream->position += block;
+		written += block;
+	}
+
+	return written;
+}
+
+static inline uint8_t get_nibble(const uint8_t *data, uint32_t sample, MCP4822_ADPCM_NIBBLE_ORDER nibble_order){
+
+	uint8_t byte = data[sample >> 1];
+
+	//Samples alternate between the two halves of each byte
+	uint8_t high_half = ((sample & 1) == 0) ^ (nibble_order == MCP4822_ADPCM_LOW_NIBBLE_FIRST);
+
+	return high_half ? (byte >> MCP4822_ADPCM_NIBBLE_BITS) : (byte & LOW_HALF_BYTE_MASK);
+}
+
+static inline int16_t decode_nibble(MCP4822_ADPCM_State_t *state, uint8_t code){
+
+	int32_t step = adpcm_steps[state->step_index];
+
+	//diff = (code magnitude + 0.5) * step / 4, built from shifts
+	int32_t diff = step >> 3;
+	if(code & 4){
+		diff += step;
+	}
+	if(code & 2){
+		diff += step >> 1;
+	}
+	if(code & 1){
+		diff += step >> 2;
+	}
+
+	int32_t predictor = state->predictor + ((code & 8) ? -diff : diff);
+	if(predictor > INT16_MAX){
+		predictor = INT16_MAX;
+	}
+	else if(predictor < INT16_MIN){
+		predictor = INT16_MIN;
+	}
+
+	int32_t step_index = state->step_index + adpcm_index_steps[code];
+	if(step_index < 0){
+		step_index = 0;
+	}
+	else if(step_index > MCP4822_ADPCM_STEP_INDEX_MAX){
+		step_index = MCP4822_ADPCM_STEP_INDEX_MAX;
+	}
+
+	state->predictor = (int16_t)predictor;
+	state->step_index = (uint8_t)step_index;
+
+	return (int16_t)predictor;
+}
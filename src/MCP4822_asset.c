@@ -0,0 +1,379 @@
+/*
+ * MCP4822_asset.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "MCP4822_asset.h"
+
+/** G.711 mu-law bias added before the segment search */
+#define ULAW_BIAS					   0x84
+
+/**
+ * @brief Reads one little-endian 12-bit PCM sample
+ *
+ * @param payload - PCM12 payload
+ * @param index - sample index across all channels
+ *
+ * @return DAC value, 0 .. MCP4822_DAC_MAX
+ */
+static inline uint16_t read_pcm12(const uint8_t *payload, uint32_t index);
+
+/**
+ * @brief Expands one G.711 mu-law byte to a signed 16-bit sample
+ *
+ * @param code - mu-law byte
+ *
+ * @return Signed PCM sample
+ */
+static inline int16_t read_ulaw(uint8_t code);
+
+/**
+ * @brief Length of the next contiguous run of samples, handling loop wrap
+ *
+ * Wraps to the loop start at the loop end and captures the ADPCM state at the
+ * loop start on the first pass, so callers only decode straight runs.
+ *
+ * @param player - player to be advanced
+ * @param max_samples - largest run wanted
+ *
+ * @return Run length, 0 at the end of a non-looping asset
+ */
+static uint32_t next_run(MCP4822_Asset_Player_t *player, uint32_t max_samples);
+
+/**
+ * @brief ADPCM nibble order of an asset
+ *
+ * @param header - asset header
+ *
+ * @return Nibble order from the asset flags
+ */
+static inline MCP4822_ADPCM_NIBBLE_ORDER asset_nibble_order(const MCP4822_Asset_Header_t *header);
+
+/**
+ * @brief Moves playback back to the loop start, restoring the decoder state captured there
+ *
+ * @param player - player to be moved
+ *
+ * @return None
+ */
+static void jump_to_loop_start(MCP4822_Asset_Player_t *player);
+
+/**
+ * @brief Rebuilds the ADPCM decoder state in front of a sample
+ *
+ * Starts from the nearest seek table snapshot at or before the sample, or
+ * from the beginning when the asset has no table.
+ *
+ * @param asset - ADPCM asset
+ * @param sample - sample whose preceding state is wanted
+ * @param state - filled with the decoder state
+ *
+ * @return None
+ */
+static void restore_adpcm_state(const MCP4822_Asset_t *asset, uint32_t sample, MCP4822_ADPCM_State_t *state);
+
+MCP4822_STATUS MCP4822_asset_load(const void *image, uint32_t image_size, MCP4822_Asset_t *asset){
+
+	//The header is read in place, so it must be word aligned
+	if(image == NULL || asset == NULL || ((uintptr_t)image & 3) != 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	const MCP4822_Asset_Header_t *header = (const MCP4822_Asset_Header_t *)image;
+
+	if(image_size != 0 && image_size < sizeof(MCP4822_Asset_Header_t)){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	if(header->magic != MCP4822_ASSET_MAGIC || header->version != MCP4822_ASSET_VERSION ||
+	   header->header_size < sizeof(MCP4822_Asset_Header_t)){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	//ADPCM keeps a single predictor, so it can only carry one channel
+	if(header->layout != MCP4822_LAYOUT_MONO && header->layout != MCP4822_LAYOUT_STEREO){
+		return MCP4822_ERROR_FORMAT;
+	}
+	if(header->codec == MCP4822_CODEC_IMA_ADPCM && header->layout != MCP4822_LAYOUT_MONO){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	if(header->sample_rate == 0 || header->sample_count == 0){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	//The payload length follows from the header alone, so it is never scanned
+	uint32_t payload_size = MCP4822_asset_payload_size((MCP4822_ASSET_CODEC)header->codec, (MCP4822_ASSET_LAYOUT)header->layout,
+													   header->sample_count);
+	if(payload_size == 0 || header->payload_size != payload_size){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	if(image_size != 0 && (uint64_t)header->header_size + header->payload_size > image_size){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	if(header->loop_start > header->loop_end || header->loop_end > header->sample_count){
+		return MCP4822_ERROR_FORMAT;
+	}
+	if((header->flags & MCP4822_ASSET_FLAG_LOOP) && header->loop_start == header->loop_end){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	//The table must fit in front of the payload, entries are only range checked when used
+	asset->seek_table = NULL;
+	if(header->flags & MCP4822_ASSET_FLAG_SEEK_TABLE){
+		if(header->codec != MCP4822_CODEC_IMA_ADPCM || header->seek_interval == 0){
+			return MCP4822_ERROR_FORMAT;
+		}
+
+		uint64_t table_size = (uint64_t)MCP4822_asset_seek_entries(header->sample_count, header->seek_interval) * sizeof(MCP4822_Asset_Seek_t);
+		if(header->header_size < sizeof(MCP4822_Asset_Header_t) + table_size){
+			return MCP4822_ERROR_FORMAT;
+		}
+		asset->seek_table = (const MCP4822_Asset_Seek_t *)((const uint8_t *)image + sizeof(MCP4822_Asset_Header_t));
+	}
+
+	asset->header = header;
+	asset->payload = (const uint8_t *)image + header->header_size;
+
+	return MCP4822_OK;
+}
+
+uint32_t MCP4822_asset_payload_size(MCP4822_ASSET_CODEC codec, MCP4822_ASSET_LAYOUT layout, uint32_t sample_count){
+
+	//Worked out in 64 bits, a size that wrapped would let a short payload pass the header check
+	uint64_t samples = (uint64_t)sample_count * (uint32_t)layout;
+	uint64_t size;
+
+	switch(codec){
+		case MCP4822_CODEC_PCM12:
+			size = samples * sizeof(uint16_t);
+			break;
+
+		case MCP4822_CODEC_IMA_ADPCM:
+			size = (samples + 1) / 2;
+			break;
+
+		case MCP4822_CODEC_ULAW:
+			size = samples;
+			break;
+
+		default:
+			return 0;
+	}
+
+	return (size > UINT32_MAX) ? 0 : (uint32_t)size;
+}
+
+void MCP4822_asset_player_init(MCP4822_Asset_Player_t *player, MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel,
+							   const MCP4822_Asset_t *asset){
+
+	player->handle = handle;
+	player->dac_channel = dac_channel;
+	player->asset = *asset;
+	player->looping = (asset->header->flags & MCP4822_ASSET_FLAG_LOOP) ? 1 : 0;
+
+	MCP4822_asset_player_rewind(player);
+}
+
+void MCP4822_asset_player_rewind(MCP4822_Asset_Player_t *player){
+
+	player->position = 0;
+	player->state.predictor = 0;
+	player->state.step_index = 0;
+	player->loop_state_valid = 0;
+}
+
+MCP4822_STATUS MCP4822_asset_player_seek(MCP4822_Asset_Player_t *player, uint32_t sample){
+
+	const MCP4822_Asset_Header_t *header = player->asset.header;
+
+	if(sample > header->sample_count){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	player->position = sample;
+
+	if(header->codec == MCP4822_CODEC_IMA_ADPCM){
+		restore_adpcm_state(&player->asset, sample, &player->state);
+
+		//A seek past the loop start skips the pass that would have captured its state
+		if(player->looping && sample > header->loop_start && !player->loop_state_valid){
+			restore_adpcm_state(&player->asset, header->loop_start, &player->loop_state);
+			player->loop_state_valid = 1;
+		}
+	}
+
+	return MCP4822_OK;
+}
+
+uint32_t MCP4822_asset_player_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_Asset_Player_t *player = (MCP4822_Asset_Player_t *)context;
+	const MCP4822_Asset_Header_t *header = player->asset.header;
+	const uint8_t *payload = player->asset.payload;
+
+	uint32_t channels = header->layout;
+	uint32_t written = 0;
+
+	//Stereo frames always go out as whole A/B pairs
+	uint32_t samples_wanted = count / channels;
+	uint32_t samples_done = 0;
+	uint32_t block;
+
+	while(samples_done < samples_wanted && (block = next_run(player, samples_wanted - samples_done)) != 0){
+
+		if(header->codec == MCP4822_CODEC_IMA_ADPCM){
+			uint16_t chan_header = MCP4822_encode_frame(player->handle, 0, player->dac_channel);
+
+			MCP4822_adpcm_decode_frames(&player->state, payload, player->position, &frames[written], block, asset_nibble_order(header), chan_header);
+			written += block;
+		}
+		else if(header->codec == MCP4822_CODEC_ULAW){
+			const uint8_t *codes = &payload[player->position * channels];
+			for(uint32_t i = 0; i < block * channels; i++){
+				MCP4822_DAC_SELECT chan = (channels == MCP4822_LAYOUT_STEREO) ? (MCP4822_DAC_SELECT)(i & 1) : player->dac_channel;
+				frames[written++] = MCP4822_encode_frame(player->handle, MCP4822_pcm_to_DAC_units(read_ulaw(codes[i])), chan);
+			}
+		}
+		else if(channels == MCP4822_LAYOUT_STEREO){
+			for(uint32_t i = 0; i < block; i++){
+				uint32_t index = (player->position + i) * 2;
+				frames[written++] = MCP4822_encode_frame(player->handle, read_pcm12(payload, index), MCP4822_CHANNEL_A);
+				frames[written++] = MCP4822_encode_frame(player->handle, read_pcm12(payload, index + 1), MCP4822_CHANNEL_B);
+			}
+		}
+		else{
+			for(uint32_t i = 0; i < block; i++){
+				frames[written++] = MCP4822_encode_frame(player->handle, read_pcm12(payload, player->position + i), player->dac_channel);
+			}
+		}
+
+		player->position += block;
+		samples_done += block;
+	}
+
+	return written;
+}
+
+uint32_t MCP4822_asset_player_read(void *context, int16_t *samples, uint32_t count){
+
+	MCP4822_Asset_Player_t *player = (MCP4822_Asset_Player_t *)context;
+	const MCP4822_Asset_Header_t *header = player->asset.header;
+	const uint8_t *payload = player->asset.payload;
+
+	uint32_t channels = header->layout;
+	uint32_t done = 0;
+	uint32_t block;
+
+	while(done < count && (block = next_run(player, count - done)) != 0){
+
+		if(header->codec == MCP4822_CODEC_IMA_ADPCM){
+			MCP4822_adpcm_decode(&player->state, payload, player->position, &samples[done], block, asset_nibble_order(header));
+		}
+		else{
+			//Stereo is averaged, 12-bit codes are centred and scaled up to 16 bits
+			for(uint32_t i = 0; i < block; i++){
+				uint32_t index = (player->position + i) * channels;
+				int32_t sum = 0;
+
+				for(uint32_t c = 0; c < channels; c++){
+					sum += (header->codec == MCP4822_CODEC_ULAW) ? read_ulaw(payload[index + c]) :
+						   ((int32_t)read_pcm12(payload, index + c) << (16 - MCP4822_RES)) - 32768;
+				}
+				samples[done + i] = (int16_t)(sum / (int32_t)channels);
+			}
+		}
+
+		player->position += block;
+		done += block;
+	}
+
+	return done;
+}
+
+static uint32_t next_run(MCP4822_Asset_Player_t *player, uint32_t max_samples){
+
+	const MCP4822_Asset_Header_t *header = player->asset.header;
+	uint32_t end = player->looping ? header->loop_end : header->sample_count;
+
+	if(player->position >= end){
+		if(!player->looping){
+			return 0;
+		}
+		jump_to_loop_start(player);
+	}
+
+	//The decoder state at the loop start is captured on the first pass
+	if(!player->loop_state_valid && player->position == header->loop_start){
+		player->loop_state = player->state;
+		player->loop_state_valid = 1;
+	}
+
+	uint32_t run = end - player->position;
+	if(!player->loop_state_valid && player->position < header->loop_start && header->loop_start - player->position < run){
+		run = header->loop_start - player->position;
+	}
+
+	return (run > max_samples) ? max_samples : run;
+}
+
+static inline MCP4822_ADPCM_NIBBLE_ORDER asset_nibble_order(const MCP4822_Asset_Header_t *header){
+
+	return (header->flags & MCP4822_ASSET_FLAG_LOW_NIBBLE) ? MCP4822_ADPCM_LOW_NIBBLE_FIRST : MCP4822_ADPCM_HIGH_NIBBLE_FIRST;
+}
+
+static inline uint16_t read_pcm12(const uint8_t *payload, uint32_t index){
+
+	//Byte reads keep this safe for unaligned payloads
+	return (uint16_t)(payload[index * 2] | (payload[index * 2 + 1] << SHIFT_8)) & MCP4822_FRAME_DATA_MASK;
+}
+
+static inline int16_t read_ulaw(uint8_t code){
+
+	//Codes are stored inverted, then rebuilt from a 3-bit exponent and 4-bit mantissa
+	code = ~code;
+	int32_t magnitude = ((((int32_t)code & LOW_HALF_BYTE_MASK) << 3) + ULAW_BIAS) << ((code >> SHIFT_4) & 0x07);
+	magnitude -= ULAW_BIAS;
+
+	return (int16_t)((code & 0x80) ? -magnitude : magnitude);
+}
+
+static void restore_adpcm_state(const MCP4822_Asset_t *asset, uint32_t sample, MCP4822_ADPCM_State_t *state){
+
+	const MCP4822_Asset_Header_t *header = asset->header;
+	uint32_t start = 0;
+
+	state->predictor = 0;
+	state->step_index = 0;
+
+	if(asset->seek_table != NULL){
+		uint32_t block = sample / header->seek_interval;
+		uint32_t entries = MCP4822_asset_seek_entries(header->sample_count, header->seek_interval);
+
+		//A seek to the very end of a whole number of blocks resumes from the last entry
+		if(block >= entries){
+			block = entries - 1;
+		}
+
+		const MCP4822_Asset_Seek_t *snapshot = &asset->seek_table[block];
+		start = block * header->seek_interval;
+		state->predictor = snapshot->predictor;
+		state->step_index = (snapshot->step_index > MCP4822_ADPCM_STEP_INDEX_MAX) ? MCP4822_ADPCM_STEP_INDEX_MAX : snapshot->step_index;
+	}
+
+	MCP4822_adpcm_skip(state, asset->payload, start, sample - start, asset_nibble_order(header));
+}
+
+static void jump_to_loop_start(MCP4822_Asset_Player_t *player){
+
+	const MCP4822_Asset_Header_t *header = player->asset.header;
+
+	//The loop start is always passed before the loop end, so its state is known here
+	player->position = header->loop_start;
+	if(player->loop_state_valid){
+		player->state = player->loop_state;
+	}
+}
@@ -0,0 +1,268 @@
+/*
+ * MCP4822_async.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "MCP4822_async.h"
+#include "MCP4822_cal.h"
+#include "MCP4822_stats.h"
+#include "MCP4822_dispatch.h"
+
+/**
+ * @brief Copies the frames of one request into the queue and kicks the transmitter if idle
+ *
+ * @param async - write queue
+ * @param frames - encoded frames of the request
+ * @param count - number of frames in the request
+ * @param callback - completion callback, may be NULL
+ * @param context - user pointer passed to the callback
+ *
+ * @return MCP4822_OK if queued, MCP4822_ERROR_BUSY if the queue has no room for the whole request
+ */
+static MCP4822_STATUS enqueue_request(MCP4822_Async_t *async, const uint16_t *frames, uint32_t count,
+									  MCP4822_Async_Cb callback, void *context);
+
+/**
+ * @brief Starts the frame at the queue tail, or marks the queue idle when empty
+ *
+ * @param async - write queue
+ *
+ * @return None
+ */
+static void start_next_frame(MCP4822_Async_t *async);
+
+/**
+ * @brief Retires the frame at the queue tail and completes its request if it was the last frame
+ *
+ * @param async - write queue
+ * @param status - transfer result of the frame
+ *
+ * @return None
+ */
+static void finish_frame(MCP4822_Async_t *async, MCP4822_STATUS status);
+
+MCP4822_STATUS MCP4822_async_init(MCP4822_Handle_t *handle, MCP4822_Async_t *async){
+
+	MCP4822_Async_t *current = handle->async;
+
+	//Frames in flight still need their completion interrupts
+	if(current != NULL && current->head != current->tail){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	if(async == NULL){
+		MCP4822_dispatch_release(handle->hspi, handle);
+		handle->async = NULL;
+		return MCP4822_OK;
+	}
+
+	if(MCP4822_dispatch_claim(handle->hspi, MCP4822_DISPATCH_ASYNC, handle) != MCP4822_OK){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	async->handle = handle;
+	async->head = 0;
+	async->tail = 0;
+	async->busy = 0;
+	async->request_status = MCP4822_OK;
+	async->tx_frame = 0;
+
+	handle->async = async;
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_write_to_chan_async(MCP4822_Handle_t *handle, uint16_t value, MCP4822_DAC_SELECT dac_channel,
+										   MCP4822_Async_Cb callback, void *context){
+
+	//Limit value to the max input for MCP4822
+	if(value > MCP4822_DAC_MAX || handle->async == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint16_t frame = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, dac_channel, value), dac_channel);
+
+	return enqueue_request(handle->async, &frame, 1, callback, context);
+}
+
+MCP4822_STATUS MCP4822_write_to_both_chans_async(MCP4822_Handle_t *handle, uint16_t value, MCP4822_Async_Cb callback, void *context){
+
+	//Limit value to the max input for MCP4822
+	if(value > MCP4822_DAC_MAX || handle->async == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Both frames form one request so they are latched and reported together
+	uint16_t frames[2];
+	frames[0] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_A, value), MCP4822_CHANNEL_A);
+	frames[1] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_B, value), MCP4822_CHANNEL_B);
+
+	return enqueue_request(handle->async, frames, 2, callback, context);
+}
+
+MCP4822_STATUS MCP4822_write_volts_to_chan_async(MCP4822_Handle_t *handle, float volts, MCP4822_DAC_SELECT dac_channel,
+												 MCP4822_Async_Cb callback, void *context){
+
+	//Convert the voltage value to DAC units
+	uint16_t DAC_value = MCP4822_volts_to_chan_units(handle, volts, dac_channel);
+
+	return MCP4822_write_to_chan_async(handle, DAC_value, dac_channel, callback, context);
+}
+
+MCP4822_STATUS MCP4822_write_volts_to_both_chans_async(MCP4822_Handle_t *handle, float volts, MCP4822_Async_Cb callback, void *context){
+
+	if(handle->async == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Each channel converts with its own gain, the conversion already saturates to MCP4822_DAC_MAX
+	uint16_t A_value = MCP4822_volts_to_chan_units(handle, volts, MCP4822_CHANNEL_A);
+	uint16_t B_value = MCP4822_volts_to_chan_units(handle, volts, MCP4822_CHANNEL_B);
+
+	uint16_t frames[2];
+	frames[0] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_A, A_value), MCP4822_CHANNEL_A);
+	frames[1] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_B, B_value), MCP4822_CHANNEL_B);
+
+	return enqueue_request(handle->async, frames, 2, callback, context);
+}
+
+uint32_t MCP4822_async_pending(MCP4822_Handle_t *handle){
+
+	if(handle->async == NULL){
+		return 0;
+	}
+
+	return handle->async->head - handle->async->tail;
+}
+
+void MCP4822_async_tx_complete_handler(MCP4822_Handle_t *handle){
+
+	MCP4822_Async_t *async = handle->async;
+	if(async == NULL || !async->busy){
+		return;
+	}
+
+	if(handle->cs_mode == MCP4822_CS_SOFTWARE){
+		MCP4822_port_pin_write(handle->CS_Port, handle->CS_Pin, 1);
+	}
+
+	finish_frame(async, MCP4822_OK);
+	start_next_frame(async);
+}
+
+void MCP4822_async_error_handler(MCP4822_Handle_t *handle){
+
+	MCP4822_Async_t *async = handle->async;
+	if(async == NULL || !async->busy){
+		return;
+	}
+
+	if(handle->cs_mode == MCP4822_CS_SOFTWARE){
+		MCP4822_port_pin_write(handle->CS_Port, handle->CS_Pin, 1);
+	}
+
+	finish_frame(async, MCP4822_ERROR_SPI);
+	start_next_frame(async);
+}
+
+static MCP4822_STATUS enqueue_request(MCP4822_Async_t *async, const uint16_t *frames, uint32_t count,
+									  MCP4822_Async_Cb callback, void *context){
+
+	uint32_t start = MCP4822_stats_now();
+	uint32_t head = async->head;
+
+	//Refuse the request rather than splitting it across a full queue
+	if(MCP4822_ASYNC_QUEUE_LEN - (head - async->tail) < count){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	for(uint32_t i = 0; i < count; i++){
+		MCP4822_Async_Entry_t *entry = &async->entries[(head + i) & MCP4822_ASYNC_QUEUE_MASK];
+		entry->frame = frames[i];
+		entry->last = (i == count - 1);
+		entry->callback = callback;
+		entry->context = context;
+#ifdef MCP4822_ENABLE_STATS
+		entry->queued_at = start;
+#endif
+	}
+
+	//Queued frames bypass the blocking writes' redundancy check
+	MCP4822_note_frames(async->handle, frames, count);
+
+	//Publish the entries before the interrupt can see the new head
+	MCP4822_port_barrier();
+	async->head = head + count;
+
+	//Only start the transmitter from here when the interrupt chain has stopped
+	uint32_t primask = MCP4822_port_irq_save();
+	if(!async->busy){
+		async->busy = 1;
+		start_next_frame(async);
+	}
+	MCP4822_port_irq_restore(primask);
+
+	MCP4822_stats_record(async->handle, MCP4822_STATS_ASYNC_ENQUEUE, start);
+
+	return MCP4822_OK;
+}
+
+static void start_next_frame(MCP4822_Async_t *async){
+
+	MCP4822_Handle_t *handle = async->handle;
+
+	while(async->tail != async->head){
+
+		async->tx_frame = async->entries[async->tail & MCP4822_ASYNC_QUEUE_MASK].frame;
+
+		if(handle->cs_mode == MCP4822_CS_SOFTWARE){
+			MCP4822_port_pin_write(handle->CS_Port, handle->CS_Pin, 0);
+		}
+
+		if(MCP4822_port_spi_transmit_it(handle->hspi, &async->tx_frame, 1) == MCP4822_PORT_OK){
+			return;
+		}
+
+		//The frame never started, fail it and move on to the next one
+		if(handle->cs_mode == MCP4822_CS_SOFTWARE){
+			MCP4822_port_pin_write(handle->CS_Port, handle->CS_Pin, 1);
+		}
+
+		finish_frame(async, MCP4822_ERROR_SPI);
+	}
+
+	async->busy = 0;
+}
+
+static void finish_frame(MCP4822_Async_t *async, MCP4822_STATUS status){
+
+	MCP4822_Async_Entry_t *entry = &async->entries[async->tail & MCP4822_ASYNC_QUEUE_MASK];
+
+	//A request fails if any of its frames failed
+	if(status != MCP4822_OK){
+		async->request_status = status;
+		MCP4822_stats_error(async->handle, 0);
+	}
+
+	if(entry->last){
+
+#ifdef MCP4822_ENABLE_STATS
+		//Time from the request being queued until its last frame is done
+		MCP4822_stats_record(async->handle, MCP4822_STATS_ASYNC_COMPLETE, entry->queued_at);
+#endif
+
+		//Move the loaded input registers to the outputs together
+		if(async->request_status == MCP4822_OK){
+			MCP4822_pulse_ldac(async->handle);
+		}
+
+		if(entry->callback != NULL){
+			entry->callback(entry->context, async->request_status);
+		}
+
+		async->request_status = MCP4822_OK;
+	}
+
+	async->tail++;
+}
@@ -0,0 +1,118 @@
+/*
+ * MCP4822_bank.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "MCP4822_bank.h"
+
+MCP4822_STATUS MCP4822_bank_open(const void *image, uint32_t image_size, MCP4822_Bank_t *bank){
+
+	//Tables are read in place, so the image must be word aligned
+	if(image == NULL || bank == NULL || ((uintptr_t)image & 3) != 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	const MCP4822_Bank_Header_t *header = (const MCP4822_Bank_Header_t *)image;
+
+	if(image_size != 0 && image_size < sizeof(MCP4822_Bank_Header_t)){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	if(header->magic != MCP4822_BANK_MAGIC || header->version != MCP4822_BANK_VERSION ||
+	   header->header_size < sizeof(MCP4822_Bank_Header_t) || (header->header_size & 3) != 0){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	//A power of two slot count with at least one free slot keeps probing bounded
+	uint16_t slots = header->hash_slots;
+	if(slots == 0 || (slots & (slots - 1)) != 0 || slots <= header->asset_count){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	uint32_t tables_end = header->header_size + (uint32_t)header->asset_count * sizeof(MCP4822_Bank_Entry_t) +
+						  (uint32_t)slots * sizeof(uint16_t);
+	if(tables_end > header->total_size || (image_size != 0 && header->total_size > image_size)){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	bank->image = (const uint8_t *)image;
+	bank->header = header;
+	bank->entries = (const MCP4822_Bank_Entry_t *)(bank->image + header->header_size);
+	bank->slots = (const uint16_t *)&bank->entries[header->asset_count];
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_bank_get(const MCP4822_Bank_t *bank, uint16_t id, MCP4822_Asset_t *asset){
+
+	if(id >= bank->header->asset_count){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	const MCP4822_Bank_Entry_t *entry = &bank->entries[id];
+	if((uint64_t)entry->offset + entry->length > bank->header->total_size){
+		return MCP4822_ERROR_FORMAT;
+	}
+
+	return MCP4822_asset_load(bank->image + entry->offset, entry->length, asset);
+}
+
+MCP4822_STATUS MCP4822_bank_find(const MCP4822_Bank_t *bank, const char *name, uint16_t *id){
+
+	uint32_t hash = MCP4822_bank_hash(name);
+	uint16_t slots = bank->header->hash_slots;
+	uint16_t mask = slots - 1;
+	uint16_t slot = hash & mask;
+
+	//Linear probing ends at the first empty slot, or after every slot of a corrupt table that has none
+	for(uint32_t probe = 0; probe < slots && bank->slots[slot] != MCP4822_BANK_SLOT_EMPTY; probe++, slot = (slot + 1) & mask){
+
+		uint16_t candidate = bank->slots[slot];
+		if(candidate >= bank->header->asset_count){
+			return MCP4822_ERROR_INVALID_ARG;
+		}
+
+		//The full name is only compared when the hashes agree
+		const char *stored = MCP4822_bank_name(bank, candidate);
+		if(bank->entries[candidate].name_hash == hash && stored != NULL && strcmp(stored, name) == 0){
+			*id = candidate;
+			return MCP4822_OK;
+		}
+	}
+
+	return MCP4822_ERROR_INVALID_ARG;
+}
+
+MCP4822_STATUS MCP4822_bank_get_by_name(const MCP4822_Bank_t *bank, const char *name, MCP4822_Asset_t *asset){
+
+	uint16_t id;
+	MCP4822_STATUS status = MCP4822_bank_find(bank, name, &id);
+	if(status != MCP4822_OK){
+		return status;
+	}
+
+	return MCP4822_bank_get(bank, id, asset);
+}
+
+const char *MCP4822_bank_name(const MCP4822_Bank_t *bank, uint16_t id){
+
+	if(id >= bank->header->asset_count || bank->entries[id].name_offset >= bank->header->total_size){
+		return NULL;
+	}
+
+	return (const char *)(bank->image + bank->entries[id].name_offset);
+}
+
+uint32_t MCP4822_bank_hash(const char *name){
+
+	uint32_t hash = MCP4822_FNV_OFFSET_BASIS;
+
+	while(*name){
+		hash ^= (uint8_t)*name++;
+		hash *= MCP4822_FNV_PRIME;
+	}
+
+	return hash;
+}
@@ -0,0 +1,202 @@
+/*
+ * MCP4822_block.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "MCP4822_block.h"
+#include "MCP4822_cal.h"
+
+#if defined(MCP4822_BLOCK_KERNEL_MVE)
+#include <arm_mve.h>
+#elif defined(MCP4822_BLOCK_KERNEL_AVX2)
+#include <immintrin.h>
+#elif defined(MCP4822_BLOCK_KERNEL_SSE2)
+#include <emmintrin.h>
+#endif
+
+/** Largest code as a float, inputs are clamped to 0 .. this before conversion */
+#define BLOCK_CODE_MAX				   ((float)MCP4822_DAC_MAX)
+
+/**
+ * @brief Computes frames[i] = header | clamp(src[i] * scale + offset), truncated toward zero
+ *
+ * The offset carries the +0.5 rounding term so truncation yields round-half-up.
+ *
+ * @param src - input samples
+ * @param frames - output frames
+ * @param count - number of samples
+ * @param scale - codes per input unit
+ * @param offset - code offset including rounding
+ * @param header - channel header word
+ *
+ * @return None
+ */
+static void convert_block(const float *src, uint16_t *frames, uint32_t count, float scale, float offset, uint16_t header);
+
+/**
+ * @brief Portable conversion of one sample, also used for kernel tails
+ *
+ * @param sample - input sample
+ * @param scale - codes per input unit
+ * @param offset - code offset including rounding
+ * @param header - channel header word
+ *
+ * @return Encoded frame
+ */
+static inline uint16_t convert_sample(float sample, float scale, float offset, uint16_t header);
+
+void MCP4822_volts_to_frames(MCP4822_Handle_t *handle, const float *volts, uint16_t *frames, uint32_t count, MCP4822_DAC_SELECT dac_channel){
+
+	//The gain only changes the codes per volt, pick it once for the whole block
+	float scale = MCP4822_chan_volt_scale(handle, dac_channel);
+	uint16_t header = MCP4822_encode_frame(handle, 0, dac_channel);
+
+	convert_block(volts, frames, count, scale, 0.5f, header);
+
+	//Correction works on whole codes, so it runs as an integer pass after the float kernel, with the gain the header carries
+	if(handle->cal != NULL){
+		MCP4822_cal_apply_frames(handle->cal, dac_channel, (MCP4822_OUTPUT_GAIN)((header >> MCP4822_FRAME_GAIN_POS) & FIRST_BIT_MASK), frames, count);
+	}
+}
+
+void MCP4822_normalized_to_frames(MCP4822_Handle_t *handle, const float *samples, uint16_t *frames, uint32_t count, MCP4822_DAC_SELECT dac_channel){
+
+	uint16_t header = MCP4822_encode_frame(handle, 0, dac_channel);
+
+	convert_block(samples, frames, count, MCP4822_NORMALIZED_SCALE, MCP4822_NORMALIZED_OFFSET + 0.5f, header);
+
+	if(handle->cal != NULL){
+		MCP4822_cal_apply_frames(handle->cal, dac_channel, (MCP4822_OUTPUT_GAIN)((header >> MCP4822_FRAME_GAIN_POS) & FIRST_BIT_MASK), frames, count);
+	}
+}
+
+const char *MCP4822_block_kernel_name(void){
+
+#if defined(MCP4822_BLOCK_KERNEL_MVE)
+	return "mve";
+#elif defined(MCP4822_BLOCK_KERNEL_DSP)
+	return "dsp";
+#elif defined(MCP4822_BLOCK_KERNEL_AVX2)
+	return "avx2";
+#elif defined(MCP4822_BLOCK_KERNEL_SSE2)
+	return "sse2";
+#else
+	return "scalar";
+#endif
+}
+
+static inline uint16_t convert_sample(float sample, float scale, float offset, uint16_t header){
+
+	float code = sample * scale + offset;
+
+	//Saturate instead of wrapping, NaN ends up at 0
+	if(!(code > 0.0f)){
+		code = 0.0f;
+	}
+	else if(code > BLOCK_CODE_MAX){
+		code = BLOCK_CODE_MAX;
+	}
+
+	return header | (uint16_t)code;
+}
+
+#if defined(MCP4822_BLOCK_KERNEL_MVE)
+static void convert_block(const float *src, uint16_t *frames, uint32_t count, float scale, float offset, uint16_t header){
+
+	uint32_t i = 0;
+
+	//Four samples per beat, the unsigned conversion saturates negatives and NaN to 0
+	for(; i + 4 <= count; i += 4){
+		//Separate multiply and add round like the scalar kernel, a fused one could land on the other code
+		float32x4_t code = vaddq_n_f32(vmulq_n_f32(vld1q_f32(&src[i]), scale), offset);
+		uint32x4_t value = vminq_u32(vcvtq_u32_f32(code), vdupq_n_u32(MCP4822_DAC_MAX));
+		vstrhq_u32(&frames[i], vorrq_u32(value, vdupq_n_u32(header)));
+	}
+
+	for(; i < count; i++){
+		frames[i] = convert_sample(src[i], scale, offset, header);
+	}
+}
+#elif defined(MCP4822_BLOCK_KERNEL_DSP)
+static void convert_block(const float *src, uint16_t *frames, uint32_t count, float scale, float offset, uint16_t header){
+
+	uint32_t i = 0;
+	uint32_t header_pair = ((uint32_t)header << 16) | header;
+
+	//Line the output up on a word so pairs can be stored with one access
+	if(((uintptr_t)frames & 2) && count > 0){
+		frames[0] = convert_sample(src[0], scale, offset, header);
+		i = 1;
+	}
+
+	//Two samples per iteration, the clamp keeps the cast (VCVT) in range and both frames go out as one word
+	for(; i + 2 <= count; i += 2){
+		uint32_t low = convert_sample(src[i], scale, offset, 0);
+		uint32_t high = convert_sample(src[i + 1], scale, offset, 0);
+		uint32_t pair = (low | (high << 16)) | header_pair;
+		memcpy(&frames[i], &pair, sizeof(pair));
+	}
+
+	for(; i < count; i++){
+		frames[i] = convert_sample(src[i], scale, offset, header);
+	}
+}
+#elif defined(MCP4822_BLOCK_KERNEL_AVX2)
+static void convert_block(const float *src, uint16_t *frames, uint32_t count, float scale, float offset, uint16_t header){
+
+	const __m256 scale_v = _mm256_set1_ps(scale);
+	const __m256 offset_v = _mm256_set1_ps(offset);
+	const __m256 zero_v = _mm256_setzero_ps();
+	const __m256 max_v = _mm256_set1_ps(BLOCK_CODE_MAX);
+	const __m128i header_v = _mm_set1_epi16((short)header);
+	uint32_t i = 0;
+
+	//Eight samples per iteration, max with the code first so NaN becomes 0
+	for(; i + 8 <= count; i += 8){
+		__m256 code = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(&src[i]), scale_v), offset_v);
+		code = _mm256_min_ps(_mm256_max_ps(code, zero_v), max_v);
+
+		__m256i value = _mm256_cvttps_epi32(code);
+		__m128i packed = _mm_packs_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1));
+		_mm_storeu_si128((__m128i *)&frames[i], _mm_or_si128(packed, header_v));
+	}
+
+	for(; i < count; i++){
+		frames[i] = convert_sample(src[i], scale, offset, header);
+	}
+}
+#elif defined(MCP4822_BLOCK_KERNEL_SSE2)
+static void convert_block(const float *src, uint16_t *frames, uint32_t count, float scale, float offset, uint16_t header){
+
+	const __m128 scale_v = _mm_set1_ps(scale);
+	const __m128 offset_v = _mm_set1_ps(offset);
+	const __m128 zero_v = _mm_setzero_ps();
+	const __m128 max_v = _mm_set1_ps(BLOCK_CODE_MAX);
+	const __m128i header_v = _mm_set1_epi16((short)header);
+	uint32_t i = 0;
+
+	//Eight samples per iteration as two vectors, max with the code first so NaN becomes 0
+	for(; i + 8 <= count; i += 8){
+		__m128 code_lo = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&src[i]), scale_v), offset_v);
+		__m128 code_hi = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&src[i + 4]), scale_v), offset_v);
+		code_lo = _mm_min_ps(_mm_max_ps(code_lo, zero_v), max_v);
+		code_hi = _mm_min_ps(_mm_max_ps(code_hi, zero_v), max_v);
+
+		__m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(code_lo), _mm_cvttps_epi32(code_hi));
+		_mm_storeu_si128((__m128i *)&frames[i], _mm_or_si128(packed, header_v));
+	}
+
+	for(; i < count; i++){
+		frames[i] = convert_sample(src[i], scale, offset, header);
+	}
+}
+#else
+static void convert_block(const float *src, uint16_t *frames, uint32_t count, float scale, float offset, uint16_t header){
+
+	for(uint32_t i = 0; i < count; i++){
+		frames[i] = convert_sample(src[i], scale, offset, header);
+	}
+}
+#endif
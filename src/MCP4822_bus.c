@@ -0,0 +1,295 @@
+/*
+ * MCP4822_bus.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include "MCP4822_bus.h"
+#include "MCP4822_cal.h"
+#include "MCP4822_stats.h"
+#include "MCP4822_dispatch.h"
+
+/** Bit 14 is ignored by the device, queued frames use it to mark that the same write continues */
+#define BUS_FRAME_CONTINUES			   (1U << 14)
+
+/**
+ * @brief Starts the next frame of the current turn, moving on to the next device with queued frames as turns end
+ *
+ * @param bus - bus
+ *
+ * @return None
+ */
+static void start_next_frame(MCP4822_Bus_t *bus);
+
+/**
+ * @brief Ends the current turn and picks the next device with queued frames, round-robin
+ *
+ * @param bus - bus
+ *
+ * @return 1 if a device was picked, 0 if every queue is empty
+ */
+static uint8_t next_turn(MCP4822_Bus_t *bus);
+
+/**
+ * @brief Retires the frame in flight on the current device
+ *
+ * @param bus - bus
+ * @param status - transfer result of the frame
+ *
+ * @return None
+ */
+static void finish_frame(MCP4822_Bus_t *bus, MCP4822_STATUS status);
+
+MCP4822_STATUS MCP4822_bus_init(MCP4822_Bus_t *bus, MCP4822_Spi_t *hspi, MCP4822_Bus_Device_t *devices, uint32_t device_count,
+								uint32_t quantum){
+
+	if(bus == NULL || hspi == NULL || devices == NULL || device_count == 0 || quantum == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	if(MCP4822_dispatch_claim(hspi, MCP4822_DISPATCH_BUS, bus) != MCP4822_OK){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	bus->hspi = hspi;
+	bus->devices = devices;
+	bus->device_count = device_count;
+	bus->quantum = quantum;
+	bus->current = 0;
+	bus->turn_left = 0;
+	bus->turn_sent = 0;
+	bus->busy = 0;
+	bus->tx_frame = 0;
+
+	for(uint32_t i = 0; i < device_count; i++){
+		devices[i].handle = NULL;
+		devices[i].queue = NULL;
+		devices[i].mask = 0;
+		devices[i].head = 0;
+		devices[i].tail = 0;
+		devices[i].sent = 0;
+		devices[i].errors = 0;
+	}
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_bus_deinit(MCP4822_Bus_t *bus){
+
+	if(bus->busy){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	MCP4822_dispatch_release(bus->hspi, bus);
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_bus_attach(MCP4822_Bus_t *bus, uint32_t device, MCP4822_Handle_t *handle, uint16_t *queue, uint32_t capacity){
+
+	if(device >= bus->device_count || handle == NULL || queue == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Every device shares the SPI, so each one must frame its words with its own CS pin
+	if(handle->hspi != bus->hspi || handle->cs_mode != MCP4822_CS_SOFTWARE){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	MCP4822_Bus_Device_t *dev = &bus->devices[device];
+	dev->queue = queue;
+	dev->mask = capacity - 1;
+	dev->head = 0;
+	dev->tail = 0;
+	dev->sent = 0;
+	dev->errors = 0;
+
+	//Publish the queue before the scheduler can see the device
+	MCP4822_port_barrier();
+	dev->handle = handle;
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_bus_write_frames(MCP4822_Bus_t *bus, uint32_t device, const uint16_t *frames, uint32_t count){
+
+	if(device >= bus->device_count || bus->devices[device].handle == NULL || frames == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint32_t start = MCP4822_stats_now();
+	MCP4822_Bus_Device_t *dev = &bus->devices[device];
+	uint32_t head = dev->head;
+
+	//A write longer than the queue could never fit, waiting for room would not help
+	if(count > dev->mask + 1){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Refuse the request rather than splitting it across a full queue
+	if((dev->mask + 1) - (head - dev->tail) < count){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	for(uint32_t i = 0; i < count; i++){
+		uint16_t frame = frames[i] & ~BUS_FRAME_CONTINUES;
+		dev->queue[(head + i) & dev->mask] = (i < count - 1) ? (frame | BUS_FRAME_CONTINUES) : frame;
+	}
+
+	//Bus frames bypass the blocking writes' redundancy check
+	MCP4822_note_frames(dev->handle, frames, count);
+
+	//Publish the frames before the interrupt can see the new head
+	MCP4822_port_barrier();
+	dev->head = head + count;
+
+	//Only start the transmitter from here when the interrupt chain has stopped
+	uint32_t primask = MCP4822_port_irq_save();
+	if(!bus->busy){
+		bus->busy = 1;
+		start_next_frame(bus);
+	}
+	MCP4822_port_irq_restore(primask);
+
+	MCP4822_stats_record(dev->handle, MCP4822_STATS_BUS_WRITE, start);
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_bus_write_to_chan(MCP4822_Bus_t *bus, uint32_t device, uint16_t value, MCP4822_DAC_SELECT dac_channel){
+
+	//Limit value to the max input for MCP4822
+	if(value > MCP4822_DAC_MAX || device >= bus->device_count || bus->devices[device].handle == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	MCP4822_Handle_t *handle = bus->devices[device].handle;
+	uint16_t frame = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, dac_channel, value), dac_channel);
+
+	return MCP4822_bus_write_frames(bus, device, &frame, 1);
+}
+
+MCP4822_STATUS MCP4822_bus_write_pair(MCP4822_Bus_t *bus, uint32_t device, uint16_t a_value, uint16_t b_value){
+
+	//Limit values to the max input for MCP4822
+	if(a_value > MCP4822_DAC_MAX || b_value > MCP4822_DAC_MAX || device >= bus->device_count || bus->devices[device].handle == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	MCP4822_Handle_t *handle = bus->devices[device].handle;
+	uint16_t frames[2];
+	frames[0] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_A, a_value), MCP4822_CHANNEL_A);
+	frames[1] = MCP4822_encode_frame(handle, MCP4822_calibrate(handle, MCP4822_CHANNEL_B, b_value), MCP4822_CHANNEL_B);
+
+	return MCP4822_bus_write_frames(bus, device, frames, 2);
+}
+
+uint32_t MCP4822_bus_pending(MCP4822_Bus_t *bus, uint32_t device){
+
+	if(device >= bus->device_count){
+		return 0;
+	}
+
+	return bus->devices[device].head - bus->devices[device].tail;
+}
+
+void MCP4822_bus_tx_complete_handler(MCP4822_Bus_t *bus){
+
+	if(!bus->busy){
+		return;
+	}
+
+	finish_frame(bus, MCP4822_OK);
+	start_next_frame(bus);
+}
+
+void MCP4822_bus_error_handler(MCP4822_Bus_t *bus){
+
+	if(!bus->busy){
+		return;
+	}
+
+	finish_frame(bus, MCP4822_ERROR_SPI);
+	start_next_frame(bus);
+}
+
+static void start_next_frame(MCP4822_Bus_t *bus){
+
+	while(bus->turn_left > 0 || next_turn(bus)){
+
+		MCP4822_Bus_Device_t *dev = &bus->devices[bus->current];
+
+		//The turn also ends early once the device runs out of frames
+		if(dev->tail == dev->head){
+			bus->turn_left = 0;
+			continue;
+		}
+
+		bus->tx_frame = dev->queue[dev->tail & dev->mask] & ~BUS_FRAME_CONTINUES;
+
+		MCP4822_port_pin_write(dev->handle->CS_Port, dev->handle->CS_Pin, 0);
+
+		if(MCP4822_port_spi_transmit_it(bus->hspi, &bus->tx_frame, 1) == MCP4822_PORT_OK){
+			return;
+		}
+
+		//The frame never started, drop it and move on to the next one
+		finish_frame(bus, MCP4822_ERROR_SPI);
+	}
+
+	bus->busy = 0;
+}
+
+static uint8_t next_turn(MCP4822_Bus_t *bus){
+
+	MCP4822_Bus_Device_t *dev = &bus->devices[bus->current];
+
+	//Latch what the finished turn loaded into the device
+	if(bus->turn_sent > 0){
+		MCP4822_pulse_ldac(dev->handle);
+		bus->turn_sent = 0;
+	}
+
+	//Search starts after the device just served, so it is the last one to get another turn
+	for(uint32_t i = 1; i <= bus->device_count; i++){
+
+		uint32_t candidate = bus->current + i;
+		if(candidate >= bus->device_count){
+			candidate -= bus->device_count;
+		}
+
+		dev = &bus->devices[candidate];
+		if(dev->handle != NULL && dev->tail != dev->head){
+			bus->current = candidate;
+			bus->turn_left = bus->quantum;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+static void finish_frame(MCP4822_Bus_t *bus, MCP4822_STATUS status){
+
+	MCP4822_Bus_Device_t *dev = &bus->devices[bus->current];
+	uint16_t queued = dev->queue[dev->tail & dev->mask];
+
+	MCP4822_port_pin_write(dev->handle->CS_Port, dev->handle->CS_Pin, 1);
+
+	if(status == MCP4822_OK){
+		dev->sent++;
+		bus->turn_sent++;
+	}
+	else{
+		dev->errors++;
+		MCP4822_stats_error(dev->handle, 0);
+	}
+
+	dev->tail++;
+
+	//A turn never ends inside a write, so the LDAC pulse only latches whole updates
+	if(bus->turn_left > 1 || !(queued & BUS_FRAME_CONTINUES)){
+		bus->turn_left--;
+	}
+}
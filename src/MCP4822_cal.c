@@ -0,0 +1,163 @@
+/*
+ * MCP4822_cal.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include "MCP4822_cal.h"
+
+/** Largest accepted gain correction, keeps code * gain_q16 within 32 bits */
+#define CAL_GAIN_MAX				   4.0f
+
+/**
+ * @brief Evaluates the measured transfer curve, interpolating between points and extrapolating past the ends
+ *
+ * @param codes - measured codes, strictly increasing
+ * @param volts - voltages measured for codes
+ * @param count - number of points
+ * @param segment - index of the segment used last, only moves forward
+ * @param code - code to evaluate, must not decrease between calls
+ *
+ * @return Output voltage for code
+ */
+static float curve_at(const uint16_t *codes, const float *volts, uint32_t count, uint32_t *segment, uint32_t code);
+
+void MCP4822_cal_init(MCP4822_Cal_t *cal){
+
+	for(uint32_t i = 0; i < 2; i++){
+		for(uint32_t gain = 0; gain < 2; gain++){
+			cal->chans[i][gain].gain_q16 = MCP4822_CAL_GAIN_UNITY;
+			cal->chans[i][gain].offset_q16 = 0;
+			cal->chans[i][gain].lut = NULL;
+		}
+	}
+}
+
+MCP4822_STATUS MCP4822_cal_fit(MCP4822_Cal_Chan_t *chan, const uint16_t *codes, const float *volts, uint32_t count, float codes_per_volt){
+
+	if(chan == NULL || codes == NULL || volts == NULL || count < 2 || codes_per_volt <= 0.0f){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Least squares line volts = slope * code + intercept over the measured points
+	float mean_code = 0.0f;
+	float mean_volts = 0.0f;
+	for(uint32_t i = 0; i < count; i++){
+		mean_code += codes[i];
+		mean_volts += volts[i];
+	}
+	mean_code /= (float)count;
+	mean_volts /= (float)count;
+
+	float sxx = 0.0f;
+	float sxy = 0.0f;
+	for(uint32_t i = 0; i < count; i++){
+		float dx = codes[i] - mean_code;
+		sxx += dx * dx;
+		sxy += dx * (volts[i] - mean_volts);
+	}
+
+	if(sxx <= 0.0f || sxy <= 0.0f){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	float slope = sxy / sxx;
+	float intercept = mean_volts - slope * mean_code;
+
+	//Sending (code / codes_per_volt - intercept) / slope produces the ideal voltage of code
+	float gain = 1.0f / (slope * codes_per_volt);
+	float offset = -intercept / slope;
+
+	if(gain >= CAL_GAIN_MAX || offset <= -(float)(MCP4822_DAC_MAX + 1) || offset >= (float)(MCP4822_DAC_MAX + 1)){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	chan->gain_q16 = (int32_t)(gain * MCP4822_CAL_GAIN_UNITY + 0.5f);
+	chan->offset_q16 = (int32_t)(offset * MCP4822_CAL_GAIN_UNITY + ((offset < 0.0f) ? -0.5f : 0.5f));
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_cal_build_lut(uint16_t *lut, const uint16_t *codes, const float *volts, uint32_t count, float codes_per_volt){
+
+	if(lut == NULL || codes == NULL || volts == NULL || count < 2 || codes_per_volt <= 0.0f){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	for(uint32_t i = 1; i < count; i++){
+		if(codes[i] <= codes[i - 1] || codes[i] > MCP4822_DAC_MAX || volts[i] < volts[i - 1]){
+			return MCP4822_ERROR_INVALID_ARG;
+		}
+	}
+
+	//Targets and the curve both rise, so one sweep over the sent codes inverts the curve
+	uint32_t segment = 0;
+	uint32_t sent = 0;
+	float volts_sent = curve_at(codes, volts, count, &segment, 0);
+	float volts_next = curve_at(codes, volts, count, &segment, 1);
+
+	for(uint32_t code = 0; code < MCP4822_CAL_LUT_SIZE; code++){
+
+		float target = (float)code / codes_per_volt;
+
+		while(sent < MCP4822_DAC_MAX && volts_next <= target){
+			sent++;
+			volts_sent = volts_next;
+			volts_next = (sent < MCP4822_DAC_MAX) ? curve_at(codes, volts, count, &segment, sent + 1) : volts_sent;
+		}
+
+		//Pick whichever neighbour lands closer to the target
+		if(sent < MCP4822_DAC_MAX && (volts_next - target) < (target - volts_sent)){
+			lut[code] = (uint16_t)(sent + 1);
+		}
+		else{
+			lut[code] = (uint16_t)sent;
+		}
+	}
+
+	return MCP4822_OK;
+}
+
+void MCP4822_cal_apply_frames(const MCP4822_Cal_t *cal, MCP4822_DAC_SELECT dac_channel, MCP4822_OUTPUT_GAIN gain, uint16_t *frames,
+							  uint32_t count){
+
+	const MCP4822_Cal_Chan_t *chan = &cal->chans[dac_channel & FIRST_BIT_MASK][gain & FIRST_BIT_MASK];
+
+	//Choosing the correction once keeps each loop free of branches besides the clamp
+	if(chan->lut != NULL){
+		const uint16_t *lut = chan->lut;
+
+		for(uint32_t i = 0; i < count; i++){
+			uint16_t frame = frames[i];
+			frames[i] = (frame & (uint16_t)~MCP4822_FRAME_DATA_MASK) | lut[frame & MCP4822_FRAME_DATA_MASK];
+		}
+		return;
+	}
+
+	int32_t gain_q16 = chan->gain_q16;
+	int32_t offset = chan->offset_q16 + (1 << 15);
+
+	for(uint32_t i = 0; i < count; i++){
+		uint16_t frame = frames[i];
+		int32_t corrected = ((int32_t)(frame & MCP4822_FRAME_DATA_MASK) * gain_q16 + offset) >> 16;
+
+		corrected = (corrected < 0) ? 0 : corrected;
+		corrected = (corrected > MCP4822_DAC_MAX) ? MCP4822_DAC_MAX : corrected;
+
+		frames[i] = (frame & (uint16_t)~MCP4822_FRAME_DATA_MASK) | (uint16_t)corrected;
+	}
+}
+
+static float curve_at(const uint16_t *codes, const float *volts, uint32_t count, uint32_t *segment, uint32_t code){
+
+	//Move to the segment containing code, the last segment also covers codes past the final point
+	while(*segment + 2 < count && code > codes[*segment + 1]){
+		(*segment)++;
+	}
+
+	uint32_t i = *segment;
+	float slope = (volts[i + 1] - volts[i]) / (float)(codes[i + 1] - codes[i]);
+
+	return volts[i] + slope * ((float)code - (float)codes[i]);
+}
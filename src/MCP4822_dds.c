@@ -0,0 +1,373 @@
+/*
+ * MCP4822_dds.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include "MCP4822_dds.h"
+
+/** Table entries never exceed 16 index bits, leaving MCP4822_DDS_FRAC_BITS for interpolation */
+#define DDS_TABLE_BITS_MAX			   16
+
+/** Phase bits kept by the arithmetic waveforms */
+#define DDS_TRIANGLE_SHIFT			   (32 - MCP4822_RES - 1)
+#define DDS_SAWTOOTH_SHIFT			   (32 - MCP4822_RES)
+
+/** Samples per channel rendered on the stack when interleaving A and B */
+#define DDS_CHUNK					   32
+
+/** DAC code at zero amplitude */
+#define DDS_MID_SCALE				   2048
+
+/** One cycle of round(32767 * sin(2 * pi * n / 1024)), kept at Q15 so the output is only rounded to 12 bits once */
+static const int16_t dds_sine_table[1 << MCP4822_DDS_SINE_BITS] =
+{
+	0, 201, 402, 603, 804, 1005, 1206, 1407, 1608, 1809, 2009, 2210, 2410, 2611, 2811, 3012,
+	3212, 3412, 3612, 3811, 4011, 4210, 4410, 4609, 4808, 5007, 5205, 5404, 5602, 5800, 5998, 6195,
+	6393, 6590, 6786, 6983, 7179, 7375, 7571, 7767, 7962, 8157, 8351, 8545, 8739, 8933, 9126, 9319,
+	9512, 9704, 9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605, 11793, 11980, 12167, 12353,
+	12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828, 14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269,
+	15446, 15623, 15800, 15976, 16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+	18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000, 20159, 20317, 20475, 20631,
+	20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856, 22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027,
+	23170, 23311, 23452, 23592, 23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+	25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674, 26790, 26905, 27019, 27133,
+	27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001, 28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803,
+	28898, 28992, 29085, 29177, 29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+	30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050, 31113, 31176, 31237, 31297,
+	31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736, 31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098,
+	32137, 32176, 32213, 32250, 32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+	32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752, 32757, 32761, 32765, 32766,
+	32767, 32766, 32765, 32761, 32757, 32752, 32745, 32737, 32728, 32717, 32705, 32692, 32678, 32663, 32646, 32628,
+	32609, 32589, 32567, 32545, 32521, 32495, 32469, 32441, 32412, 32382, 32351, 32318, 32285, 32250, 32213, 32176,
+	32137, 32098, 32057, 32014, 31971, 31926, 31880, 31833, 31785, 31736, 31685, 31633, 31580, 31526, 31470, 31414,
+	31356, 31297, 31237, 31176, 31113, 31050, 30985, 30919, 30852, 30783, 30714, 30643, 30571, 30498, 30424, 30349,
+	30273, 30195, 30117, 30037, 29956, 29874, 29791, 29706, 29621, 29534, 29447, 29358, 29268, 29177, 29085, 28992,
+	28898, 28803, 28706, 28609, 28510, 28411, 28310, 28208, 28105, 28001, 27896, 27790, 27683, 27575, 27466, 27356,
+	27245, 27133, 27019, 26905, 26790, 26674, 26556, 26438, 26319, 26198, 26077, 25955, 25832, 25708, 25582, 25456,
+	25329, 25201, 25072, 24942, 24811, 24680, 24547, 24413, 24279, 24143, 24007, 23870, 23731, 23592, 23452, 23311,
+	23170, 23027, 22884, 22739, 22594, 22448, 22301, 22154, 22005, 21856, 21705, 21554, 21403, 21250, 21096, 20942,
+	20787, 20631, 20475, 20317, 20159, 20000, 19841, 19680, 19519, 19357, 19195, 19032, 18868, 18703, 18537, 18371,
+	18204, 18037, 17869, 17700, 17530, 17360, 17189, 17018, 16846, 16673, 16499, 16325, 16151, 15976, 15800, 15623,
+	15446, 15269, 15090, 14912, 14732, 14553, 14372, 14191, 14010, 13828, 13645, 13462, 13279, 13094, 12910, 12725,
+	12539, 12353, 12167, 11980, 11793, 11605, 11417, 11228, 11039, 10849, 10659, 10469, 10278, 10087, 9896, 9704,
+	9512, 9319, 9126, 8933, 8739, 8545, 8351, 8157, 7962, 7767, 7571, 7375, 7179, 6983, 6786, 6590,
+	6393, 6195, 5998, 5800, 5602, 5404, 5205, 5007, 4808, 4609, 4410, 4210, 4011, 3811, 3612, 3412,
+	3212, 3012, 2811, 2611, 2410, 2210, 2009, 1809, 1608, 1407, 1206, 1005, 804, 603, 402, 201,
+	0, -201, -402, -603, -804, -1005, -1206, -1407, -1608, -1809, -2009, -2210, -2410, -2611, -2811, -3012,
+	-3212, -3412, -3612, -3811, -4011, -4210, -4410, -4609, -4808, -5007, -5205, -5404, -5602, -5800, -5998, -6195,
+	-6393, -6590, -6786, -6983, -7179, -7375, -7571, -7767, -7962, -8157, -8351, -8545, -8739, -8933, -9126, -9319,
+	-9512, -9704, -9896, -10087, -10278, -10469, -10659, -10849, -11039, -11228, -11417, -11605, -11793, -11980, -12167, -12353,
+	-12539, -12725, -12910, -13094, -13279, -13462, -13645, -13828, -14010, -14191, -14372, -14553, -14732, -14912, -15090, -15269,
+	-15446, -15623, -15800, -15976, -16151, -16325, -16499, -16673, -16846, -17018, -17189, -17360, -17530, -17700, -17869, -18037,
+	-18204, -18371, -18537, -18703, -18868, -19032, -19195, -19357, -19519, -19680, -19841, -20000, -20159, -20317, -20475, -20631,
+	-20787, -20942, -21096, -21250, -21403, -21554, -21705, -21856, -22005, -22154, -22301, -22448, -22594, -22739, -22884, -23027,
+	-23170, -23311, -23452, -23592, -23731, -23870, -24007, -24143, -24279, -24413, -24547, -24680, -24811, -24942, -25072, -25201,
+	-25329, -25456, -25582, -25708, -25832, -25955, -26077, -26198, -26319, -26438, -26556, -26674, -26790, -26905, -27019, -27133,
+	-27245, -27356, -27466, -27575, -27683, -27790, -27896, -28001, -28105, -28208, -28310, -28411, -28510, -28609, -28706, -28803,
+	-28898, -28992, -29085, -29177, -29268, -29358, -29447, -29534, -29621, -29706, -29791, -29874, -29956, -30037, -30117, -30195,
+	-30273, -30349, -30424, -30498, -30571, -30643, -30714, -30783, -30852, -30919, -30985, -31050, -31113, -31176, -31237, -31297,
+	-31356, -31414, -31470, -31526, -31580, -31633, -31685, -31736, -31785, -31833, -31880, -31926, -31971, -32014, -32057, -32098,
+	-32137, -32176, -32213, -32250, -32285, -32318, -32351, -32382, -32412, -32441, -32469, -32495, -32521, -32545, -32567, -32589,
+	-32609, -32628, -32646, -32663, -32678, -32692, -32705, -32717, -32728, -32737, -32745, -32752, -32757, -32761, -32765, -32766,
+	-32767, -32766, -32765, -32761, -32757, -32752, -32745, -32737, -32728, -32717, -32705, -32692, -32678, -32663, -32646, -32628,
+	-32609, -32589, -32567, -32545, -32521, -32495, -32469, -32441, -32412, -32382, -32351, -32318, -32285, -32250, -32213, -32176,
+	-32137, -32098, -32057, -32014, -31971, -31926, -31880, -31833, -31785, -31736, -31685, -31633, -31580, -31526, -31470, -31414,
+	-31356, -31297, -31237, -31176, -31113, -31050, -30985, -30919, -30852, -30783, -30714, -30643, -30571, -30498, -30424, -30349,
+	-30273, -30195, -30117, -30037, -29956, -29874, -29791, -29706, -29621, -29534, -29447, -29358, -29268, -29177, -29085, -28992,
+	-28898, -28803, -28706, -28609, -28510, -28411, -28310, -28208, -28105, -28001, -27896, -27790, -27683, -27575, -27466, -27356,
+	-27245, -27133, -27019, -26905, -26790, -26674, -26556, -26438, -26319, -26198, -26077, -25955, -25832, -25708, -25582, -25456,
+	-25329, -25201, -25072, -24942, -24811, -24680, -24547, -24413, -24279, -24143, -24007, -23870, -23731, -23592, -23452, -23311,
+	-23170, -23027, -22884, -22739, -22594, -22448, -22301, -22154, -22005, -21856, -21705, -21554, -21403, -21250, -21096, -20942,
+	-20787, -20631, -20475, -20317, -20159, -20000, -19841, -19680, -19519, -19357, -19195, -19032, -18868, -18703, -18537, -18371,
+	-18204, -18037, -17869, -17700, -17530, -17360, -17189, -17018, -16846, -16673, -16499, -16325, -16151, -15976, -15800, -15623,
+	-15446, -15269, -15090, -14912, -14732, -14553, -14372, -14191, -14010, -13828, -13645, -13462, -13279, -13094, -12910, -12725,
+	-12539, -12353, -12167, -11980, -11793, -11605, -11417, -11228, -11039, -10849, -10659, -10469, -10278, -10087, -9896, -9704,
+	-9512, -9319, -9126, -8933, -8739, -8545, -8351, -8157, -7962, -7767, -7571, -7375, -7179, -6983, -6786, -6590,
+	-6393, -6195, -5998, -5800, -5602, -5404, -5205, -5007, -4808, -4609, -4410, -4210, -4011, -3811, -3612, -3412,
+	-3212, -3012, -2811, -2611, -2410, -2210, -2009, -1809, -1608, -1407, -1206, -1005, -804, -603, -402, -201
+};
+
+/**
+ * @brief Renders 12-bit codes of one oscillator and advances its phase
+ *
+ * @param chan - oscillator
+ * @param codes - output codes, 0 .. MCP4822_DAC_MAX
+ * @param count - number of codes
+ *
+ * @return None
+ */
+static void render_codes(MCP4822_DDS_Chan_t *chan, uint16_t *codes, uint32_t count);
+
+/**
+ * @brief Tuning word for a frequency
+ *
+ * @param sample_rate - output sample rate in Hz
+ * @param millihertz - frequency in mHz
+ *
+ * @return Phase increment per sample, rounded to nearest
+ */
+static inline uint32_t tuning_word(uint32_t sample_rate, uint32_t millihertz);
+
+MCP4822_STATUS MCP4822_dds_init(MCP4822_DDS_t *dds, MCP4822_Handle_t *handle, uint32_t sample_rate){
+
+	if(dds == NULL || handle == NULL || sample_rate == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	dds->handle = handle;
+	dds->sample_rate = sample_rate;
+	dds->held = 0;
+	dds->held_frame = 0;
+
+	for(uint32_t i = 0; i < 2; i++){
+		MCP4822_DDS_Chan_t *chan = &dds->chans[i];
+		chan->phase = 0;
+		chan->tuning_word = 0;
+		chan->waveform = MCP4822_WAVE_SINE;
+		chan->table = NULL;
+		chan->table_bits = 0;
+		chan->amplitude = MCP4822_DDS_FULL_SCALE;
+		chan->enabled = 0;
+	}
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_dds_configure(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, MCP4822_WAVEFORM waveform,
+									 uint32_t millihertz, uint16_t amplitude){
+
+	if(waveform > MCP4822_WAVE_TABLE || amplitude > MCP4822_DDS_FULL_SCALE ||
+	   (waveform == MCP4822_WAVE_TABLE && dds->chans[dac_channel & 1].table == NULL)){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	MCP4822_STATUS status = MCP4822_dds_set_frequency(dds, dac_channel, millihertz);
+	if(status != MCP4822_OK){
+		return status;
+	}
+
+	MCP4822_DDS_Chan_t *chan = &dds->chans[dac_channel & 1];
+	chan->waveform = waveform;
+	chan->amplitude = amplitude;
+	chan->enabled = 1;
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_dds_set_frequency(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, uint32_t millihertz){
+
+	//Anything at or above Nyquist would alias
+	if((uint64_t)millihertz * 2 >= (uint64_t)dds->sample_rate * 1000){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	dds->chans[dac_channel & 1].tuning_word = tuning_word(dds->sample_rate, millihertz);
+
+	return MCP4822_OK;
+}
+
+void MCP4822_dds_set_phase(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, uint32_t phase){
+
+	dds->chans[dac_channel & 1].phase = phase;
+}
+
+MCP4822_STATUS MCP4822_dds_set_table(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, const uint16_t *table, uint8_t table_bits){
+
+	if(table == NULL || table_bits == 0 || table_bits > DDS_TABLE_BITS_MAX){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	MCP4822_DDS_Chan_t *chan = &dds->chans[dac_channel & 1];
+	chan->table = table;
+	chan->table_bits = table_bits;
+
+	return MCP4822_OK;
+}
+
+void MCP4822_dds_disable(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel){
+
+	dds->chans[dac_channel & 1].enabled = 0;
+}
+
+void MCP4822_dds_render(MCP4822_DDS_t *dds, MCP4822_DAC_SELECT dac_channel, uint16_t *frames, uint32_t count){
+
+	uint16_t header = MCP4822_encode_frame(dds->handle, 0, dac_channel);
+
+	//Codes are rendered in place, then the channel header is ORed in
+	render_codes(&dds->chans[dac_channel & 1], frames, count);
+	for(uint32_t i = 0; i < count; i++){
+		frames[i] |= header;
+	}
+}
+
+uint32_t MCP4822_dds_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_DDS_t *dds = (MCP4822_DDS_t *)context;
+	MCP4822_DDS_Chan_t *chan_a = &dds->chans[MCP4822_CHANNEL_A];
+	MCP4822_DDS_Chan_t *chan_b = &dds->chans[MCP4822_CHANNEL_B];
+
+	if(!(chan_a->enabled && chan_b->enabled)){
+
+		//A channel B frame held for a pair is dropped along with pair mode
+		dds->held = 0;
+		MCP4822_DAC_SELECT dac_channel = chan_b->enabled ? MCP4822_CHANNEL_B : MCP4822_CHANNEL_A;
+
+		//With nothing enabled the output rests at mid-scale
+		if(!dds->chans[dac_channel].enabled){
+			uint16_t idle = MCP4822_encode_frame(dds->handle, DDS_MID_SCALE, dac_channel);
+			for(uint32_t i = 0; i < count; i++){
+				frames[i] = idle;
+			}
+			return count;
+		}
+
+		MCP4822_dds_render(dds, dac_channel, frames, count);
+		return count;
+	}
+
+	//Both channels are rendered a chunk at a time and interleaved on the way out
+	uint16_t header_a = MCP4822_encode_frame(dds->handle, 0, MCP4822_CHANNEL_A);
+	uint16_t header_b = MCP4822_encode_frame(dds->handle, 0, MCP4822_CHANNEL_B);
+	uint16_t codes_a[DDS_CHUNK];
+	uint16_t codes_b[DDS_CHUNK];
+	uint32_t written = 0;
+
+	//Finish the pair split across the previous refill
+	if(dds->held && count > 0){
+		frames[written++] = dds->held_frame;
+		dds->held = 0;
+	}
+
+	uint32_t pairs = (count - written) / 2;
+
+	for(uint32_t done = 0; done < pairs; done += DDS_CHUNK){
+
+		uint32_t chunk = pairs - done;
+		if(chunk > DDS_CHUNK){
+			chunk = DDS_CHUNK;
+		}
+
+		render_codes(chan_a, codes_a, chunk);
+		render_codes(chan_b, codes_b, chunk);
+
+		uint16_t *out = &frames[written + done * 2];
+		for(uint32_t i = 0; i < chunk; i++){
+			out[2 * i] = header_a | codes_a[i];
+			out[2 * i + 1] = header_b | codes_b[i];
+		}
+	}
+	written += pairs * 2;
+
+	//An odd count leaves one slot: channel A goes out now and channel B opens the next refill
+	if(written < count){
+		render_codes(chan_a, codes_a, 1);
+		render_codes(chan_b, codes_b, 1);
+
+		frames[written++] = header_a | codes_a[0];
+		dds->held_frame = header_b | codes_b[0];
+		dds->held = 1;
+	}
+
+	return written;
+}
+
+uint32_t MCP4822_dds_read(void *context, int16_t *samples, uint32_t count){
+
+	MCP4822_DDS_Chan_t *chan = (MCP4822_DDS_Chan_t *)context;
+	uint16_t *codes = (uint16_t *)samples;
+
+	render_codes(chan, codes, count);
+	for(uint32_t i = 0; i < count; i++){
+		samples[i] = (int16_t)(((int32_t)codes[i] - DDS_MID_SCALE) << (16 - MCP4822_RES));
+	}
+
+	return count;
+}
+
+static void render_codes(MCP4822_DDS_Chan_t *chan, uint16_t *codes, uint32_t count){
+
+	uint32_t phase = chan->phase;
+	uint32_t step = chan->tuning_word;
+
+	switch(chan->waveform){
+		case MCP4822_WAVE_SINE:{
+			uint32_t index_shift = 32 - MCP4822_DDS_SINE_BITS;
+			uint32_t mask = (1UL << MCP4822_DDS_SINE_BITS) - 1;
+
+			//Amplitude is folded into the one rounding step from Q15 to DAC codes
+			int32_t gain = (int32_t)(((uint32_t)chan->amplitude * (DDS_MID_SCALE - 1) + (1 << 14)) >> 15);
+
+			for(uint32_t i = 0; i < count; i++){
+				uint32_t index = phase >> index_shift;
+				int32_t frac = (int32_t)((phase >> (index_shift - MCP4822_DDS_FRAC_BITS)) & 0xFFFF);
+				int32_t a = dds_sine_table[index];
+				int32_t b = dds_sine_table[(index + 1) & mask];
+				int32_t sine = a + (((b - a) * frac + (1 << (MCP4822_DDS_FRAC_BITS - 1))) >> MCP4822_DDS_FRAC_BITS);
+				codes[i] = (uint16_t)(DDS_MID_SCALE + ((sine * gain + (1 << 14)) >> 15));
+				phase += step;
+			}
+
+			chan->phase = phase;
+			return;
+		}
+
+		case MCP4822_WAVE_TABLE:{
+			const uint16_t *table = chan->table;
+			uint32_t index_shift = 32 - chan->table_bits;
+			uint32_t mask = (1UL << chan->table_bits) - 1;
+
+			//Top bits index the table, the next MCP4822_DDS_FRAC_BITS interpolate to the following entry
+			for(uint32_t i = 0; i < count; i++){
+				uint32_t index = phase >> index_shift;
+				int32_t frac = (int32_t)((phase >> (index_shift - MCP4822_DDS_FRAC_BITS)) & 0xFFFF);
+				int32_t a = table[index];
+				int32_t b = table[(index + 1) & mask];
+				codes[i] = (uint16_t)(a + (((b - a) * frac + (1 << (MCP4822_DDS_FRAC_BITS - 1))) >> MCP4822_DDS_FRAC_BITS));
+				phase += step;
+			}
+			break;
+		}
+
+		case MCP4822_WAVE_TRIANGLE:
+			for(uint32_t i = 0; i < count; i++){
+				uint32_t ramp = phase >> DDS_TRIANGLE_SHIFT;
+				codes[i] = (uint16_t)((ramp > MCP4822_DAC_MAX) ? (2 * MCP4822_DAC_MAX + 1 - ramp) : ramp);
+				phase += step;
+			}
+			break;
+
+		case MCP4822_WAVE_SAWTOOTH:
+			for(uint32_t i = 0; i < count; i++){
+				codes[i] = (uint16_t)(phase >> DDS_SAWTOOTH_SHIFT);
+				phase += step;
+			}
+			break;
+
+		case MCP4822_WAVE_SQUARE:
+		default:
+			for(uint32_t i = 0; i < count; i++){
+				codes[i] = (phase & 0x80000000UL) ? MCP4822_DAC_MAX : 0;
+				phase += step;
+			}
+			break;
+	}
+
+	chan->phase = phase;
+
+	//Scale around mid-scale, skipped at full scale
+	if(chan->amplitude != MCP4822_DDS_FULL_SCALE){
+		int32_t amplitude = chan->amplitude;
+		for(uint32_t i = 0; i < count; i++){
+			codes[i] = (uint16_t)(DDS_MID_SCALE + ((((int32_t)codes[i] - DDS_MID_SCALE) * amplitude) >> 15));
+		}
+	}
+}
+
+static inline uint32_t tuning_word(uint32_t sample_rate, uint32_t millihertz){
+
+	uint64_t denominator = (uint64_t)sample_rate * 1000;
+
+	return (uint32_t)((((uint64_t)millihertz << 32) + denominator / 2) / denominator);
+}
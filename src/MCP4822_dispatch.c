@@ -0,0 +1,184 @@
+/*
+ * MCP4822_dispatch.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include "MCP4822_dispatch.h"
+#include "MCP4822_async.h"
+#include "MCP4822_stream.h"
+#include "MCP4822_bus.h"
+
+/**
+ * @brief One owned SPI
+ */
+typedef struct
+{
+
+	MCP4822_Spi_t *spi;
+
+	MCP4822_DISPATCH_OWNER type;
+
+	void *owner;
+
+}Dispatch_Slot_t;
+
+static Dispatch_Slot_t slots[MCP4822_DISPATCH_SLOTS];
+
+/**
+ * @brief Finds the slot of an owned SPI
+ *
+ * @param spi - SPI peripheral
+ *
+ * @return Slot, NULL if the SPI has no owner
+ */
+static Dispatch_Slot_t *find_slot(const MCP4822_Spi_t *spi);
+
+MCP4822_STATUS MCP4822_dispatch_claim(MCP4822_Spi_t *spi, MCP4822_DISPATCH_OWNER type, void *owner){
+
+	MCP4822_STATUS status = MCP4822_ERROR_BUSY;
+
+	//Claims may race with releases from interrupts
+	uint32_t primask = MCP4822_port_irq_save();
+
+	Dispatch_Slot_t *slot = find_slot(spi);
+	if(slot != NULL){
+		if(slot->owner == owner && slot->type == type){
+			status = MCP4822_OK;
+		}
+	}
+	else{
+		for(uint32_t i = 0; i < MCP4822_DISPATCH_SLOTS; i++){
+			if(slots[i].spi == NULL){
+				slots[i].type = type;
+				slots[i].owner = owner;
+				slots[i].spi = spi;
+				status = MCP4822_OK;
+				break;
+			}
+		}
+	}
+
+	MCP4822_port_irq_restore(primask);
+
+	return status;
+}
+
+void MCP4822_dispatch_release(MCP4822_Spi_t *spi, const void *owner){
+
+	uint32_t primask = MCP4822_port_irq_save();
+
+	Dispatch_Slot_t *slot = find_slot(spi);
+	if(slot != NULL && slot->owner == owner){
+		slot->spi = NULL;
+		slot->type = MCP4822_DISPATCH_NONE;
+		slot->owner = NULL;
+	}
+
+	MCP4822_port_irq_restore(primask);
+}
+
+MCP4822_DISPATCH_OWNER MCP4822_dispatch_owner(const MCP4822_Spi_t *spi){
+
+	Dispatch_Slot_t *slot = find_slot(spi);
+
+	return (slot != NULL) ? slot->type : MCP4822_DISPATCH_NONE;
+}
+
+void MCP4822_dispatch_tx_complete(MCP4822_Spi_t *spi){
+
+	Dispatch_Slot_t *slot = find_slot(spi);
+	if(slot == NULL){
+		return;
+	}
+
+	switch(slot->type){
+		case MCP4822_DISPATCH_ASYNC:
+			MCP4822_async_tx_complete_handler((MCP4822_Handle_t *)slot->owner);
+			break;
+
+		case MCP4822_DISPATCH_STREAM:
+			//A pair-mode stream sends one pair per tick, the next tick latches it
+			if(((MCP4822_Stream_t *)slot->owner)->pair_mode){
+				MCP4822_stream_pair_complete_handler((MCP4822_Stream_t *)slot->owner, 1);
+			}
+			else{
+				MCP4822_stream_transfer_complete_handler((MCP4822_Stream_t *)slot->owner);
+			}
+			break;
+
+		case MCP4822_DISPATCH_BUS:
+			MCP4822_bus_tx_complete_handler((MCP4822_Bus_t *)slot->owner);
+			break;
+
+		default:
+			break;
+	}
+}
+
+void MCP4822_dispatch_tx_half_complete(MCP4822_Spi_t *spi){
+
+	Dispatch_Slot_t *slot = find_slot(spi);
+
+	//Only the circular stream transfer reports half transfers
+	if(slot != NULL && slot->type == MCP4822_DISPATCH_STREAM && !((MCP4822_Stream_t *)slot->owner)->pair_mode){
+		MCP4822_stream_half_transfer_handler((MCP4822_Stream_t *)slot->owner);
+	}
+}
+
+void MCP4822_dispatch_error(MCP4822_Spi_t *spi){
+
+	Dispatch_Slot_t *slot = find_slot(spi);
+	if(slot == NULL){
+		return;
+	}
+
+	switch(slot->type){
+		case MCP4822_DISPATCH_ASYNC:
+			MCP4822_async_error_handler((MCP4822_Handle_t *)slot->owner);
+			break;
+
+		case MCP4822_DISPATCH_STREAM:
+			//A failed pair reached the DAC only in part and is dropped rather than latched
+			if(((MCP4822_Stream_t *)slot->owner)->pair_mode){
+				MCP4822_stream_pair_complete_handler((MCP4822_Stream_t *)slot->owner, 0);
+			}
+			break;
+
+		case MCP4822_DISPATCH_BUS:
+			MCP4822_bus_error_handler((MCP4822_Bus_t *)slot->owner);
+			break;
+
+		default:
+			break;
+	}
+}
+
+#if defined(MCP4822_DISPATCH_HAL_CALLBACKS) && !defined(MCP4822_PORT_POSIX)
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi){
+
+	MCP4822_dispatch_tx_complete(hspi);
+}
+
+void HAL_SPI_TxHalfCpltCallback(SPI_HandleTypeDef *hspi){
+
+	MCP4822_dispatch_tx_half_complete(hspi);
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi){
+
+	MCP4822_dispatch_error(hspi);
+}
+#endif
+
+static Dispatch_Slot_t *find_slot(const MCP4822_Spi_t *spi){
+
+	for(uint32_t i = 0; i < MCP4822_DISPATCH_SLOTS; i++){
+		if(slots[i].spi == spi && spi != NULL){
+			return &slots[i];
+		}
+	}
+
+	return NULL;
+}
@@ -0,0 +1,115 @@
+/*
+ * MCP4822_fifo.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include "MCP4822_fifo.h"
+
+bool MCP4822_fifo_init(MCP4822_Fifo_t *fifo, uint16_t *buffer, uint32_t capacity){
+
+	//Free-running indices only wrap cleanly on a power of 2
+	if(buffer == NULL || capacity == 0 || (capacity & (capacity - 1)) != 0){
+		return false;
+	}
+
+	fifo->buffer = buffer;
+	fifo->mask = capacity - 1;
+	atomic_init(&fifo->head, 0);
+	atomic_init(&fifo->tail, 0);
+
+	//Watermarks stay disabled until configured
+	fifo->high_watermark = capacity;
+	fifo->low_watermark = 0;
+	fifo->high_callback = NULL;
+	fifo->low_callback = NULL;
+	fifo->context = NULL;
+
+	fifo->last_frame = 0;
+	fifo->underruns = 0;
+
+	return true;
+}
+
+void MCP4822_fifo_set_watermarks(MCP4822_Fifo_t *fifo, uint32_t high_watermark, MCP4822_Fifo_Watermark_Cb high_callback,
+								 uint32_t low_watermark, MCP4822_Fifo_Watermark_Cb low_callback, void *context){
+
+	fifo->high_watermark = high_watermark;
+	fifo->high_callback = high_callback;
+	fifo->low_watermark = low_watermark;
+	fifo->low_callback = low_callback;
+	fifo->context = context;
+}
+
+uint32_t MCP4822_fifo_push(MCP4822_Fifo_t *fifo, const uint16_t *frames, uint32_t count){
+
+	//Only the producer writes head, the consumer's tail is read once
+	uint32_t head = atomic_load_explicit(&fifo->head, memory_order_relaxed);
+	uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_acquire);
+	uint32_t level = head - tail;
+	uint32_t space = (fifo->mask + 1) - level;
+
+	if(count > space){
+		count = space;
+	}
+
+	for(uint32_t i = 0; i < count; i++){
+		fifo->buffer[(head + i) & fifo->mask] = frames[i];
+	}
+
+	//Release orders the frame stores before the consumer can observe the new head
+	atomic_store_explicit(&fifo->head, head + count, memory_order_release);
+
+	if(fifo->high_callback != NULL && level < fifo->high_watermark && level + count >= fifo->high_watermark){
+		fifo->high_callback(fifo->context, level + count);
+	}
+
+	return count;
+}
+
+uint32_t MCP4822_fifo_pop(MCP4822_Fifo_t *fifo, uint16_t *frames, uint32_t count){
+
+	//Only the consumer writes tail, the producer's head is read once
+	uint32_t tail = atomic_load_explicit(&fifo->tail, memory_order_relaxed);
+	uint32_t head = atomic_load_explicit(&fifo->head, memory_order_acquire);
+	uint32_t level = head - tail;
+
+	if(count > level){
+		count = level;
+	}
+
+	for(uint32_t i = 0; i < count; i++){
+		frames[i] = fifo->buffer[(tail + i) & fifo->mask];
+	}
+
+	//Release orders the frame loads before the producer may overwrite the slots
+	atomic_store_explicit(&fifo->tail, tail + count, memory_order_release);
+
+	if(fifo->low_callback != NULL && level > fifo->low_watermark && level - count <= fifo->low_watermark){
+		fifo->low_callback(fifo->context, level - count);
+	}
+
+	return count;
+}
+
+uint32_t MCP4822_fifo_stream_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_Fifo_t *fifo = (MCP4822_Fifo_t *)context;
+
+	uint32_t popped = MCP4822_fifo_pop(fifo, frames, count);
+	if(popped > 0){
+		fifo->last_frame = frames[popped - 1];
+	}
+
+	//Hold the output level through an underrun instead of ending the stream
+	if(popped < count){
+		fifo->underruns++;
+
+		for(uint32_t i = popped; i < count; i++){
+			frames[i] = fifo->last_frame;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,225 @@
+/*
+ * MCP4822_mixer.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include "MCP4822_mixer.h"
+
+/**
+ * @brief Packs the channel gains for a volume and pan
+ *
+ * The channel the voice is panned away from is attenuated linearly, the other
+ * stays at the full volume.
+ *
+ * @param volume - Q15 volume, 0 .. MCP4822_MIXER_UNITY
+ * @param pan - MCP4822_MIXER_PAN_A .. MCP4822_MIXER_PAN_B
+ *
+ * @return Channel B gain << 16 | channel A gain, both Q15
+ */
+static uint32_t pack_gains(uint16_t volume, int16_t pan);
+
+/**
+ * @brief Rounds a Q30 sum to a code, saturates it and encodes it as a frame
+ *
+ * @param sum - mixed Q30 sample
+ * @param header - channel header word
+ *
+ * @return Encoded frame
+ */
+static inline uint16_t mix_to_frame(int64_t sum, uint16_t header);
+
+MCP4822_STATUS MCP4822_mixer_init(MCP4822_Mixer_t *mixer, MCP4822_Handle_t *handle, MCP4822_Mixer_Voice_t *voices, uint32_t voice_count){
+
+	if(mixer == NULL || handle == NULL || voices == NULL || voice_count == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	mixer->handle = handle;
+	mixer->voices = voices;
+	mixer->voice_count = voice_count;
+	mixer->held = 0;
+	mixer->held_frame = 0;
+
+	for(uint32_t i = 0; i < voice_count; i++){
+		voices[i].source = NULL;
+		voices[i].context = NULL;
+		atomic_init(&voices[i].gains, 0);
+		atomic_init(&voices[i].active, false);
+		atomic_init(&voices[i].in_source, false);
+	}
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_mixer_play(MCP4822_Mixer_t *mixer, uint32_t voice, MCP4822_Source_Cb source, void *context, uint16_t volume, int16_t pan){
+
+	if(voice >= mixer->voice_count || source == NULL || volume > MCP4822_MIXER_UNITY){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	MCP4822_Mixer_Voice_t *v = &mixer->voices[voice];
+	if(!MCP4822_mixer_voice_released(mixer, voice)){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	v->source = source;
+	v->context = context;
+	atomic_store_explicit(&v->gains, pack_gains(volume, pan), memory_order_relaxed);
+
+	//Publish last, the refill only touches voices it sees active
+	atomic_store_explicit(&v->active, true, memory_order_release);
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_mixer_set_level(MCP4822_Mixer_t *mixer, uint32_t voice, uint16_t volume, int16_t pan){
+
+	if(voice >= mixer->voice_count || volume > MCP4822_MIXER_UNITY){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	atomic_store_explicit(&mixer->voices[voice].gains, pack_gains(volume, pan), memory_order_relaxed);
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_mixer_stop(MCP4822_Mixer_t *mixer, uint32_t voice){
+
+	if(voice >= mixer->voice_count){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Sequentially consistent, pairs with the in_source store of the refill
+	atomic_store(&mixer->voices[voice].active, false);
+
+	return MCP4822_OK;
+}
+
+bool MCP4822_mixer_voice_released(MCP4822_Mixer_t *mixer, uint32_t voice){
+
+	MCP4822_Mixer_Voice_t *v = &mixer->voices[voice];
+
+	//Either this sees in_source set, or the refill sees active cleared and skips the source
+	return !atomic_load(&v->active) && !atomic_load(&v->in_source);
+}
+
+int32_t MCP4822_mixer_free_voice(MCP4822_Mixer_t *mixer){
+
+	for(uint32_t i = 0; i < mixer->voice_count; i++){
+		if(!atomic_load_explicit(&mixer->voices[i].active, memory_order_acquire)){
+			return (int32_t)i;
+		}
+	}
+
+	return -1;
+}
+
+uint32_t MCP4822_mixer_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_Mixer_t *mixer = (MCP4822_Mixer_t *)context;
+	uint16_t header_a = MCP4822_encode_frame(mixer->handle, 0, MCP4822_CHANNEL_A);
+	uint16_t header_b = MCP4822_encode_frame(mixer->handle, 0, MCP4822_CHANNEL_B);
+	uint32_t written = 0;
+
+	//Finish the pair split across the previous refill
+	if(mixer->held && count > 0){
+		frames[written++] = mixer->held_frame;
+		mixer->held = 0;
+	}
+
+	//An odd count mixes one more pair than fits, its channel B frame is held
+	uint32_t pairs = (count - written) / 2;
+	uint32_t mixed = (count - written + 1) / 2;
+
+	for(uint32_t done = 0; done < mixed; done += MCP4822_MIXER_BLOCK){
+
+		uint32_t block = mixed - done;
+		if(block > MCP4822_MIXER_BLOCK){
+			block = MCP4822_MIXER_BLOCK;
+		}
+
+		for(uint32_t i = 0; i < block; i++){
+			mixer->mix_a[i] = 0;
+			mixer->mix_b[i] = 0;
+		}
+
+		for(uint32_t v = 0; v < mixer->voice_count; v++){
+
+			MCP4822_Mixer_Voice_t *voice = &mixer->voices[v];
+
+			//Claim the source before checking active, so a stop either sees the claim or is seen here
+			atomic_store(&voice->in_source, true);
+			if(!atomic_load(&voice->active)){
+				atomic_store_explicit(&voice->in_source, false, memory_order_release);
+				continue;
+			}
+
+			uint32_t produced = voice->source(voice->context, mixer->scratch, block);
+			uint32_t gains = atomic_load_explicit(&voice->gains, memory_order_relaxed);
+			int32_t gain_a = (int32_t)(gains & 0xFFFF);
+			int32_t gain_b = (int32_t)(gains >> 16);
+
+			//Full Q30 products, rounded once per output sample in mix_to_frame
+			for(uint32_t i = 0; i < produced; i++){
+				int32_t sample = mixer->scratch[i];
+				mixer->mix_a[i] += (int64_t)(sample * gain_a);
+				mixer->mix_b[i] += (int64_t)(sample * gain_b);
+			}
+
+			//A short count means the source has finished
+			if(produced < block){
+				atomic_store(&voice->active, false);
+			}
+			atomic_store_explicit(&voice->in_source, false, memory_order_release);
+		}
+
+		uint16_t *out = &frames[written + done * 2];
+		uint32_t whole = (done + block > pairs) ? block - 1 : block;
+		for(uint32_t i = 0; i < whole; i++){
+			out[2 * i] = mix_to_frame(mixer->mix_a[i], header_a);
+			out[2 * i + 1] = mix_to_frame(mixer->mix_b[i], header_b);
+		}
+
+		//Channel A goes out now and channel B opens the next refill
+		if(whole < block){
+			out[2 * whole] = mix_to_frame(mixer->mix_a[whole], header_a);
+			mixer->held_frame = mix_to_frame(mixer->mix_b[whole], header_b);
+			mixer->held = 1;
+		}
+	}
+
+	return count;
+}
+
+static uint32_t pack_gains(uint16_t volume, int16_t pan){
+
+	uint32_t gain_a = volume;
+	uint32_t gain_b = volume;
+
+	if(pan > 0){
+		gain_a = (volume * (uint32_t)(MCP4822_MIXER_UNITY - pan)) >> 15;
+	}
+	else if(pan < 0){
+		gain_b = (volume * (uint32_t)(MCP4822_MIXER_UNITY + pan)) >> 15;
+	}
+
+	return (gain_b << 16) | gain_a;
+}
+
+static inline uint16_t mix_to_frame(int64_t sum, uint16_t header){
+
+	//Q30 with the -1.0 .. 1.0 range moved to 0 .. 2.0, plus half a code, then down to 12 bits
+	const uint32_t shift = 30 + 1 - MCP4822_RES;
+	int64_t code = (sum + ((int64_t)1 << 30) + ((int64_t)1 << (shift - 1))) >> shift;
+
+	if(code > MCP4822_DAC_MAX){
+		code = MCP4822_DAC_MAX;
+	}
+	else if(code < 0){
+		code = 0;
+	}
+
+	return header | (uint16_t)code;
+}
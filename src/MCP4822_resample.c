@@ -0,0 +1,678 @@
+/*
+ * MCP4822_resample.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <stddef.h>
+#include <string.h>
+#include "MCP4822_resample.h"
+#include "MCP4822_adpcm.h"
+
+/** Filter phases per input sample, the fractional position is truncated to this */
+#define RESAMPLE_PHASE_BITS			   7
+#define RESAMPLE_PHASES				   (1 << RESAMPLE_PHASE_BITS)
+
+/** Q16 kernel scale of a conversion that is not downward, the tables are used as they are */
+#define RESAMPLE_SCALE_UNITY		   65536
+
+/** Fraction bits of a kernel position below one table phase */
+#define RESAMPLE_KERNEL_FRAC_BITS	   (16 - RESAMPLE_PHASE_BITS)
+
+/** 8-tap Kaiser windowed sinc, beta 5, cutoff 0.40 of the input rate, each phase sums to unity */
+static const int16_t sinc8_table[RESAMPLE_PHASES][8] =
+{
+	{761, -2736, 5310, 26154, 5310, -2736, 761, -56},
+	{756, -2694, 5114, 26153, 5507, -2777, 765, -56},
+	{752, -2652, 4919, 26148, 5707, -2818, 768, -56},
+	{747, -2609, 4726, 26140, 5907, -2858, 771, -56},
+	{742, -2565, 4535, 26125, 6110, -2898, 774, -55},
+	{736, -2521, 4346, 26109, 6313, -2937, 777, -55},
+	{730, -2477, 4159, 26087, 6519, -2975, 779, -54},
+	{724, -2433, 3973, 26064, 6725, -3012, 781, -54},
+	{718, -2388, 3789, 26036, 6933, -3049, 782, -53},
+	{711, -2342, 3607, 26004, 7142, -3085, 783, -52},
+	{704, -2297, 3427, 25968, 7353, -3120, 784, -51},
+	{697, -2251, 3249, 25929, 7564, -3154, 784, -50},
+	{690, -2205, 3073, 25885, 7777, -3187, 784, -49},
+	{682, -2158, 2899, 25839, 7991, -3220, 783, -48},
+	{675, -2112, 2727, 25787, 8206, -3251, 782, -46},
+	{667, -2065, 2557, 25734, 8422, -3282, 780, -45},
+	{659, -2018, 2389, 25675, 8639, -3311, 778, -43},
+	{650, -1971, 2223, 25615, 8857, -3339, 775, -42},
+	{642, -1924, 2059, 25551, 9075, -3367, 772, -40},
+	{633, -1877, 1897, 25483, 9295, -3393, 768, -38},
+	{624, -1830, 1738, 25411, 9515, -3418, 764, -36},
+	{615, -1782, 1581, 25333, 9736, -3442, 760, -33},
+	{606, -1735, 1425, 25255, 9958, -3465, 755, -31},
+	{597, -1688, 1273, 25172, 10180, -3486, 749, -29},
+	{588, -1641, 1122, 25085, 10403, -3506, 743, -26},
+	{578, -1594, 974, 24995, 10627, -3525, 736, -23},
+	{569, -1547, 828, 24901, 10851, -3543, 729, -20},
+	{559, -1500, 684, 24805, 11075, -3559, 721, -17},
+	{549, -1453, 542, 24705, 11300, -3574, 713, -14},
+	{540, -1406, 403, 24601, 11525, -3588, 704, -11},
+	{530, -1360, 267, 24494, 11750, -3600, 694, -7},
+	{520, -1314, 132, 24385, 11975, -3610, 684, -4},
+	{510, -1268, 0, 24271, 12201, -3619, 673, 0},
+	{500, -1222, -130, 24155, 12426, -3627, 662, 4},
+	{490, -1176, -257, 24034, 12652, -3633, 650, 8},
+	{479, -1131, -382, 23912, 12877, -3637, 638, 12},
+	{469, -1086, -504, 23784, 13103, -3640, 625, 17},
+	{459, -1041, -625, 23656, 13328, -3641, 611, 21},
+	{449, -997, -742, 23523, 13553, -3641, 597, 26},
+	{439, -953, -858, 23388, 13778, -3638, 582, 30},
+	{429, -909, -970, 23248, 14003, -3634, 566, 35},
+	{418, -866, -1081, 23108, 14227, -3629, 550, 41},
+	{408, -823, -1189, 22964, 14450, -3621, 533, 46},
+	{398, -780, -1294, 22816, 14673, -3612, 516, 51},
+	{388, -738, -1397, 22665, 14896, -3600, 497, 57},
+	{378, -696, -1498, 22512, 15118, -3587, 479, 62},
+	{368, -655, -1596, 22357, 15339, -3572, 459, 68},
+	{358, -614, -1692, 22198, 15560, -3555, 439, 74},
+	{348, -574, -1785, 22037, 15779, -3537, 419, 81},
+	{338, -534, -1876, 21874, 15998, -3516, 397, 87},
+	{328, -495, -1965, 21709, 16216, -3493, 375, 93},
+	{318, -456, -2051, 21539, 16433, -3468, 353, 100},
+	{308, -417, -2134, 21367, 16649, -3441, 329, 107},
+	{299, -379, -2216, 21193, 16864, -3412, 305, 114},
+	{289, -342, -2294, 21017, 17077, -3381, 281, 121},
+	{280, -305, -2371, 20838, 17290, -3348, 256, 128},
+	{270, -269, -2445, 20659, 17501, -3313, 230, 135},
+	{261, -233, -2516, 20475, 17711, -3276, 203, 143},
+	{252, -198, -2586, 20291, 17919, -3236, 176, 150},
+	{243, -164, -2653, 20104, 18126, -3194, 148, 158},
+	{234, -130, -2717, 19913, 18332, -3150, 120, 166},
+	{225, -96, -2779, 19722, 18535, -3104, 91, 174},
+	{216, -64, -2839, 19530, 18738, -3056, 61, 182},
+	{207, -32, -2897, 19335, 18938, -3005, 31, 191},
+	{199, 0, -2952, 19137, 19137, -2952, 0, 199},
+	{191, 31, -3005, 18938, 19335, -2897, -32, 207},
+	{182, 61, -3056, 18738, 19530, -2839, -64, 216},
+	{174, 91, -3104, 18535, 19722, -2779, -96, 225},
+	{166, 120, -3150, 18332, 19913, -2717, -130, 234},
+	{158, 148, -3194, 18126, 20104, -2653, -164, 243},
+	{150, 176, -3236, 17919, 20291, -2586, -198, 252},
+	{143, 203, -3276, 17711, 20475, -2516, -233, 261},
+	{135, 230, -3313, 17501, 20659, -2445, -269, 270},
+	{128, 256, -3348, 17290, 20838, -2371, -305, 280},
+	{121, 281, -3381, 17077, 21017, -2294, -342, 289},
+	{114, 305, -3412, 16864, 21193, -2216, -379, 299},
+	{107, 329, -3441, 16649, 21367, -2134, -417, 308},
+	{100, 353, -3468, 16433, 21539, -2051, -456, 318},
+	{93, 375, -3493, 16216, 21709, -1965, -495, 328},
+	{87, 397, -3516, 15998, 21874, -1876, -534, 338},
+	{81, 419, -3537, 15779, 22037, -1785, -574, 348},
+	{74, 439, -3555, 15560, 22198, -1692, -614, 358},
+	{68, 459, -3572, 15339, 22357, -1596, -655, 368},
+	{62, 479, -3587, 15118, 22512, -1498, -696, 378},
+	{57, 497, -3600, 14896, 22665, -1397, -738, 388},
+	{51, 516, -3612, 14673, 22816, -1294, -780, 398},
+	{46, 533, -3621, 14450, 22964, -1189, -823, 408},
+	{41, 550, -3629, 14227, 23108, -1081, -866, 418},
+	{35, 566, -3634, 14003, 23248, -970, -909, 429},
+	{30, 582, -3638, 13778, 23388, -858, -953, 439},
+	{26, 597, -3641, 13553, 23523, -742, -997, 449},
+	{21, 611, -3641, 13328, 23656, -625, -1041, 459},
+	{17, 625, -3640, 13103, 23784, -504, -1086, 469},
+	{12, 638, -3637, 12877, 23912, -382, -1131, 479},
+	{8, 650, -3633, 12652, 24034, -257, -1176, 490},
+	{4, 662, -3627, 12426, 24155, -130, -1222, 500},
+	{0, 673, -3619, 12201, 24271, 0, -1268, 510},
+	{-4, 684, -3610, 11975, 24385, 132, -1314, 520},
+	{-7, 694, -3600, 11750, 24494, 267, -1360, 530},
+	{-11, 704, -3588, 11525, 24601, 403, -1406, 540},
+	{-14, 713, -3574, 11300, 24705, 542, -1453, 549},
+	{-17, 721, -3559, 11075, 24805, 684, -1500, 559},
+	{-20, 729, -3543, 10851, 24901, 828, -1547, 569},
+	{-23, 736, -3525, 10627, 24995, 974, -1594, 578},
+	{-26, 743, -3506, 10403, 25085, 1122, -1641, 588},
+	{-29, 749, -3486, 10180, 25172, 1273, -1688, 597},
+	{-31, 755, -3465, 9958, 25255, 1425, -1735, 606},
+	{-33, 760, -3442, 9736, 25333, 1581, -1782, 615},
+	{-36, 764, -3418, 9515, 25411, 1738, -1830, 624},
+	{-38, 768, -3393, 9295, 25483, 1897, -1877, 633},
+	{-40, 772, -3367, 9075, 25551, 2059, -1924, 642},
+	{-42, 775, -3339, 8857, 25615, 2223, -1971, 650},
+	{-43, 778, -3311, 8639, 25675, 2389, -2018, 659},
+	{-45, 780, -3282, 8422, 25734, 2557, -2065, 667},
+	{-46, 782, -3251, 8206, 25787, 2727, -2112, 675},
+	{-48, 783, -3220, 7991, 25839, 2899, -2158, 682},
+	{-49, 784, -3187, 7777, 25885, 3073, -2205, 690},
+	{-50, 784, -3154, 7564, 25929, 3249, -2251, 697},
+	{-51, 784, -3120, 7353, 25968, 3427, -2297, 704},
+	{-52, 783, -3085, 7142, 26004, 3607, -2342, 711},
+	{-53, 782, -3049, 6933, 26036, 3789, -2388, 718},
+	{-54, 781, -3012, 6725, 26064, 3973, -2433, 724},
+	{-54, 779, -2975, 6519, 26087, 4159, -2477, 730},
+	{-55, 777, -2937, 6313, 26109, 4346, -2521, 736},
+	{-55, 774, -2898, 6110, 26125, 4535, -2565, 742},
+	{-56, 771, -2858, 5907, 26140, 4726, -2609, 747},
+	{-56, 768, -2818, 5707, 26148, 4919, -2652, 752},
+	{-56, 765, -2777, 5507, 26153, 5114, -2694, 756}
+};
+
+/** 16-tap Kaiser windowed sinc, beta 7, cutoff 0.44 of the input rate, each phase sums to unity */
+static const int16_t sinc16_table[RESAMPLE_PHASES][16] =
+{
+	{29, -156, 486, -1098, 1964, -2907, 3649, 28835, 3649, -2907, 1964, -1098, 486, -156, 29, -1},
+	{29, -157, 487, -1091, 1933, -2824, 3420, 28834, 3881, -2990, 1993, -1106, 486, -154, 28, -1},
+	{30, -159, 486, -1082, 1902, -2740, 3193, 28828, 4115, -3072, 2022, -1113, 485, -153, 27, -1},
+	{31, -160, 486, -1074, 1871, -2656, 2968, 28814, 4350, -3153, 2051, -1119, 485, -151, 26, -1},
+	{32, -161, 485, -1064, 1838, -2572, 2745, 28799, 4588, -3234, 2078, -1125, 483, -149, 25, 0},
+	{32, -162, 485, -1055, 1806, -2487, 2525, 28776, 4828, -3314, 2105, -1130, 482, -147, 24, 0},
+	{33, -163, 483, -1045, 1772, -2402, 2308, 28752, 5070, -3394, 2131, -1135, 480, -145, 23, 0},
+	{33, -164, 482, -1034, 1738, -2316, 2092, 28721, 5314, -3473, 2157, -1140, 478, -142, 22, 0},
+	{34, -164, 481, -1023, 1704, -2231, 1880, 28684, 5559, -3551, 2181, -1143, 476, -140, 21, 0},
+	{34, -165, 479, -1012, 1669, -2145, 1669, 28646, 5806, -3628, 2205, -1147, 474, -138, 20, 1},
+	{35, -166, 477, -1001, 1634, -2060, 1462, 28602, 6055, -3704, 2228, -1150, 471, -135, 19, 1},
+	{35, -166, 475, -989, 1598, -1974, 1257, 28552, 6306, -3779, 2250, -1152, 468, -132, 18, 1},
+	{36, -166, 472, -976, 1562, -1888, 1055, 28498, 6558, -3853, 2271, -1153, 464, -129, 16, 1},
+	{36, -166, 469, -964, 1525, -1802, 855, 28442, 6812, -3926, 2291, -1155, 461, -127, 15, 2},
+	{36, -167, 466, -950, 1488, -1716, 658, 28379, 7067, -3998, 2310, -1155, 457, -123, 14, 2},
+	{37, -167, 463, -937, 1451, -1631, 464, 28314, 7324, -4069, 2328, -1155, 452, -120, 12, 2},
+	{37, -167, 460, -923, 1413, -1545, 273, 28241, 7582, -4139, 2346, -1154, 448, -117, 11, 2},
+	{37, -166, 457, -909, 1375, -1460, 85, 28164, 7841, -4207, 2362, -1153, 443, -114, 10, 3},
+	{37, -166, 453, -895, 1337, -1374, -101, 28084, 8102, -4274, 2377, -1151, 438, -110, 8, 3},
+	{38, -166, 449, -881, 1298, -1290, -283, 27999, 8364, -4340, 2392, -1149, 433, -106, 7, 3},
+	{38, -165, 445, -866, 1260, -1205, -463, 27910, 8627, -4405, 2405, -1146, 427, -103, 5, 4},
+	{38, -165, 441, -851, 1221, -1121, -640, 27817, 8891, -4468, 2417, -1142, 421, -99, 4, 4},
+	{38, -164, 437, -835, 1181, -1037, -813, 27719, 9155, -4529, 2428, -1138, 415, -95, 2, 4},
+	{38, -164, 432, -820, 1142, -953, -984, 27617, 9421, -4589, 2439, -1133, 408, -91, 0, 5},
+	{38, -163, 427, -804, 1102, -870, -1152, 27512, 9688, -4648, 2447, -1128, 401, -86, -1, 5},
+	{38, -162, 422, -788, 1063, -787, -1316, 27401, 9955, -4705, 2455, -1122, 394, -82, -3, 5},
+	{38, -161, 417, -771, 1023, -705, -1478, 27285, 10223, -4760, 2462, -1115, 387, -78, -5, 6},
+	{38, -160, 412, -755, 983, -623, -1636, 27164, 10492, -4814, 2468, -1107, 379, -73, -6, 6},
+	{38, -159, 407, -738, 943, -542, -1792, 27042, 10761, -4866, 2472, -1099, 371, -69, -8, 7},
+	{38, -158, 401, -721, 903, -462, -1944, 26916, 11031, -4916, 2475, -1091, 363, -64, -10, 7},
+	{38, -157, 396, -704, 863, -382, -2093, 26783, 11302, -4964, 2477, -1081, 354, -59, -12, 7},
+	{38, -156, 390, -687, 823, -303, -2239, 26649, 11572, -5010, 2478, -1072, 345, -54, -14, 8},
+	{37, -154, 384, -670, 783, -224, -2381, 26509, 11843, -5055, 2478, -1061, 336, -49, -16, 8},
+	{37, -153, 378, -652, 743, -146, -2521, 26366, 12114, -5097, 2476, -1050, 326, -44, -18, 9},
+	{37, -151, 372, -634, 703, -69, -2657, 26217, 12385, -5138, 2473, -1038, 317, -38, -20, 9},
+	{37, -150, 366, -617, 663, 7, -2790, 26066, 12657, -5176, 2469, -1025, 307, -33, -22, 9},
+	{37, -148, 360, -599, 624, 82, -2920, 25910, 12928, -5213, 2464, -1012, 296, -27, -24, 10},
+	{36, -147, 353, -581, 584, 157, -3046, 25752, 13200, -5247, 2457, -998, 286, -22, -26, 10},
+	{36, -145, 347, -563, 544, 231, -3169, 25588, 13471, -5279, 2449, -984, 275, -16, -28, 11},
+	{36, -143, 340, -545, 505, 304, -3289, 25421, 13742, -5309, 2440, -969, 264, -10, -30, 11},
+	{36, -142, 333, -527, 466, 376, -3406, 25252, 14012, -5337, 2430, -953, 252, -4, -32, 12},
+	{35, -140, 327, -508, 426, 447, -3519, 25077, 14283, -5362, 2418, -936, 240, 2, -34, 12},
+	{35, -138, 320, -490, 388, 517, -3630, 24901, 14552, -5385, 2405, -919, 228, 8, -37, 13},
+	{35, -136, 313, -472, 349, 586, -3736, 24721, 14822, -5406, 2390, -902, 216, 14, -39, 13},
+	{34, -134, 306, -453, 310, 654, -3840, 24536, 15091, -5424, 2374, -883, 204, 20, -41, 14},
+	{34, -132, 299, -435, 272, 721, -3940, 24349, 15359, -5440, 2357, -864, 191, 26, -43, 14},
+	{33, -130, 292, -417, 234, 787, -4038, 24160, 15626, -5454, 2339, -844, 178, 33, -46, 15},
+	{33, -128, 285, -398, 197, 852, -4131, 23965, 15893, -5465, 2319, -824, 164, 39, -48, 15},
+	{33, -126, 277, -380, 159, 915, -4222, 23769, 16158, -5473, 2298, -803, 151, 46, -50, 16},
+	{32, -124, 270, -362, 122, 978, -4309, 23571, 16423, -5479, 2275, -782, 137, 53, -53, 16},
+	{32, -122, 263, -343, 85, 1040, -4393, 23365, 16687, -5482, 2251, -759, 123, 59, -55, 17},
+	{31, -119, 256, -325, 49, 1100, -4474, 23158, 16950, -5482, 2226, -737, 109, 66, -57, 17},
+	{31, -117, 248, -307, 13, 1159, -4552, 22951, 17211, -5480, 2199, -713, 94, 73, -60, 18},
+	{30, -115, 241, -289, -23, 1217, -4626, 22738, 17471, -5475, 2171, -689, 80, 80, -62, 19},
+	{30, -113, 233, -271, -58, 1274, -4697, 22525, 17730, -5468, 2142, -665, 65, 87, -65, 19},
+	{29, -110, 226, -253, -93, 1330, -4765, 22304, 17988, -5457, 2111, -639, 50, 94, -67, 20},
+	{29, -108, 219, -235, -127, 1384, -4830, 22085, 18244, -5444, 2079, -614, 34, 101, -69, 20},
+	{28, -106, 211, -217, -161, 1437, -4891, 21861, 18499, -5428, 2046, -587, 19, 108, -72, 21},
+	{28, -103, 204, -199, -195, 1489, -4949, 21634, 18752, -5409, 2011, -560, 3, 115, -74, 21},
+	{27, -101, 196, -182, -228, 1540, -5005, 21409, 19003, -5387, 1975, -533, -13, 122, -77, 22},
+	{27, -99, 189, -164, -261, 1589, -5057, 21178, 19252, -5362, 1937, -505, -29, 130, -79, 22},
+	{26, -96, 181, -147, -293, 1637, -5106, 20947, 19500, -5335, 1898, -476, -46, 137, -82, 23},
+	{26, -94, 174, -130, -325, 1684, -5151, 20710, 19746, -5304, 1858, -447, -62, 144, -84, 23},
+	{25, -91, 166, -112, -356, 1730, -5194, 20469, 19990, -5270, 1817, -417, -79, 152, -86, 24},
+	{25, -89, 159, -95, -387, 1774, -5234, 20230, 20232, -5234, 1774, -387, -95, 159, -89, 25},
+	{24, -86, 152, -79, -417, 1817, -5270, 19990, 20469, -5194, 1730, -356, -112, 166, -91, 25},
+	{23, -84, 144, -62, -447, 1858, -5304, 19746, 20710, -5151, 1684, -325, -130, 174, -94, 26},
+	{23, -82, 137, -46, -476, 1898, -5335, 19500, 20947, -5106, 1637, -293, -147, 181, -96, 26},
+	{22, -79, 130, -29, -505, 1937, -5362, 19252, 21178, -5057, 1589, -261, -164, 189, -99, 27},
+	{22, -77, 122, -13, -533, 1975, -5387, 19003, 21409, -5005, 1540, -228, -182, 196, -101, 27},
+	{21, -74, 115, 3, -560, 2011, -5409, 18752, 21634, -4949, 1489, -195, -199, 204, -103, 28},
+	{21, -72, 108, 19, -587, 2046, -5428, 18499, 21861, -4891, 1437, -161, -217, 211, -106, 28},
+	{20, -69, 101, 34, -614, 2079, -5444, 18244, 22085, -4830, 1384, -127, -235, 219, -108, 29},
+	{20, -67, 94, 50, -639, 2111, -5457, 17988, 22304, -4765, 1330, -93, -253, 226, -110, 29},
+	{19, -65, 87, 65, -665, 2142, -5468, 17730, 22525, -4697, 1274, -58, -271, 233, -113, 30},
+	{19, -62, 80, 80, -689, 2171, -5475, 17471, 22738, -4626, 1217, -23, -289, 241, -115, 30},
+	{18, -60, 73, 94, -713, 2199, -5480, 17211, 22951, -4552, 1159, 13, -307, 248, -117, 31},
+	{17, -57, 66, 109, -737, 2226, -5482, 16950, 23158, -4474, 1100, 49, -325, 256, -119, 31},
+	{17, -55, 59, 123, -759, 2251, -5482, 16687, 23365, -4393, 1040, 85, -343, 263, -122, 32},
+	{16, -53, 53, 137, -782, 2275, -5479, 16423, 23571, -4309, 978, 122, -362, 270, -124, 32},
+	{16, -50, 46, 151, -803, 2298, -5473, 16158, 23769, -4222, 915, 159, -380, 277, -126, 33},
+	{15, -48, 39, 164, -824, 2319, -5465, 15893, 23965, -4131, 852, 197, -398, 285, -128, 33},
+	{15, -46, 33, 178, -844, 2339, -5454, 15626, 24160, -4038, 787, 234, -417, 292, -130, 33},
+	{14, -43, 26, 191, -864, 2357, -5440, 15359, 24349, -3940, 721, 272, -435, 299, -132, 34},
+	{14, -41, 20, 204, -883, 2374, -5424, 15091, 24536, -3840, 654, 310, -453, 306, -134, 34},
+	{13, -39, 14, 216, -902, 2390, -5406, 14822, 24721, -3736, 586, 349, -472, 313, -136, 35},
+	{13, -37, 8, 228, -919, 2405, -5385, 14552, 24901, -3630, 517, 388, -490, 320, -138, 35},
+	{12, -34, 2, 240, -936, 2418, -5362, 14283, 25077, -3519, 447, 426, -508, 327, -140, 35},
+	{12, -32, -4, 252, -953, 2430, -5337, 14012, 25252, -3406, 376, 466, -527, 333, -142, 36},
+	{11, -30, -10, 264, -969, 2440, -5309, 13742, 25421, -3289, 304, 505, -545, 340, -143, 36},
+	{11, -28, -16, 275, -984, 2449, -5279, 13471, 25588, -3169, 231, 544, -563, 347, -145, 36},
+	{10, -26, -22, 286, -998, 2457, -5247, 13200, 25752, -3046, 157, 584, -581, 353, -147, 36},
+	{10, -24, -27, 296, -1012, 2464, -5213, 12928, 25910, -2920, 82, 624, -599, 360, -148, 37},
+	{9, -22, -33, 307, -1025, 2469, -5176, 12657, 26066, -2790, 7, 663, -617, 366, -150, 37},
+	{9, -20, -38, 317, -1038, 2473, -5138, 12385, 26217, -2657, -69, 703, -634, 372, -151, 37},
+	{9, -18, -44, 326, -1050, 2476, -5097, 12114, 26366, -2521, -146, 743, -652, 378, -153, 37},
+	{8, -16, -49, 336, -1061, 2478, -5055, 11843, 26509, -2381, -224, 783, -670, 384, -154, 37},
+	{8, -14, -54, 345, -1072, 2478, -5010, 11572, 26649, -2239, -303, 823, -687, 390, -156, 38},
+	{7, -12, -59, 354, -1081, 2477, -4964, 11302, 26783, -2093, -382, 863, -704, 396, -157, 38},
+	{7, -10, -64, 363, -1091, 2475, -4916, 11031, 26916, -1944, -462, 903, -721, 401, -158, 38},
+	{7, -8, -69, 371, -1099, 2472, -4866, 10761, 27042, -1792, -542, 943, -738, 407, -159, 38},
+	{6, -6, -73, 379, -1107, 2468, -4814, 10492, 27164, -1636, -623, 983, -755, 412, -160, 38},
+	{6, -5, -78, 387, -1115, 2462, -4760, 10223, 27285, -1478, -705, 1023, -771, 417, -161, 38},
+	{5, -3, -82, 394, -1122, 2455, -4705, 9955, 27401, -1316, -787, 1063, -788, 422, -162, 38},
+	{5, -1, -86, 401, -1128, 2447, -4648, 9688, 27512, -1152, -870, 1102, -804, 427, -163, 38},
+	{5, 0, -91, 408, -1133, 2439, -4589, 9421, 27617, -984, -953, 1142, -820, 432, -164, 38},
+	{4, 2, -95, 415, -1138, 2428, -4529, 9155, 27719, -813, -1037, 1181, -835, 437, -164, 38},
+	{4, 4, -99, 421, -1142, 2417, -4468, 8891, 27817, -640, -1121, 1221, -851, 441, -165, 38},
+	{4, 5, -103, 427, -1146, 2405, -4405, 8627, 27910, -463, -1205, 1260, -866, 445, -165, 38},
+	{3, 7, -106, 433, -1149, 2392, -4340, 8364, 27999, -283, -1290, 1298, -881, 449, -166, 38},
+	{3, 8, -110, 438, -1151, 2377, -4274, 8102, 28084, -101, -1374, 1337, -895, 453, -166, 37},
+	{3, 10, -114, 443, -1153, 2362, -4207, 7841, 28164, 85, -1460, 1375, -909, 457, -166, 37},
+	{2, 11, -117, 448, -1154, 2346, -4139, 7582, 28241, 273, -1545, 1413, -923, 460, -167, 37},
+	{2, 12, -120, 452, -1155, 2328, -4069, 7324, 28314, 464, -1631, 1451, -937, 463, -167, 37},
+	{2, 14, -123, 457, -1155, 2310, -3998, 7067, 28379, 658, -1716, 1488, -950, 466, -167, 36},
+	{2, 15, -127, 461, -1155, 2291, -3926, 6812, 28442, 855, -1802, 1525, -964, 469, -166, 36},
+	{1, 16, -129, 464, -1153, 2271, -3853, 6558, 28498, 1055, -1888, 1562, -976, 472, -166, 36},
+	{1, 18, -132, 468, -1152, 2250, -3779, 6306, 28552, 1257, -1974, 1598, -989, 475, -166, 35},
+	{1, 19, -135, 471, -1150, 2228, -3704, 6055, 28602, 1462, -2060, 1634, -1001, 477, -166, 35},
+	{1, 20, -138, 474, -1147, 2205, -3628, 5806, 28646, 1669, -2145, 1669, -1012, 479, -165, 34},
+	{0, 21, -140, 476, -1143, 2181, -3551, 5559, 28684, 1880, -2231, 1704, -1023, 481, -164, 34},
+	{0, 22, -142, 478, -1140, 2157, -3473, 5314, 28721, 2092, -2316, 1738, -1034, 482, -164, 33},
+	{0, 23, -145, 480, -1135, 2131, -3394, 5070, 28752, 2308, -2402, 1772, -1045, 483, -163, 33},
+	{0, 24, -147, 482, -1130, 2105, -3314, 4828, 28776, 2525, -2487, 1806, -1055, 485, -162, 32},
+	{0, 25, -149, 483, -1125, 2078, -3234, 4588, 28799, 2745, -2572, 1838, -1064, 485, -161, 32},
+	{-1, 26, -151, 485, -1119, 2051, -3153, 4350, 28814, 2968, -2656, 1871, -1074, 486, -160, 31},
+	{-1, 27, -153, 485, -1113, 2022, -3072, 4115, 28828, 3193, -2740, 1902, -1082, 486, -159, 30},
+	{-1, 28, -154, 486, -1106, 1993, -2990, 3881, 28834, 3420, -2824, 1933, -1091, 487, -157, 29}
+};
+
+/**
+ * @brief Compacts the input history and pulls the next block from the source
+ *
+ * @param resampler - resampler
+ *
+ * @return 1 if the buffered input changed, 0 once the source has ended
+ */
+static uint8_t fill_input(MCP4822_Resampler_t *resampler);
+
+/**
+ * @brief Marks the end of the source and appends the zeros the filter tail reads
+ *
+ * @param resampler - resampler
+ *
+ * @return None
+ */
+static void mark_end(MCP4822_Resampler_t *resampler);
+
+/**
+ * @brief Produces every output sample the buffered input allows
+ *
+ * @param resampler - resampler
+ * @param samples - destination for the samples
+ * @param count - maximum number of samples
+ *
+ * @return Number of samples written
+ */
+static uint32_t render(MCP4822_Resampler_t *resampler, int16_t *samples, uint32_t count);
+
+/**
+ * @brief Applies one phase of a polyphase filter
+ *
+ * @param input - first input sample under the filter
+ * @param coefs - Q15 coefficients of the phase
+ * @param taps - filter length
+ *
+ * @return Filtered sample, saturated to 16 bits
+ */
+static inline int16_t apply_filter(const int16_t *input, const int16_t *coefs, uint32_t taps);
+
+/**
+ * @brief Applies a sinc kernel stretched by 1 / scale, for a downward conversion
+ *
+ * The kernel is read from the polyphase table as one curve sampled every
+ * 1 / RESAMPLE_PHASES of a tap and interpolated linearly between entries.
+ *
+ * @param input - first input sample under the filter
+ * @param table - polyphase table of the quality
+ * @param base_taps - filter length of the table
+ * @param taps - filter length covering the stretched kernel
+ * @param frac - position of the output between input samples, 0.32 fixed point
+ * @param scale_q16 - output / input rate ratio in Q16, below RESAMPLE_SCALE_UNITY
+ *
+ * @return Filtered sample, saturated to 16 bits
+ */
+static inline int16_t apply_scaled_filter(const int16_t *input, const int16_t *table, uint32_t base_taps, uint32_t taps,
+										  uint32_t frac, uint32_t scale_q16);
+
+/**
+ * @brief Reads the kernel of a polyphase table at a position
+ *
+ * @param table - polyphase table
+ * @param base_taps - filter length of the table
+ * @param position - kernel position in 1 / RESAMPLE_PHASES of a tap, 0 .. base_taps * RESAMPLE_PHASES
+ *
+ * @return Q15 kernel value
+ */
+static inline int32_t kernel_at(const int16_t *table, uint32_t base_taps, uint32_t position);
+
+MCP4822_STATUS MCP4822_resample_init(MCP4822_Resampler_t *resampler, MCP4822_Handle_t *handle, MCP4822_DAC_SELECT dac_channel,
+									 MCP4822_Source_Cb source, void *context, MCP4822_RESAMPLE_QUALITY quality,
+									 uint32_t input_rate, uint32_t output_rate){
+
+	if(resampler == NULL || handle == NULL || source == NULL || quality > MCP4822_RESAMPLE_SINC16 || input_rate == 0 || output_rate == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	static const uint8_t quality_taps[] = {2, 2, 8, 16};
+	uint32_t taps = quality_taps[quality];
+
+	//Converting down stretches the sinc kernel over input / output times the taps, rounded up to an even count
+	if(quality >= MCP4822_RESAMPLE_SINC8 && input_rate > output_rate){
+		taps = (uint32_t)(((uint64_t)taps * input_rate + output_rate - 1) / output_rate);
+		taps = (taps + 1) & ~1u;
+
+		if(taps > MCP4822_RESAMPLE_TAPS_MAX){
+			return MCP4822_ERROR_INVALID_ARG;
+		}
+	}
+
+	resampler->handle = handle;
+	resampler->dac_channel = dac_channel;
+	resampler->source = source;
+	resampler->context = context;
+	resampler->quality = quality;
+	resampler->base_taps = quality_taps[quality];
+	resampler->taps = (uint8_t)taps;
+
+	MCP4822_resample_set_rates(resampler, input_rate, output_rate);
+	MCP4822_resample_reset(resampler);
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_resample_set_rates(MCP4822_Resampler_t *resampler, uint32_t input_rate, uint32_t output_rate){
+
+	if(input_rate == 0 || output_rate == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	uint64_t step = (((uint64_t)input_rate << 32) + output_rate / 2) / output_rate;
+
+	resampler->step_int = (uint32_t)(step >> 32);
+	resampler->step_frac = (uint32_t)step;
+
+	//The cutoff drops with the ratio until the stretched kernel fills all the taps
+	uint32_t scale = RESAMPLE_SCALE_UNITY;
+	if(resampler->quality >= MCP4822_RESAMPLE_SINC8 && input_rate > output_rate){
+		uint32_t widest = ((uint32_t)resampler->base_taps * RESAMPLE_SCALE_UNITY + resampler->taps - 1) / resampler->taps;
+
+		scale = (uint32_t)(((uint64_t)output_rate * RESAMPLE_SCALE_UNITY) / input_rate);
+		scale = (scale < widest) ? widest : scale;
+	}
+
+	resampler->scale_q16 = scale;
+
+	return MCP4822_OK;
+}
+
+void MCP4822_resample_reset(MCP4822_Resampler_t *resampler){
+
+	//Zeros ahead of the first sample centre the filter on it, so there is no start-up delay
+	uint32_t lead = resampler->taps / 2 - 1;
+	for(uint32_t i = 0; i < lead; i++){
+		resampler->input[i] = 0;
+	}
+
+	resampler->filled = lead;
+	resampler->index = 0;
+	resampler->frac = 0;
+	resampler->limit = 0;
+	resampler->ended = 0;
+}
+
+uint32_t MCP4822_resample_read(void *context, int16_t *samples, uint32_t count){
+
+	MCP4822_Resampler_t *resampler = (MCP4822_Resampler_t *)context;
+	uint32_t done = 0;
+
+	while(done < count){
+
+		done += render(resampler, &samples[done], count - done);
+
+		if(done < count && !fill_input(resampler)){
+			break;
+		}
+	}
+
+	return done;
+}
+
+uint32_t MCP4822_resample_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_Resampler_t *resampler = (MCP4822_Resampler_t *)context;
+	uint16_t header = MCP4822_encode_frame(resampler->handle, 0, resampler->dac_channel);
+
+	//Samples are rendered into the frame buffer and encoded in place
+	int16_t *samples = (int16_t *)frames;
+	uint32_t written = MCP4822_resample_read(resampler, samples, count);
+
+	for(uint32_t i = 0; i < written; i++){
+		frames[i] = header | MCP4822_pcm_to_DAC_units(samples[i]);
+	}
+
+	return written;
+}
+
+static uint8_t fill_input(MCP4822_Resampler_t *resampler){
+
+	if(resampler->ended){
+		return 0;
+	}
+
+	uint32_t keep = 0;
+	uint32_t skip = 0;
+
+	if(resampler->index < resampler->filled){
+		keep = resampler->filled - resampler->index;
+		memmove(resampler->input, &resampler->input[resampler->index], keep * sizeof(int16_t));
+	}
+	else{
+		skip = resampler->index - resampler->filled;
+	}
+
+	resampler->filled = keep;
+	resampler->index = 0;
+
+	//A large downward ratio can step past the buffered input, those samples are read and dropped
+	while(skip > 0){
+
+		uint32_t wanted = (skip < MCP4822_RESAMPLE_BLOCK) ? skip : MCP4822_RESAMPLE_BLOCK;
+		uint32_t got = resampler->source(resampler->context, resampler->input, wanted);
+
+		if(got < wanted){
+			mark_end(resampler);
+			return 1;
+		}
+
+		skip -= got;
+	}
+
+	uint32_t got = resampler->source(resampler->context, &resampler->input[keep], MCP4822_RESAMPLE_BLOCK);
+	resampler->filled += got;
+
+	if(got < MCP4822_RESAMPLE_BLOCK){
+		mark_end(resampler);
+	}
+
+	return 1;
+}
+
+static void mark_end(MCP4822_Resampler_t *resampler){
+
+	resampler->ended = 1;
+	resampler->limit = resampler->filled;
+
+	for(uint32_t i = 0; i < resampler->taps / 2u; i++){
+		resampler->input[resampler->filled++] = 0;
+	}
+}
+
+static uint32_t render(MCP4822_Resampler_t *resampler, int16_t *samples, uint32_t count){
+
+	const int16_t *input = resampler->input;
+	uint32_t taps = resampler->taps;
+	uint32_t half = taps / 2;
+	uint32_t index = resampler->index;
+	uint32_t frac = resampler->frac;
+	uint32_t step_int = resampler->step_int;
+	uint32_t step_frac = resampler->step_frac;
+
+	//Outputs are made while the whole filter lies in the buffer and, after the end, its centre is on a real sample
+	uint32_t stop = (resampler->filled + 1 > taps) ? resampler->filled + 1 - taps : 0;
+	if(resampler->ended){
+		uint32_t end = (resampler->limit + 1 > half) ? resampler->limit + 1 - half : 0;
+		if(end < stop){
+			stop = end;
+		}
+	}
+
+	uint32_t done = 0;
+
+	//Converting down, the sinc kernel is stretched and evaluated per output instead of read from a table phase
+	if(resampler->scale_q16 < RESAMPLE_SCALE_UNITY){
+		const int16_t *table = (resampler->quality == MCP4822_RESAMPLE_SINC8) ? &sinc8_table[0][0] : &sinc16_table[0][0];
+		uint32_t base_taps = resampler->base_taps;
+		uint32_t scale = resampler->scale_q16;
+
+		for(; done < count && index < stop; done++){
+			samples[done] = apply_scaled_filter(&input[index], table, base_taps, taps, frac, scale);
+
+			uint32_t prev = frac;
+			frac += step_frac;
+			index += step_int + (frac < prev);
+		}
+
+		resampler->index = index;
+		resampler->frac = frac;
+
+		return done;
+	}
+
+	switch(resampler->quality){
+		case MCP4822_RESAMPLE_NEAREST:
+			for(; done < count && index < stop; done++){
+				samples[done] = input[index + (frac >> 31)];
+
+				uint32_t prev = frac;
+				frac += step_frac;
+				index += step_int + (frac < prev);
+			}
+			break;
+
+		case MCP4822_RESAMPLE_LINEAR:
+			for(; done < count && index < stop; done++){
+				int32_t a = input[index];
+				int32_t b = input[index + 1];
+				samples[done] = (int16_t)(a + (((b - a) * (int32_t)(frac >> 17)) >> 15));
+
+				uint32_t prev = frac;
+				frac += step_frac;
+				index += step_int + (frac < prev);
+			}
+			break;
+
+		case MCP4822_RESAMPLE_SINC8:
+			for(; done < count && index < stop; done++){
+				samples[done] = apply_filter(&input[index], sinc8_table[frac >> (32 - RESAMPLE_PHASE_BITS)], 8);
+
+				uint32_t prev = frac;
+				frac += step_frac;
+				index += step_int + (frac < prev);
+			}
+			break;
+
+		case MCP4822_RESAMPLE_SINC16:
+		default:
+			for(; done < count && index < stop; done++){
+				samples[done] = apply_filter(&input[index], sinc16_table[frac >> (32 - RESAMPLE_PHASE_BITS)], 16);
+
+				uint32_t prev = frac;
+				frac += step_frac;
+				index += step_int + (frac < prev);
+			}
+			break;
+	}
+
+	resampler->index = index;
+	resampler->frac = frac;
+
+	return done;
+}
+
+static inline int16_t apply_filter(const int16_t *input, const int16_t *coefs, uint32_t taps){
+
+	int32_t acc = 1 << 14;
+
+	for(uint32_t i = 0; i < taps; i++){
+		acc += (int32_t)input[i] * coefs[i];
+	}
+
+	acc >>= 15;
+
+	if(acc > INT16_MAX){
+		acc = INT16_MAX;
+	}
+	else if(acc < INT16_MIN){
+		acc = INT16_MIN;
+	}
+
+	return (int16_t)acc;
+}
+
+static inline int16_t apply_scaled_filter(const int16_t *input, const int16_t *table, uint32_t base_taps, uint32_t taps,
+										  uint32_t frac, uint32_t scale_q16){
+
+	//Kernel position of the first tap in Q16 table taps, the output sits taps / 2 - 1 + frac samples further on
+	uint64_t offset = ((uint64_t)(taps / 2 - 1) << 32) + frac;
+	int32_t position = (int32_t)((base_taps / 2) << 16) - (int32_t)(((uint64_t)scale_q16 * offset) >> 32);
+	int32_t end = (int32_t)(base_taps << 16);
+	int64_t acc = 0;
+
+	for(uint32_t i = 0; i < taps; i++, position += (int32_t)scale_q16){
+
+		if(position < 0 || position >= end){
+			continue;
+		}
+
+		uint32_t entry = (uint32_t)position >> RESAMPLE_KERNEL_FRAC_BITS;
+		int32_t weight = (int32_t)((uint32_t)position & ((1u << RESAMPLE_KERNEL_FRAC_BITS) - 1));
+		int32_t a = kernel_at(table, base_taps, entry);
+		int32_t b = kernel_at(table, base_taps, entry + 1);
+
+		acc += (int32_t)input[i] * (a + (((b - a) * weight) >> RESAMPLE_KERNEL_FRAC_BITS));
+	}
+
+	//Stretching by 1 / scale also multiplies the kernel's sum, scaling back keeps unity gain
+	acc = (acc * scale_q16 + ((int64_t)1 << 30)) >> 31;
+
+	if(acc > INT16_MAX){
+		acc = INT16_MAX;
+	}
+	else if(acc < INT16_MIN){
+		acc = INT16_MIN;
+	}
+
+	return (int16_t)acc;
+}
+
+static inline int32_t kernel_at(const int16_t *table, uint32_t base_taps, uint32_t position){
+
+	//Phase 0 holds both ends of the kernel only once, the start mirrors the end
+	if(position == 0){
+		return table[base_taps - 1];
+	}
+
+	uint32_t tap = (position - 1) >> RESAMPLE_PHASE_BITS;
+	uint32_t phase = ((tap + 1) << RESAMPLE_PHASE_BITS) - position;
+
+	return table[phase * base_taps + tap];
+}
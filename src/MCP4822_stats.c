@@ -0,0 +1,106 @@
+/*
+ * MCP4822_stats.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "MCP4822_stats.h"
+
+#ifdef MCP4822_ENABLE_STATS
+
+/**
+ * @brief Clears every summary and counter of a stats block
+ *
+ * @param stats - stats block
+ *
+ * @return None
+ */
+static void clear_stats(MCP4822_Stats_t *stats);
+
+void MCP4822_stats_attach(MCP4822_Handle_t *handle, MCP4822_Stats_t *stats){
+
+	if(stats != NULL){
+		clear_stats(stats);
+
+		MCP4822_port_ticks_enable();
+	}
+
+	handle->stats = stats;
+}
+
+MCP4822_STATUS MCP4822_stats_snapshot(const MCP4822_Handle_t *handle, MCP4822_Stats_t *snapshot){
+
+	if(handle->stats == NULL || snapshot == NULL){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//Interrupt completions also record, so copy with them held off
+	uint32_t primask = MCP4822_port_irq_save();
+	memcpy(snapshot, handle->stats, sizeof(MCP4822_Stats_t));
+	MCP4822_port_irq_restore(primask);
+
+	return MCP4822_OK;
+}
+
+void MCP4822_stats_reset(MCP4822_Handle_t *handle){
+
+	if(handle->stats == NULL){
+		return;
+	}
+
+	uint32_t primask = MCP4822_port_irq_save();
+	clear_stats(handle->stats);
+	MCP4822_port_irq_restore(primask);
+}
+
+uint32_t MCP4822_stats_mean(const MCP4822_Stats_Api_t *api){
+
+	if(api->count == 0){
+		return 0;
+	}
+
+	return (uint32_t)((api->total + api->count / 2) / api->count);
+}
+
+uint32_t MCP4822_stats_tick_hz(void){
+
+	return MCP4822_port_tick_hz();
+}
+
+void MCP4822_stats_add(MCP4822_Stats_t *stats, MCP4822_STATS_API api, uint32_t ticks){
+
+	MCP4822_Stats_Api_t *summary = &stats->apis[api];
+
+	//Bucket by bit length, so each bucket spans twice the durations of the one before
+	uint32_t bucket = (ticks == 0) ? 0 : 32U - (uint32_t)__builtin_clz(ticks);
+	if(bucket >= MCP4822_STATS_BUCKETS){
+		bucket = MCP4822_STATS_BUCKETS - 1;
+	}
+
+	uint32_t primask = MCP4822_port_irq_save();
+
+	summary->count++;
+	summary->total += ticks;
+	summary->histogram[bucket]++;
+
+	if(ticks < summary->min){
+		summary->min = ticks;
+	}
+	if(ticks > summary->max){
+		summary->max = ticks;
+	}
+
+	MCP4822_port_irq_restore(primask);
+}
+
+static void clear_stats(MCP4822_Stats_t *stats){
+
+	memset(stats, 0, sizeof(MCP4822_Stats_t));
+
+	for(uint32_t i = 0; i < MCP4822_STATS_API_COUNT; i++){
+		stats->apis[i].min = UINT32_MAX;
+	}
+}
+
+#endif
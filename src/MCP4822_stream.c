@@ -0,0 +1,548 @@
+/*
+ * MCP4822_stream.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "MCP4822_stream.h"
+#include "MCP4822_fifo.h"
+#include "MCP4822_dispatch.h"
+
+/** Number of half-buffer events needed to play out the final data */
+#define STREAM_DRAIN_EVENTS			   2
+
+/** Sign bits and frame data bits of an L/R pair handled as one word */
+#define STEREO_SIGN_BITS			   0x80008000UL
+#define STEREO_DATA_MASK			   ((uint32_t)MCP4822_FRAME_DATA_MASK << 16 | MCP4822_FRAME_DATA_MASK)
+
+/**
+ * @brief Fills one half of the stream buffer from the refill callback
+ *
+ * @param stream - stream to be refilled
+ * @param frames - first frame of the half to be filled
+ *
+ * @return None
+ */
+static void refill_half(MCP4822_Stream_t *stream, uint16_t *frames);
+
+/**
+ * @brief Keeps the latest frame of each channel from a refill
+ *
+ * @param stream - stream being refilled
+ * @param frames - frames written by the refill callback
+ * @param written - number of frames written, at least 1
+ *
+ * @return None
+ */
+static void note_last_frames(MCP4822_Stream_t *stream, const uint16_t *frames, uint32_t written);
+
+/**
+ * @brief Stops the timer and DMA of a running stream, safe to call from its interrupts
+ *
+ * @param stream - stream to be halted
+ *
+ * @return MCP4822_PORT_OK in case of success, binding error status otherwise
+ */
+static MCP4822_PORT_STATUS halt_transfer(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Starts the timer-paced transfer, one frame per timer update event
+ *
+ * @param stream - stream to be started
+ * @param dma - timer update DMA channel
+ *
+ * @return MCP4822_PORT_OK in case of success, binding error status otherwise
+ */
+static MCP4822_PORT_STATUS start_paced_transfer(MCP4822_Stream_t *stream, MCP4822_Dma_t *dma);
+
+/**
+ * @brief Gives the timer update DMA channel its own owner and callbacks back
+ *
+ * @param stream - stream holding the channel
+ *
+ * @return None
+ */
+static void restore_dma_callbacks(MCP4822_Stream_t *stream);
+
+/**
+ * @brief Timer update DMA half transfer callback
+ *
+ * @param dma - DMA channel whose owner is the stream
+ *
+ * @return None
+ */
+static void paced_half_transfer_callback(MCP4822_Dma_t *dma);
+
+/**
+ * @brief Timer update DMA transfer complete callback
+ *
+ * @param dma - DMA channel whose owner is the stream
+ *
+ * @return None
+ */
+static void paced_transfer_complete_callback(MCP4822_Dma_t *dma);
+
+MCP4822_STATUS MCP4822_stream_init(MCP4822_Stream_t *stream, MCP4822_Handle_t *handle, uint16_t *buffer, uint32_t buffer_len,
+								   MCP4822_Stream_Refill_Cb refill, void *context){
+
+	//Without a refill callback the stream drains the handle's FIFO
+	if(refill == NULL && handle->fifo != NULL){
+		refill = MCP4822_fifo_stream_refill;
+		context = handle->fifo;
+	}
+
+	//Both halves must hold at least one frame and DMA length is limited to 16 bits
+	if(buffer == NULL || refill == NULL || buffer_len < 2 || (buffer_len & 1) || buffer_len > UINT16_MAX){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	stream->handle = handle;
+	stream->buffer = buffer;
+	stream->buffer_len = buffer_len;
+	stream->refill = refill;
+	stream->context = context;
+	stream->state = MCP4822_STREAM_IDLE;
+	stream->drain_count = 0;
+	stream->last_frames[MCP4822_CHANNEL_A] = MCP4822_encode_frame(handle, 0, MCP4822_CHANNEL_A);
+	stream->last_frames[MCP4822_CHANNEL_B] = MCP4822_encode_frame(handle, 0, MCP4822_CHANNEL_B);
+	stream->last_channel = MCP4822_CHANNEL_A;
+	stream->last_valid = 0;
+	stream->saved_format = MCP4822_port_spi_get_format(handle->hspi);
+	stream->format_saved = 0;
+	stream->paced_dma = NULL;
+	stream->pair_mode = 0;
+	stream->read_index = 0;
+	stream->pair_busy = 0;
+	stream->pair_loaded = 0;
+	stream->underruns = 0;
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_stream_start(MCP4822_Stream_t *stream){
+
+	if(stream->state != MCP4822_STREAM_IDLE){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	MCP4822_Spi_t *hspi = stream->handle->hspi;
+	MCP4822_Timer_t *htim = stream->handle->htim;
+
+	//Frames are only latched without CPU help if the SPI pulses NSS between them
+	if(stream->handle->cs_mode != MCP4822_CS_HARDWARE_NSS){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//The DMA channel feeding the SPI must wrap around the buffer on its own, one 16-bit frame per request
+	MCP4822_Dma_t *hdma = (htim != NULL) ? MCP4822_port_timer_dma(htim) : MCP4822_port_spi_tx_dma(hspi);
+	if(hdma == NULL || !MCP4822_port_dma_circular(hdma) || !MCP4822_port_dma_16bit(hdma)){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	//The SPI interrupts belong to the stream until it stops
+	if(MCP4822_dispatch_claim(hspi, MCP4822_DISPATCH_STREAM, stream) != MCP4822_OK){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	//Switch the SPI to one 16-bit word per frame, keeping the format a self-ended stream has not restored yet
+	if(!stream->format_saved){
+		stream->saved_format = MCP4822_port_spi_get_format(hspi);
+	}
+	if(MCP4822_port_spi_set_format(hspi, MCP4822_PORT_SPI_16BIT) != MCP4822_PORT_OK){
+		MCP4822_dispatch_release(hspi, stream);
+		return MCP4822_ERROR_SPI;
+	}
+	stream->format_saved = 1;
+
+	//Streamed frames bypass the blocking writes' redundancy check
+	MCP4822_invalidate_shadow(stream->handle);
+
+	//Pre-fill both halves before the DMA starts reading them
+	uint32_t half_len = stream->buffer_len / 2;
+	stream->state = MCP4822_STREAM_RUNNING;
+	stream->drain_count = 0;
+	stream->last_valid = 0;
+	stream->pair_mode = 0;
+	refill_half(stream, stream->buffer);
+	refill_half(stream, stream->buffer + half_len);
+
+	MCP4822_PORT_STATUS spi_status;
+	if(htim != NULL){
+		spi_status = start_paced_transfer(stream, hdma);
+	}
+	else{
+		spi_status = MCP4822_port_spi_transmit_dma(hspi, stream->buffer, (uint16_t)stream->buffer_len);
+	}
+
+	if(spi_status != MCP4822_PORT_OK){
+		stream->state = MCP4822_STREAM_IDLE;
+		MCP4822_port_spi_set_format(hspi, stream->saved_format);
+		stream->format_saved = 0;
+		MCP4822_dispatch_release(hspi, stream);
+		return MCP4822_ERROR_SPI;
+	}
+
+	return MCP4822_OK;
+}
+
+MCP4822_STATUS MCP4822_stream_start_pairs(MCP4822_Stream_t *stream){
+
+	if(stream->state != MCP4822_STREAM_IDLE){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	MCP4822_Handle_t *handle = stream->handle;
+	MCP4822_Spi_t *hspi = handle->hspi;
+	MCP4822_Dma_t *hdma = MCP4822_port_spi_tx_dma(hspi);
+
+	//Each half must hold whole pairs and every pair needs a tick and a latch
+	if(handle->htim == NULL || handle->LDAC_Port == NULL || hdma == NULL || !MCP4822_port_dma_16bit(hdma) ||
+	   (stream->buffer_len % 4) != 0 || handle->cs_mode != MCP4822_CS_HARDWARE_NSS){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	if(MCP4822_dispatch_claim(hspi, MCP4822_DISPATCH_STREAM, stream) != MCP4822_OK){
+		return MCP4822_ERROR_BUSY;
+	}
+
+	if(!stream->format_saved){
+		stream->saved_format = MCP4822_port_spi_get_format(hspi);
+	}
+	if(MCP4822_port_spi_set_format(hspi, MCP4822_PORT_SPI_16BIT) != MCP4822_PORT_OK){
+		MCP4822_dispatch_release(hspi, stream);
+		return MCP4822_ERROR_SPI;
+	}
+	stream->format_saved = 1;
+
+	MCP4822_invalidate_shadow(handle);
+
+	//Pre-fill both halves, the tick handler refills them as the read index crosses over
+	uint32_t half_len = stream->buffer_len / 2;
+	stream->state = MCP4822_STREAM_RUNNING;
+	stream->drain_count = 0;
+	stream->last_valid = 0;
+	stream->pair_mode = 1;
+	stream->read_index = 0;
+	stream->pair_busy = 0;
+	stream->pair_loaded = 0;
+	refill_half(stream, stream->buffer);
+	refill_half(stream, stream->buffer + half_len);
+
+	if(MCP4822_port_timer_start(handle->htim, 1) != MCP4822_PORT_OK){
+		stream->state = MCP4822_STREAM_IDLE;
+		stream->pair_mode = 0;
+		MCP4822_port_spi_set_format(hspi, stream->saved_format);
+		stream->format_saved = 0;
+		MCP4822_dispatch_release(hspi, stream);
+		return MCP4822_ERROR_SPI;
+	}
+
+	return MCP4822_OK;
+}
+
+void MCP4822_stream_pair_tick_handler(MCP4822_Stream_t *stream){
+
+	if(stream->state == MCP4822_STREAM_IDLE || !stream->pair_mode){
+		return;
+	}
+
+	//A pair still being clocked out has only reached part of the DAC, latching now would mix new A with old B
+	if(stream->pair_busy){
+		stream->underruns++;
+		return;
+	}
+
+	//Latch the pair completed since the previous tick before loading the next one, so the output timing stays on the tick
+	if(stream->pair_loaded){
+		stream->pair_loaded = 0;
+		MCP4822_pulse_ldac(stream->handle);
+	}
+
+	uint32_t half_len = stream->buffer_len / 2;
+	uint32_t index = stream->read_index;
+	uint8_t wrapped = (index == stream->buffer_len);
+	if(wrapped){
+		index = 0;
+	}
+
+	//Busy is set first, the completion interrupt may fire before the transmit call returns
+	stream->pair_busy = 1;
+	if(MCP4822_port_spi_transmit_dma(stream->handle->hspi, &stream->buffer[index], 2) != MCP4822_PORT_OK){
+		stream->pair_busy = 0;
+		stream->underruns++;
+		return;
+	}
+	stream->read_index = index + 2;
+
+	//Once the DMA reads from one half, every pair of the other half has been sent
+	if(index == half_len){
+		refill_half(stream, stream->buffer);
+	}
+	else if(wrapped){
+		refill_half(stream, stream->buffer + half_len);
+	}
+}
+
+MCP4822_STATUS MCP4822_stream_stop(MCP4822_Stream_t *stream){
+
+	MCP4822_PORT_STATUS spi_status = halt_transfer(stream);
+
+	//Re-initializing the SPI is left to thread context, a stream that ended by itself only halted the transfer
+	if(stream->format_saved){
+		if(MCP4822_port_spi_set_format(stream->handle->hspi, stream->saved_format) != MCP4822_PORT_OK){
+			spi_status = MCP4822_PORT_ERROR;
+		}
+		stream->format_saved = 0;
+	}
+
+	return (spi_status == MCP4822_PORT_OK) ? MCP4822_OK : MCP4822_ERROR_SPI;
+}
+
+void MCP4822_stream_pair_complete_handler(MCP4822_Stream_t *stream, uint8_t complete){
+
+	stream->pair_loaded = complete;
+	stream->pair_busy = 0;
+}
+
+void MCP4822_stream_half_transfer_handler(MCP4822_Stream_t *stream){
+
+	refill_half(stream, stream->buffer);
+}
+
+void MCP4822_stream_transfer_complete_handler(MCP4822_Stream_t *stream){
+
+	refill_half(stream, stream->buffer + stream->buffer_len / 2);
+}
+
+void MCP4822_stereo_encode(const MCP4822_Handle_t *handle, const int16_t *samples, uint16_t *frames, uint32_t pairs){
+
+	//Both headers sit in one word, laid out like an L/R pair in memory
+	uint32_t headers = ((uint32_t)MCP4822_encode_frame(handle, 0, MCP4822_CHANNEL_B) << 16) |
+					   MCP4822_encode_frame(handle, 0, MCP4822_CHANNEL_A);
+
+	for(uint32_t i = 0; i < pairs; i++){
+		uint32_t pair;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+		//Big-endian targets assemble the word by hand so left still lands in the low half
+		pair = ((uint32_t)(uint16_t)samples[2 * i + 1] << 16) | (uint16_t)samples[2 * i];
+#else
+		//Little-endian: the left sample is the low half of the word loaded from memory
+		memcpy(&pair, &samples[2 * i], sizeof(pair));
+#endif
+
+		//Flipping the sign bits offsets both samples to unsigned, the mask drops the bits shifted across halves
+		pair = (((pair ^ STEREO_SIGN_BITS) >> (16 - MCP4822_RES)) & STEREO_DATA_MASK) | headers;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+		frames[2 * i] = (uint16_t)pair;
+		frames[2 * i + 1] = (uint16_t)(pair >> 16);
+#else
+		memcpy(&frames[2 * i], &pair, sizeof(pair));
+#endif
+	}
+}
+
+MCP4822_STATUS MCP4822_stereo_init(MCP4822_Stereo_t *stereo, MCP4822_Handle_t *handle, const int16_t *samples, uint32_t pairs, uint8_t loop){
+
+	if(stereo == NULL || handle == NULL || samples == NULL || pairs == 0){
+		return MCP4822_ERROR_INVALID_ARG;
+	}
+
+	stereo->handle = handle;
+	stereo->samples = samples;
+	stereo->pairs = pairs;
+	stereo->position = 0;
+	stereo->loop = loop;
+	stereo->held = 0;
+	stereo->held_frame = 0;
+
+	return MCP4822_OK;
+}
+
+uint32_t MCP4822_stereo_refill(void *context, uint16_t *frames, uint32_t count){
+
+	MCP4822_Stereo_t *stereo = (MCP4822_Stereo_t *)context;
+	uint32_t written = 0;
+
+	//Finish the pair split across the previous refill
+	if(stereo->held && count > 0){
+		frames[written++] = stereo->held_frame;
+		stereo->held = 0;
+	}
+
+	while(written < count){
+
+		if(stereo->position == stereo->pairs){
+			if(!stereo->loop){
+				break;
+			}
+			stereo->position = 0;
+		}
+
+		uint32_t run = stereo->pairs - stereo->position;
+		uint32_t room = (count - written) / 2;
+
+		//An odd count leaves one slot: channel A goes out now and channel B opens the next refill
+		if(room == 0){
+			uint16_t pair[2];
+			MCP4822_stereo_encode(stereo->handle, &stereo->samples[2 * stereo->position], pair, 1);
+			stereo->position++;
+
+			frames[written++] = pair[0];
+			stereo->held_frame = pair[1];
+			stereo->held = 1;
+			break;
+		}
+
+		if(run > room){
+			run = room;
+		}
+
+		MCP4822_stereo_encode(stereo->handle, &stereo->samples[2 * stereo->position], &frames[written], run);
+
+		stereo->position += run;
+		written += 2 * run;
+	}
+
+	return written;
+}
+
+static void refill_half(MCP4822_Stream_t *stream, uint16_t *frames){
+
+	uint32_t half_len = stream->buffer_len / 2;
+	uint32_t written = 0;
+
+	if(stream->state == MCP4822_STREAM_IDLE){
+		return;
+	}
+
+	if(stream->state == MCP4822_STREAM_DRAINING){
+
+		//The final data has been played out once the drain events have passed, the SPI format waits for MCP4822_stream_stop
+		if(++stream->drain_count >= STREAM_DRAIN_EVENTS){
+			halt_transfer(stream);
+			return;
+		}
+	}
+	else{
+
+		written = stream->refill(stream->context, frames, half_len);
+		if(written > half_len){
+			written = half_len;
+		}
+
+		if(written > 0){
+			note_last_frames(stream, frames, written);
+		}
+
+		//A short refill marks the end of the stream
+		if(written < half_len){
+			stream->state = MCP4822_STREAM_DRAINING;
+		}
+	}
+
+	//Hold the last output level for any remaining slots, pairs keep channel A in even slots and B in odd ones
+	for(uint32_t i = written; i < half_len; i++){
+		frames[i] = stream->pair_mode ? stream->last_frames[i & 1] : stream->last_frames[stream->last_channel];
+	}
+}
+
+static void note_last_frames(MCP4822_Stream_t *stream, const uint16_t *frames, uint32_t written){
+
+	uint32_t first = (written > 2) ? written - 2 : 0;
+
+	//Interleaved A/B data carries the latest frame of both channels in its final two slots
+	for(uint32_t i = first; i < written; i++){
+		stream->last_frames[frames[i] >> MCP4822_FRAME_CHAN_POS] = frames[i];
+		stream->last_valid |= (uint8_t)(1U << (frames[i] >> MCP4822_FRAME_CHAN_POS));
+	}
+
+	stream->last_channel = (uint8_t)(frames[written - 1] >> MCP4822_FRAME_CHAN_POS);
+}
+
+static MCP4822_PORT_STATUS halt_transfer(MCP4822_Stream_t *stream){
+
+	MCP4822_PORT_STATUS spi_status = MCP4822_PORT_OK;
+
+	if(stream->state == MCP4822_STREAM_IDLE){
+		return MCP4822_PORT_OK;
+	}
+
+	stream->state = MCP4822_STREAM_IDLE;
+
+	//The levels the stream left on the outputs become the channels' last values for configuration changes
+	for(uint32_t chan = 0; chan < 2; chan++){
+		if(stream->last_valid & (1U << chan)){
+			MCP4822_note_frames(stream->handle, &stream->last_frames[chan], 1);
+		}
+	}
+
+	//Only timer and DMA registers are touched here, so the end of the data can stop the stream from its interrupt
+	if(stream->paced_dma != NULL){
+		MCP4822_Timer_t *htim = stream->handle->htim;
+
+		MCP4822_port_timer_stop(htim, 0);
+		MCP4822_port_timer_enable_dma(htim, 0);
+		spi_status = MCP4822_port_dma_abort(stream->paced_dma);
+
+		restore_dma_callbacks(stream);
+	}
+	else if(stream->pair_mode){
+		MCP4822_port_timer_stop(stream->handle->htim, 1);
+		spi_status = MCP4822_port_spi_stop_dma(stream->handle->hspi);
+		stream->pair_mode = 0;
+	}
+	else{
+		spi_status = MCP4822_port_spi_stop_dma(stream->handle->hspi);
+	}
+
+	MCP4822_dispatch_release(stream->handle->hspi, stream);
+
+	return spi_status;
+}
+
+static MCP4822_PORT_STATUS start_paced_transfer(MCP4822_Stream_t *stream, MCP4822_Dma_t *dma){
+
+	MCP4822_Timer_t *htim = stream->handle->htim;
+
+	//Route the DMA callbacks back to this stream while it owns the channel, the owner's are put back on stop
+	MCP4822_port_dma_hook(dma, stream, paced_half_transfer_callback, paced_transfer_complete_callback, &stream->saved_dma_hooks);
+	stream->paced_dma = dma;
+
+	//Each timer update moves one frame straight into the SPI data register
+	MCP4822_PORT_STATUS status = MCP4822_port_dma_start_to_spi(dma, stream->handle->hspi, stream->buffer, (uint16_t)stream->buffer_len);
+	if(status != MCP4822_PORT_OK){
+		restore_dma_callbacks(stream);
+		return status;
+	}
+
+	MCP4822_port_timer_enable_dma(htim, 1);
+
+	//A timer that will not start leaves nothing running on the channel
+	status = MCP4822_port_timer_start(htim, 0);
+	if(status != MCP4822_PORT_OK){
+		MCP4822_port_dma_abort(dma);
+		MCP4822_port_timer_enable_dma(htim, 0);
+		restore_dma_callbacks(stream);
+	}
+
+	return status;
+}
+
+static void restore_dma_callbacks(MCP4822_Stream_t *stream){
+
+	MCP4822_port_dma_unhook(stream->paced_dma, &stream->saved_dma_hooks);
+	stream->paced_dma = NULL;
+}
+
+static void paced_half_transfer_callback(MCP4822_Dma_t *dma){
+
+	MCP4822_stream_half_transfer_handler((MCP4822_Stream_t *)MCP4822_port_dma_context(dma));
+}
+
+static void paced_transfer_complete_callback(MCP4822_Dma_t *dma){
+
+	MCP4822_stream_transfer_complete_handler((MCP4822_Stream_t *)MCP4822_port_dma_context(dma));
+}
@@ -0,0 +1,118 @@
+/*
+ * bench_adpcm.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_adpcm.h"
+
+/** Packed asset size in bytes, two samples each */
+#define BENCH_BYTES					   4096
+
+/** Frames of one stream refill, half of a 192-frame ping-pong buffer */
+#define BENCH_BLOCK					   96
+
+/** Refills before the stream is back at the same position, some of them wrap around the loop point */
+#define BENCH_POSITIONS				   256
+
+/** Timed passes over the asset, the fastest one is reported */
+#define BENCH_PASSES				   100
+
+/** Times every refill position is timed, the fastest time of each is kept */
+#define BENCH_ROUNDS				   200
+
+static uint8_t asset[BENCH_BYTES];
+
+static uint16_t frames[BENCH_BYTES * 2];
+
+static uint64_t refill_best[BENCH_POSITIONS];
+
+/**
+ * @brief Fills the asset with one of the benchmark inputs
+ *
+ * @param pattern - 0 for pseudo-random codes, 1 for codes that take every add of the decoder
+ *
+ * @return None
+ */
+static void fill_asset(uint32_t pattern){
+
+	uint32_t seed = 0x12345678;
+
+	for(uint32_t i = 0; i < BENCH_BYTES; i++){
+		seed = seed * 1664525U + 1013904223U;
+		//0x7 and 0xF set all three magnitude bits and push the step index up
+		asset[i] = (pattern == 0) ? (uint8_t)(seed >> 24) : ((i & 1) ? 0xF7 : 0x7F);
+	}
+}
+
+/**
+ * @brief Reports the decode cost per sample and the slowest refill of one input
+ *
+ * @param device - devices of the test handle
+ * @param name - input name for the report
+ *
+ * @return None
+ */
+static void bench_input(Test_Device_t *device, const char *name){
+
+	MCP4822_ADPCM_Stream_t stream;
+	uint64_t best_decode = UINT64_MAX;
+	uint64_t worst_refill = 0;
+	uint64_t total_refill = 0;
+
+	for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+		MCP4822_ADPCM_State_t state = {0, 0};
+		uint64_t start = bench_now();
+		MCP4822_adpcm_decode_frames(&state, asset, 0, frames, BENCH_BYTES * 2, MCP4822_ADPCM_HIGH_NIBBLE_FIRST, 0);
+		uint64_t elapsed = bench_now() - start;
+		BENCH_KEEP(frames[BENCH_BYTES * 2 - 1]);
+		best_decode = (elapsed < best_decode) ? elapsed : best_decode;
+	}
+
+	//Time every refill position of a looping stream; the fastest time per position drops host interrupts, the slowest position is the worst case
+	MCP4822_adpcm_stream_init(&stream, &device->handle, MCP4822_CHANNEL_A, asset, BENCH_BYTES, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	stream.loop = 1;
+
+	for(uint32_t i = 0; i < BENCH_POSITIONS; i++){
+		refill_best[i] = UINT64_MAX;
+	}
+
+	for(uint32_t i = 0; i < BENCH_ROUNDS * BENCH_POSITIONS; i++){
+		uint64_t start = bench_now();
+		uint32_t written = MCP4822_adpcm_stream_refill(&stream, frames, BENCH_BLOCK);
+		uint64_t elapsed = bench_now() - start;
+		CHECK(written == BENCH_BLOCK);
+
+		uint64_t *best = &refill_best[i % BENCH_POSITIONS];
+		*best = (elapsed < *best) ? elapsed : *best;
+	}
+
+	for(uint32_t i = 0; i < BENCH_POSITIONS; i++){
+		total_refill += refill_best[i];
+		worst_refill = (refill_best[i] > worst_refill) ? refill_best[i] : worst_refill;
+	}
+
+	printf("  %-8s decode %5.2f %s/sample, refill of %u frames: mean %7.1f, worst %7llu %s\n",
+		   name, (double)best_decode / (BENCH_BYTES * 2), BENCH_UNIT, BENCH_BLOCK,
+		   (double)total_refill / BENCH_POSITIONS, (unsigned long long)worst_refill, BENCH_UNIT);
+}
+
+int main(void){
+
+	Test_Device_t device;
+
+	test_device_init(&device);
+
+	printf("IMA ADPCM stream decode (best of %u passes of %u samples, best of %u rounds per refill position):\n",
+		   BENCH_PASSES, BENCH_BYTES * 2, BENCH_ROUNDS);
+
+	fill_asset(0);
+	bench_input(&device, "random");
+	fill_asset(1);
+	bench_input(&device, "max-step");
+
+	printf("  a refill decodes a fixed number of samples, so its cost on target is the block length times the worst per-sample cost\n");
+
+	return test_result("bench_adpcm");
+}
@@ -0,0 +1,87 @@
+/*
+ * bench_block.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <math.h>
+#include <time.h>
+#include "test_common.h"
+#include "MCP4822_block.h"
+
+/** Samples per timed pass */
+#define BENCH_SAMPLES				   4096
+
+/** Timed passes, the fastest one is reported */
+#define BENCH_PASSES				   2000
+
+static float volts[BENCH_SAMPLES];
+
+static uint16_t frames[BENCH_SAMPLES + 1];
+
+/**
+ * @brief Reads the wall clock for the samples per second figure
+ *
+ * @return Nanoseconds from the monotonic clock
+ */
+static uint64_t wall_now(void){
+
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+}
+
+int main(void){
+
+	Test_Device_t device;
+	MCP4822_Handle_t *handle = &device.handle;
+	uint64_t best = UINT64_MAX;
+	uint64_t best_wall = UINT64_MAX;
+	uint32_t wrong = 0;
+
+	test_device_init(&device);
+
+#if defined(MCP4822_BLOCK_KERNEL_AVX2) && (defined(__x86_64__) || defined(__i386__))
+	if(!__builtin_cpu_supports("avx2")){
+		printf("block conversion, kernel avx2: skipped, the CPU has no AVX2\n");
+		return test_result("bench_block");
+	}
+#endif
+
+	//Sweep past both ends of the 2X range, with a NaN and infinities among the samples
+	for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+		volts[i] = -0.5f + (float)i * (5.0f / BENCH_SAMPLES);
+	}
+	volts[7] = NAN;
+	volts[8] = INFINITY;
+	volts[9] = -INFINITY;
+
+	//Every kernel must give the per-sample conversion's code, at both output alignments
+	for(uint32_t shift = 0; shift < 2; shift++){
+		MCP4822_volts_to_frames(handle, volts, &frames[shift], BENCH_SAMPLES, MCP4822_CHANNEL_B);
+		for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+			uint16_t expected = MCP4822_encode_frame(handle, MCP4822_volts_to_chan_units(handle, volts[i], MCP4822_CHANNEL_B), MCP4822_CHANNEL_B);
+			wrong += (frames[shift + i] != expected);
+		}
+	}
+	CHECK(wrong == 0);
+
+	for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+		uint64_t start_wall = wall_now();
+		uint64_t start = bench_now();
+		MCP4822_volts_to_frames(handle, volts, frames, BENCH_SAMPLES, MCP4822_CHANNEL_A);
+		uint64_t elapsed = bench_now() - start;
+		uint64_t elapsed_wall = wall_now() - start_wall;
+		BENCH_KEEP(frames[BENCH_SAMPLES - 1]);
+
+		best = (elapsed < best) ? elapsed : best;
+		best_wall = (elapsed_wall < best_wall) ? elapsed_wall : best_wall;
+	}
+
+	printf("block conversion, kernel %s (best of %u passes of %u samples):\n", MCP4822_block_kernel_name(), BENCH_PASSES, BENCH_SAMPLES);
+	printf("  %6.3f %s per sample, %7.1f Msamples/s, %u frames off the per-sample conversion\n",
+		   (double)best / BENCH_SAMPLES, BENCH_UNIT, BENCH_SAMPLES * 1e3 / (double)best_wall, wrong);
+
+	return test_result("bench_block");
+}
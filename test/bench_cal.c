@@ -0,0 +1,110 @@
+/*
+ * bench_cal.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_cal.h"
+#include "MCP4822_block.h"
+
+/** Samples per timed pass, a 1024-frame half buffer */
+#define BENCH_SAMPLES				   1024
+
+/** Timed passes, the fastest one is reported */
+#define BENCH_PASSES				   2000
+
+static float volts[BENCH_SAMPLES];
+
+static uint16_t codes[BENCH_SAMPLES];
+
+static uint16_t frames[BENCH_SAMPLES];
+
+static uint16_t lut[MCP4822_CAL_LUT_SIZE];
+
+/**
+ * @brief Times a pass over the samples and keeps the fastest one
+ */
+#define BENCH_PASS(best, call)														\
+	do{																				\
+		for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){						\
+			uint64_t start = bench_now();											\
+			call;																	\
+			uint64_t elapsed = bench_now() - start;									\
+			BENCH_KEEP(frames[BENCH_SAMPLES - 1]);									\
+			(best) = (elapsed < (best)) ? elapsed : (best);							\
+		}																			\
+	}while(0)
+
+/**
+ * @brief Corrects every code one at a time, as the single-code write paths do
+ *
+ * @param cal - calibration
+ *
+ * @return None
+ */
+static void apply_codes(const MCP4822_Cal_t *cal){
+
+	for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+		frames[i] = MCP4822_cal_apply(cal, MCP4822_CHANNEL_A, MCP4822_GAIN_1X, codes[i]);
+	}
+}
+
+int main(void){
+
+	static const char *names[] = { "none", "gain/offset", "table" };
+	Test_Device_t device;
+	MCP4822_Cal_t cal;
+	uint32_t seed = 0x9E3779B9;
+
+	test_device_init(&device);
+
+	for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+		seed = seed * 1664525U + 1013904223U;
+		codes[i] = (uint16_t)((seed >> 16) & MCP4822_DAC_MAX);
+		volts[i] = (float)codes[i] / 2000.0f;
+	}
+
+	//A table with a bow in the middle, as an INL correction would have
+	for(uint32_t code = 0; code < MCP4822_CAL_LUT_SIZE; code++){
+		int32_t bowed = (int32_t)code + (int32_t)((code * (MCP4822_DAC_MAX - code)) >> 20) + 3;
+		lut[code] = (uint16_t)((bowed > MCP4822_DAC_MAX) ? MCP4822_DAC_MAX : bowed);
+	}
+
+	printf("calibration, %s per sample (best of %u passes of %u samples):\n", BENCH_UNIT, BENCH_PASSES, BENCH_SAMPLES);
+	printf("  %-12s %12s %12s %14s\n", "correction", "cal_apply", "apply_frames", "volts_to_frames");
+
+	for(uint32_t mode = 0; mode < 3; mode++){
+		uint64_t best_codes = UINT64_MAX;
+		uint64_t best_frames = UINT64_MAX;
+		uint64_t best_volts = UINT64_MAX;
+
+		MCP4822_cal_init(&cal);
+		if(mode == 1){
+			cal.chans[MCP4822_CHANNEL_A][MCP4822_GAIN_1X].gain_q16 = 66191;
+			cal.chans[MCP4822_CHANNEL_A][MCP4822_GAIN_1X].offset_q16 = -327680;
+		}
+		else if(mode == 2){
+			cal.chans[MCP4822_CHANNEL_A][MCP4822_GAIN_1X].lut = lut;
+		}
+		MCP4822_attach_cal(&device.handle, (mode == 0) ? NULL : &cal);
+
+		if(mode != 0){
+			BENCH_PASS(best_codes, apply_codes(&cal));
+			BENCH_PASS(best_frames, MCP4822_cal_apply_frames(&cal, MCP4822_CHANNEL_A, MCP4822_GAIN_1X, frames, BENCH_SAMPLES));
+		}
+		BENCH_PASS(best_volts, MCP4822_volts_to_frames(&device.handle, volts, frames, BENCH_SAMPLES, MCP4822_CHANNEL_A));
+
+		if(mode == 0){
+			printf("  %-12s %12s %12s %14.2f\n", names[mode], "-", "-", (double)best_volts / BENCH_SAMPLES);
+		}
+		else{
+			printf("  %-12s %12.2f %12.2f %14.2f\n", names[mode], (double)best_codes / BENCH_SAMPLES, (double)best_frames / BENCH_SAMPLES,
+				   (double)best_volts / BENCH_SAMPLES);
+		}
+	}
+
+	MCP4822_attach_cal(&device.handle, NULL);
+
+	return test_result("bench_cal");
+}
@@ -0,0 +1,75 @@
+/*
+ * bench_dds.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_dds.h"
+
+/** Frames per timed render, a 1024-frame half buffer */
+#define BENCH_FRAMES				   1024
+
+/** Timed renders, the fastest one is reported */
+#define BENCH_PASSES				   2000
+
+/** 12-bit wavetable for MCP4822_WAVE_TABLE */
+#define BENCH_TABLE_BITS			   8
+
+static uint16_t frames[BENCH_FRAMES];
+
+static uint16_t table[1 << BENCH_TABLE_BITS];
+
+/**
+ * @brief Times rendering into frames and keeps the fastest pass
+ */
+#define BENCH_RENDER(best, call)													\
+	do{																				\
+		for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){						\
+			uint64_t start = bench_now();											\
+			call;																	\
+			uint64_t elapsed = bench_now() - start;									\
+			BENCH_KEEP(frames[BENCH_FRAMES - 1]);									\
+			(best) = (elapsed < (best)) ? elapsed : (best);							\
+		}																			\
+	}while(0)
+
+int main(void){
+
+	static const char *names[] = { "sine", "triangle", "sawtooth", "square", "table" };
+	Test_Device_t device;
+	MCP4822_DDS_t dds;
+
+	test_device_init(&device);
+
+	for(uint32_t i = 0; i < (1 << BENCH_TABLE_BITS); i++){
+		table[i] = (uint16_t)((i * 37) & MCP4822_DAC_MAX);
+	}
+
+	printf("DDS, %s per frame (best of %u passes of %u frames):\n", BENCH_UNIT, BENCH_PASSES, BENCH_FRAMES);
+
+	for(uint32_t w = MCP4822_WAVE_SINE; w <= MCP4822_WAVE_TABLE; w++){
+		uint64_t best_full = UINT64_MAX;
+		uint64_t best_scaled = UINT64_MAX;
+
+		CHECK(MCP4822_dds_init(&dds, &device.handle, 48000) == MCP4822_OK);
+		CHECK(MCP4822_dds_set_table(&dds, MCP4822_CHANNEL_A, table, BENCH_TABLE_BITS) == MCP4822_OK);
+
+		CHECK(MCP4822_dds_configure(&dds, MCP4822_CHANNEL_A, (MCP4822_WAVEFORM)w, 1234567, MCP4822_DDS_FULL_SCALE) == MCP4822_OK);
+		BENCH_RENDER(best_full, MCP4822_dds_render(&dds, MCP4822_CHANNEL_A, frames, BENCH_FRAMES));
+
+		CHECK(MCP4822_dds_configure(&dds, MCP4822_CHANNEL_A, (MCP4822_WAVEFORM)w, 1234567, 20000) == MCP4822_OK);
+		BENCH_RENDER(best_scaled, MCP4822_dds_render(&dds, MCP4822_CHANNEL_A, frames, BENCH_FRAMES));
+
+		printf("  %-9s full scale %5.2f, scaled %5.2f\n", names[w], (double)best_full / BENCH_FRAMES, (double)best_scaled / BENCH_FRAMES);
+	}
+
+	//Both channels interleaved, with an odd count so the held channel B frame is part of the cost
+	uint64_t best_pairs = UINT64_MAX;
+	CHECK(MCP4822_dds_configure(&dds, MCP4822_CHANNEL_A, MCP4822_WAVE_SINE, 1000000, MCP4822_DDS_FULL_SCALE) == MCP4822_OK);
+	CHECK(MCP4822_dds_configure(&dds, MCP4822_CHANNEL_B, MCP4822_WAVE_SINE, 1500000, MCP4822_DDS_FULL_SCALE) == MCP4822_OK);
+	BENCH_RENDER(best_pairs, CHECK(MCP4822_dds_refill(&dds, frames, BENCH_FRAMES - 1) == BENCH_FRAMES - 1));
+	printf("  refill A/B sine pairs, odd count %5.2f\n", (double)best_pairs / (BENCH_FRAMES - 1));
+
+	return test_result("bench_dds");
+}
@@ -0,0 +1,72 @@
+/*
+ * bench_mixer.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_mixer.h"
+
+/** Most voices benchmarked */
+#define BENCH_VOICES_MAX			   32
+
+/** Frame pairs per refill, a 256-frame half buffer */
+#define BENCH_PAIRS					   128
+
+/** Timed refills, the fastest one is reported */
+#define BENCH_PASSES				   2000
+
+static uint16_t frames[BENCH_PAIRS * 2];
+
+static uint32_t ramp_source(void *context, int16_t *samples, uint32_t count){
+
+	uint16_t *phase = (uint16_t *)context;
+
+	//A sawtooth costs next to nothing, so the time is the mixer's
+	for(uint32_t i = 0; i < count; i++){
+		*phase += 523;
+		samples[i] = (int16_t)*phase;
+	}
+
+	return count;
+}
+
+int main(void){
+
+	static const uint32_t voice_counts[] = { 1, 4, 8, 16, BENCH_VOICES_MAX };
+	Test_Device_t device;
+	MCP4822_Mixer_t mixer;
+	MCP4822_Mixer_Voice_t voices[BENCH_VOICES_MAX];
+	uint16_t phases[BENCH_VOICES_MAX];
+
+	test_device_init(&device);
+
+	printf("mixer refill of %u frame pairs, %s (best of %u refills):\n", BENCH_PAIRS, BENCH_UNIT, BENCH_PASSES);
+
+	for(uint32_t n = 0; n < sizeof(voice_counts) / sizeof(voice_counts[0]); n++){
+		uint32_t count = voice_counts[n];
+		uint64_t best = UINT64_MAX;
+
+		CHECK(MCP4822_mixer_init(&mixer, &device.handle, voices, count) == MCP4822_OK);
+		for(uint32_t v = 0; v < count; v++){
+			phases[v] = (uint16_t)(v * 4099);
+			CHECK(MCP4822_mixer_play(&mixer, v, ramp_source, &phases[v], MCP4822_MIXER_UNITY / count, (int16_t)((int32_t)v * 2048 - 32768)) == MCP4822_OK);
+		}
+
+		for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+			uint64_t start = bench_now();
+			CHECK(MCP4822_mixer_refill(&mixer, frames, BENCH_PAIRS * 2) == BENCH_PAIRS * 2);
+			uint64_t elapsed = bench_now() - start;
+			BENCH_KEEP(frames[0]);
+
+			best = (elapsed < best) ? elapsed : best;
+		}
+
+		printf("  %2u voices  %8llu per refill  %6.2f per pair  %5.2f per voice sample\n", count, (unsigned long long)best,
+			   (double)best / BENCH_PAIRS, (double)best / BENCH_PAIRS / count);
+	}
+
+	printf("  sums are 64-bit, on Cortex-M each product is one SMLAL into a register pair\n");
+
+	return test_result("bench_mixer");
+}
@@ -0,0 +1,95 @@
+/*
+ * bench_resample.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_resample.h"
+
+/** Output samples per timed read, a 256-frame half buffer */
+#define BENCH_SAMPLES				   256
+
+/** Timed reads, the fastest one is reported */
+#define BENCH_PASSES				   2000
+
+/** Length of the looped noise the source plays */
+#define BENCH_NOISE					   4096
+
+static int16_t noise[BENCH_NOISE];
+
+static int16_t samples[BENCH_SAMPLES];
+
+static uint32_t noise_source(void *context, int16_t *out, uint32_t count){
+
+	uint32_t *position = (uint32_t *)context;
+
+	//A copy costs next to nothing next to the filters, so the time is the resampler's
+	for(uint32_t done = 0; done < count;){
+		uint32_t run = BENCH_NOISE - *position;
+		run = (run < count - done) ? run : count - done;
+
+		memcpy(&out[done], &noise[*position], run * sizeof(int16_t));
+		done += run;
+		*position = (*position + run) % BENCH_NOISE;
+	}
+
+	return count;
+}
+
+int main(void){
+
+	static const char *names[] = { "nearest", "linear", "sinc8", "sinc16" };
+	static const uint32_t rates[][2] = { {44100, 48000}, {48000, 44100}, {48000, 16000}, {48000, 8000} };
+	Test_Device_t device;
+	MCP4822_Resampler_t resampler;
+	uint32_t seed = 0x2545F491;
+
+	test_device_init(&device);
+
+	for(uint32_t i = 0; i < BENCH_NOISE; i++){
+		seed = seed * 1664525U + 1013904223U;
+		noise[i] = (int16_t)(seed >> 16);
+	}
+
+	printf("resampler, %s per output sample (best of %u reads of %u samples):\n", BENCH_UNIT, BENCH_PASSES, BENCH_SAMPLES);
+	printf("  %-8s", "");
+	for(uint32_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++){
+		printf("  %5u->%-5u", rates[r][0], rates[r][1]);
+	}
+	printf("\n");
+
+	for(uint32_t q = MCP4822_RESAMPLE_NEAREST; q <= MCP4822_RESAMPLE_SINC16; q++){
+		printf("  %-8s", names[q]);
+
+		for(uint32_t r = 0; r < sizeof(rates) / sizeof(rates[0]); r++){
+			uint32_t position = 0;
+			uint64_t best = UINT64_MAX;
+
+			if(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, noise_source, &position, (MCP4822_RESAMPLE_QUALITY)q,
+									 rates[r][0], rates[r][1]) != MCP4822_OK){
+				//Converting down this far needs more taps than MCP4822_RESAMPLE_TAPS_MAX
+				printf("  %11s", "rejected");
+				continue;
+			}
+
+			for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+				uint64_t start = bench_now();
+				CHECK(MCP4822_resample_read(&resampler, samples, BENCH_SAMPLES) == BENCH_SAMPLES);
+				uint64_t elapsed = bench_now() - start;
+				BENCH_KEEP(samples[BENCH_SAMPLES - 1]);
+
+				best = (elapsed < best) ? elapsed : best;
+			}
+
+			printf("  %5.1f (%2u)", (double)best / BENCH_SAMPLES, resampler.taps);
+		}
+
+		printf("\n");
+	}
+
+	printf("  taps in brackets, a downward sinc conversion stretches the kernel over input / output times the taps\n");
+
+	return test_result("bench_resample");
+}
@@ -0,0 +1,157 @@
+/*
+ * bench_seek.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_asset.h"
+
+/** Samples of the benchmark asset, two per payload byte */
+#define BENCH_SAMPLES				   65536
+
+/** Smallest seek interval benchmarked, sizes the image buffer */
+#define BENCH_INTERVAL_MIN			   64
+
+/** Random seeks timed per interval */
+#define BENCH_SEEKS					   2000
+
+/** Asset image: header, largest seek table, payload */
+static uint32_t image[(sizeof(MCP4822_Asset_Header_t) + (BENCH_SAMPLES / BENCH_INTERVAL_MIN) * sizeof(MCP4822_Asset_Seek_t) +
+					   BENCH_SAMPLES / 2) / sizeof(uint32_t) + 1];
+
+static uint8_t payload[BENCH_SAMPLES / 2];
+
+/**
+ * @brief Builds an ADPCM asset image over the payload, with a seek table when interval is not 0
+ *
+ * @param interval - samples between seek snapshots, 0 for no table
+ *
+ * @return Image size in bytes
+ */
+static uint32_t build_image(uint32_t interval){
+
+	MCP4822_Asset_Header_t *header = (MCP4822_Asset_Header_t *)image;
+	MCP4822_Asset_Seek_t *table = (MCP4822_Asset_Seek_t *)&header[1];
+	uint32_t entries = (interval != 0) ? MCP4822_asset_seek_entries(BENCH_SAMPLES, interval) : 0;
+
+	memset(header, 0, sizeof(*header));
+	header->magic = MCP4822_ASSET_MAGIC;
+	header->version = MCP4822_ASSET_VERSION;
+	header->codec = MCP4822_CODEC_IMA_ADPCM;
+	header->layout = MCP4822_LAYOUT_MONO;
+	header->flags = (interval != 0) ? MCP4822_ASSET_FLAG_SEEK_TABLE : 0;
+	header->sample_rate = 16000;
+	header->sample_count = BENCH_SAMPLES;
+	header->loop_end = BENCH_SAMPLES;
+	header->block_size = 64;
+	header->header_size = (uint16_t)(sizeof(*header) + entries * sizeof(MCP4822_Asset_Seek_t));
+	header->payload_size = sizeof(payload);
+	header->seek_interval = (uint16_t)interval;
+
+	//Snapshots are the decoder state in front of every interval, as the asset compiler writes them
+	MCP4822_ADPCM_State_t state = {0, 0};
+	for(uint32_t i = 0; i < entries; i++){
+		table[i].predictor = state.predictor;
+		table[i].step_index = state.step_index;
+		table[i].reserved = 0;
+		MCP4822_adpcm_skip(&state, payload, i * interval, interval, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	}
+
+	memcpy((uint8_t *)image + header->header_size, payload, sizeof(payload));
+
+	return header->header_size + sizeof(payload);
+}
+
+/**
+ * @brief Times one seek
+ *
+ * @param player - player to be moved
+ * @param sample - target sample
+ *
+ * @return Elapsed benchmark clock
+ */
+static uint64_t time_seek(MCP4822_Asset_Player_t *player, uint32_t sample){
+
+	uint64_t start = bench_now();
+	MCP4822_STATUS status = MCP4822_asset_player_seek(player, sample);
+	uint64_t elapsed = bench_now() - start;
+
+	CHECK(status == MCP4822_OK);
+
+	return elapsed;
+}
+
+/**
+ * @brief Reports the seek latency of one interval and checks the state the seeks land on
+ *
+ * @param device - devices of the test handle
+ * @param interval - samples between seek snapshots, 0 for no table
+ *
+ * @return None
+ */
+static void bench_interval(Test_Device_t *device, uint32_t interval){
+
+	MCP4822_Asset_t asset;
+	MCP4822_Asset_Player_t player;
+	uint32_t seed = 0x2545F491;
+	uint64_t total = 0;
+	uint64_t total_worst = 0;
+	uint32_t wrong = 0;
+
+	uint32_t size = build_image(interval);
+	CHECK(MCP4822_asset_load(image, size, &asset) == MCP4822_OK);
+	MCP4822_asset_player_init(&player, &device->handle, MCP4822_CHANNEL_A, &asset);
+
+	for(uint32_t i = 0; i < BENCH_SEEKS; i++){
+		seed = seed * 1664525U + 1013904223U;
+		uint32_t sample = seed % BENCH_SAMPLES;
+
+		total += time_seek(&player, sample);
+
+		//The state must match decoding from the start
+		MCP4822_ADPCM_State_t state = {0, 0};
+		MCP4822_adpcm_skip(&state, payload, 0, sample, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+		wrong += (state.predictor != player.state.predictor || state.step_index != player.state.step_index);
+	}
+
+	//The sample in front of each snapshot is the longest seek from the previous one; each is timed
+	//once, as repeating the same target lets the host branch predictor learn its nibbles
+	uint32_t span = (interval != 0) ? interval : BENCH_SAMPLES;
+	uint32_t targets = BENCH_SAMPLES / span;
+	for(uint32_t k = 1; k <= targets; k++){
+		total_worst += time_seek(&player, k * span - 1);
+	}
+
+	CHECK(wrong == 0);
+
+	uint32_t table_bytes = (interval != 0) ? MCP4822_asset_seek_entries(BENCH_SAMPLES, interval) * (uint32_t)sizeof(MCP4822_Asset_Seek_t) : 0;
+	printf("  interval %5u  %5u table bytes  random %10.1f  worst case %10.1f %s\n", interval, table_bytes,
+		   (double)total / BENCH_SEEKS, (double)total_worst / targets, BENCH_UNIT);
+}
+
+int main(void){
+
+	Test_Device_t device;
+	uint32_t seed = 0x9E3779B9;
+
+	test_device_init(&device);
+
+	for(uint32_t i = 0; i < sizeof(payload); i++){
+		seed = seed * 1664525U + 1013904223U;
+		payload[i] = (uint8_t)(seed >> 24);
+	}
+
+	printf("ADPCM seek latency over a %u-sample asset, mean of %u random seeks and of the seeks to the sample before each snapshot\n",
+		   BENCH_SAMPLES, BENCH_SEEKS);
+	printf("(interval 0 has no seek table and decodes from the start):\n");
+
+	bench_interval(&device, 0);
+	bench_interval(&device, 4096);
+	bench_interval(&device, 1024);
+	bench_interval(&device, 256);
+	bench_interval(&device, BENCH_INTERVAL_MIN);
+
+	return test_result("bench_seek");
+}
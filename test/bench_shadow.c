@@ -0,0 +1,145 @@
+/*
+ * bench_shadow.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <math.h>
+#include "test_common.h"
+
+/** Control loop rate of the replayed trace */
+#define BENCH_RATE_HZ				   10000
+
+/** Length of the replayed trace */
+#define BENCH_SECONDS				   60
+
+/** Loop iterations in the trace, one channel A and one channel B setpoint each */
+#define BENCH_STEPS					   (BENCH_RATE_HZ * BENCH_SECONDS)
+
+/** SPI time of one frame with CS framing, a 16-bit word at 10 MHz plus select and deselect */
+#define BENCH_FRAME_US				   2.1
+
+/** Output deadband of the last replay, in codes */
+#define BENCH_DEADBAND				   2
+
+static uint16_t trace_a[BENCH_STEPS];
+
+static uint16_t trace_b[BENCH_STEPS];
+
+/**
+ * @brief Records the outputs of a PI loop holding a first-order plant on a setpoint
+ *
+ * Channel A is the controller output, chasing steps and a ramp through sensor
+ * noise of about 0.4 LSB rms. Channel B is a slow bias drifting a few codes
+ * over the whole trace.
+ *
+ * @return None
+ */
+static void record_trace(void){
+
+	const double dt = 1.0 / BENCH_RATE_HZ;
+	const double tau = 0.005;
+	const double kp = 0.8;
+	const double ki = 150.0;
+	const double pi = 3.14159265358979323846;
+	double plant = 0.0;
+	double integral = 0.0;
+	uint32_t seed = 0x6C078965;
+
+	for(uint32_t n = 0; n < BENCH_STEPS; n++){
+		double t = n * dt;
+		double setpoint;
+
+		//Steps every 10 s, then a ramp and a final hold
+		if(t < 40.0){
+			static const double levels[] = { 800.0, 2500.0, 1200.0, 3300.0 };
+			setpoint = levels[(uint32_t)(t / 10.0)];
+		}
+		else if(t < 50.0){
+			setpoint = 3300.0 - (t - 40.0) * 250.0;
+		}
+		else{
+			setpoint = 800.0;
+		}
+
+		//Sum of three uniforms, close to normal, scaled to 0.4 LSB rms
+		double noise = 0.0;
+		for(uint32_t k = 0; k < 3; k++){
+			seed = seed * 1664525U + 1013904223U;
+			noise += (double)(seed >> 8) / (double)(1U << 24) - 0.5;
+		}
+		noise *= 0.4 * 2.0;
+
+		double error = setpoint - (plant + noise);
+		integral += ki * error * dt;
+		double output = kp * error + integral;
+		output = (output < 0.0) ? 0.0 : (output > MCP4822_DAC_MAX) ? MCP4822_DAC_MAX : output;
+
+		trace_a[n] = (uint16_t)lrint(output);
+		trace_b[n] = (uint16_t)lrint(2048.0 + 6.0 * sin(2.0 * pi * t / BENCH_SECONDS));
+
+		plant += (trace_a[n] - plant) * dt / tau;
+	}
+}
+
+/**
+ * @brief Replays the trace through MCP4822_write_pair and reports the bus time used
+ *
+ * @param name - label of the replay
+ * @param force - non-zero to send every frame
+ * @param deadband - codes an output must move before it is written again, 0 to write every setpoint
+ *
+ * @return Frames sent
+ */
+static uint32_t replay(const char *name, uint8_t force, uint16_t deadband){
+
+	Test_Device_t device;
+	uint16_t held_a = 0;
+	uint16_t held_b = 0;
+
+	test_device_init(&device);
+	device.spi.tx_dma = NULL;
+	MCP4822_set_force_writes(&device.handle, force);
+
+	uint64_t start = bench_now();
+	for(uint32_t n = 0; n < BENCH_STEPS; n++){
+
+		//The deadband is the application's, the driver only drops exact repeats
+		if(n == 0 || abs((int32_t)trace_a[n] - held_a) >= deadband){
+			held_a = trace_a[n];
+		}
+		if(n == 0 || abs((int32_t)trace_b[n] - held_b) >= deadband){
+			held_b = trace_b[n];
+		}
+
+		CHECK(MCP4822_write_pair(&device.handle, held_a, held_b) == MCP4822_OK);
+	}
+	uint64_t elapsed = bench_now() - start;
+
+	double busy = device.spi.frames * BENCH_FRAME_US * 1e-6 / BENCH_SECONDS;
+
+	printf("  %-24s %9u frames %9u suppressed  %5.2f %% bus busy  %6.1f %s per pair\n", name, device.spi.frames,
+		   device.handle.frames_suppressed, busy * 100.0, (double)elapsed / BENCH_STEPS, BENCH_UNIT);
+
+	CHECK(device.handle.frames_sent == device.spi.frames);
+	CHECK(device.handle.frames_sent + device.handle.frames_suppressed == 2 * BENCH_STEPS);
+
+	return device.spi.frames;
+}
+
+int main(void){
+
+	record_trace();
+
+	printf("replayed %u s PI loop at %u Hz, %.1f us per frame:\n", BENCH_SECONDS, BENCH_RATE_HZ, BENCH_FRAME_US);
+
+	uint32_t forced = replay("forced", 1, 0);
+	uint32_t suppressed = replay("suppressed", 0, 0);
+	uint32_t deadband = replay("suppressed, 2 LSB band", 0, BENCH_DEADBAND);
+
+	CHECK(forced == 2 * BENCH_STEPS);
+	CHECK(suppressed < forced / 2);
+	CHECK(deadband < suppressed);
+
+	return test_result("bench_shadow");
+}
@@ -0,0 +1,102 @@
+/*
+ * bench_spi.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "stm32_standin.h"
+
+/**
+ * Cost of one blocking MCP4822_write_to_chan with the default STM32 binding,
+ * built once for HAL_SPI_Transmit and once with MCP4822_USE_LL_SPI. Register
+ * accesses are counted on the stand-in (see stm32_standin.h); time is the
+ * host's and only shows the software around the accesses. Target cycles come
+ * from the DWT counter with MCP4822_ENABLE_STATS.
+ */
+
+#ifdef MCP4822_USE_LL_SPI
+#define BENCH_BACKEND				   "LL registers"
+#else
+#define BENCH_BACKEND				   "HAL_SPI_Transmit"
+#endif
+
+/** Writes per counted run */
+#define BENCH_COUNTED				   64
+
+/** Writes per timed pass */
+#define BENCH_WRITES				   4096
+
+/** Timed passes, the fastest one is reported */
+#define BENCH_PASSES				   200
+
+int main(void){
+
+	SPI_HandleTypeDef hspi = {0};
+	MCP4822_Handle_t handle;
+	Standin_Counts_t counts;
+	uint64_t best = UINT64_MAX;
+
+	standin_reset();
+	hspi.Instance = standin_spi;
+	hspi.Init.Mode = SPI_MODE_MASTER;
+	hspi.Init.Direction = SPI_DIRECTION_2LINES;
+	hspi.Init.DataSize = SPI_DATASIZE_16BIT;
+	hspi.Init.CLKPhase = SPI_PHASE_1EDGE;
+	hspi.Init.NSS = SPI_NSS_SOFT;
+	HAL_SPI_Init(&hspi);
+
+	CHECK(MCP4822_handle_init(&handle, standin_gpio, 1, &hspi) == MCP4822_OK);
+
+	//The first transfer enables the SPI, steady state starts after it
+	CHECK(MCP4822_write_to_chan(&handle, 0, MCP4822_CHANNEL_A) == MCP4822_OK);
+
+	printf("MCP4822_write_to_chan, %s backend:\n", BENCH_BACKEND);
+
+	if(standin_can_count()){
+		uint32_t status = 0;
+
+		standin_count_begin();
+		for(uint32_t i = 0; i < BENCH_COUNTED; i++){
+			status |= MCP4822_write_to_chan(&handle, (uint16_t)(i + 1), (MCP4822_DAC_SELECT)(i & 1));
+		}
+		standin_count_end(&counts);
+		CHECK(status == MCP4822_OK);
+
+		uint32_t reads = 0;
+		uint32_t writes = 0;
+		for(uint32_t r = 0; r < 7; r++){
+			reads += counts.spi_reads[r];
+			writes += counts.spi_writes[r];
+		}
+		CHECK(counts.spi_writes[STANDIN_SPI_DR] == BENCH_COUNTED);
+
+		double per_write = 1.0 / BENCH_COUNTED;
+		printf("  SPI register reads   %6.2f per write (CR1 %.2f, SR %.2f, DR %.2f)\n", reads * per_write,
+			   counts.spi_reads[STANDIN_SPI_CR1] * per_write, counts.spi_reads[STANDIN_SPI_SR] * per_write,
+			   counts.spi_reads[STANDIN_SPI_DR] * per_write);
+		printf("  SPI register writes  %6.2f per write\n", writes * per_write);
+		printf("  GPIO register writes %6.2f per write\n", counts.gpio_writes * per_write);
+		printf("  HAL_GetTick calls    %6.2f per write\n", counts.ticks * per_write);
+	}
+	else{
+		printf("  register counting needs x86-64 Linux, skipped\n");
+	}
+
+	for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+		uint32_t status = 0;
+
+		uint64_t start = bench_now();
+		for(uint32_t i = 0; i < BENCH_WRITES; i++){
+			status |= MCP4822_write_to_chan(&handle, (uint16_t)(i & MCP4822_DAC_MAX), (MCP4822_DAC_SELECT)(i & 1));
+		}
+		uint64_t elapsed = bench_now() - start;
+		BENCH_KEEP(status);
+		best = (elapsed < best) ? elapsed : best;
+	}
+
+	printf("  host %s per write    %6.2f (best of %u passes of %u writes)\n", BENCH_UNIT, (double)best / BENCH_WRITES,
+		   BENCH_PASSES, BENCH_WRITES);
+
+	return test_result("bench_spi");
+}
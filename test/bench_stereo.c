@@ -0,0 +1,81 @@
+/*
+ * bench_stereo.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_stream.h"
+
+/** L/R pairs per timed pass, a few buffer halves worth */
+#define BENCH_PAIRS					   1024
+
+/** Timed passes, the fastest one is reported */
+#define BENCH_PASSES				   200
+
+static int16_t samples[2 * BENCH_PAIRS];
+
+static uint16_t frames[2 * BENCH_PAIRS];
+
+/**
+ * @brief Per-sample reference: offset, shift and encode each channel on its own
+ */
+static void encode_per_channel(const MCP4822_Handle_t *handle, const int16_t *in, uint16_t *out, uint32_t pairs){
+
+	for(uint32_t i = 0; i < 2 * pairs; i++){
+		uint16_t code = (uint16_t)((uint16_t)in[i] ^ 0x8000U) >> (16 - MCP4822_RES);
+		out[i] = MCP4822_encode_frame(handle, code, (MCP4822_DAC_SELECT)(i & 1));
+	}
+}
+
+int main(void){
+
+	Test_Device_t device;
+	MCP4822_Stereo_t stereo;
+	uint64_t best_reference = UINT64_MAX;
+	uint64_t best_encode = UINT64_MAX;
+	uint64_t best_refill = UINT64_MAX;
+
+	test_device_init(&device);
+	for(uint32_t i = 0; i < 2 * BENCH_PAIRS; i++){
+		samples[i] = (int16_t)(i * 97);
+	}
+	MCP4822_stereo_init(&stereo, &device.handle, samples, BENCH_PAIRS, 1);
+
+	for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+
+		uint64_t start = bench_now();
+		encode_per_channel(&device.handle, samples, frames, BENCH_PAIRS);
+		uint64_t elapsed = bench_now() - start;
+		BENCH_KEEP(frames[pass % BENCH_PAIRS]);
+		best_reference = (elapsed < best_reference) ? elapsed : best_reference;
+
+		start = bench_now();
+		MCP4822_stereo_encode(&device.handle, samples, frames, BENCH_PAIRS);
+		elapsed = bench_now() - start;
+		BENCH_KEEP(frames[pass % BENCH_PAIRS]);
+		best_encode = (elapsed < best_encode) ? elapsed : best_encode;
+
+		start = bench_now();
+		MCP4822_stereo_refill(&stereo, frames, 2 * BENCH_PAIRS);
+		elapsed = bench_now() - start;
+		BENCH_KEEP(frames[pass % BENCH_PAIRS]);
+		best_refill = (elapsed < best_refill) ? elapsed : best_refill;
+	}
+
+	//Both encoders must agree before their costs mean anything
+	uint16_t check[2 * BENCH_PAIRS];
+	encode_per_channel(&device.handle, samples, check, BENCH_PAIRS);
+	MCP4822_stereo_encode(&device.handle, samples, frames, BENCH_PAIRS);
+	for(uint32_t i = 0; i < 2 * BENCH_PAIRS; i++){
+		CHECK(check[i] == frames[i]);
+	}
+
+	double per_frame = 1.0 / (2 * BENCH_PAIRS);
+	printf("stereo encode, %s per frame (best of %u passes of %u frames):\n", BENCH_UNIT, BENCH_PASSES, 2 * BENCH_PAIRS);
+	printf("  per-channel encode_frame  %6.2f\n", best_reference * per_frame);
+	printf("  MCP4822_stereo_encode     %6.2f\n", best_encode * per_frame);
+	printf("  MCP4822_stereo_refill     %6.2f\n", best_refill * per_frame);
+
+	return test_result("bench_stereo");
+}
@@ -0,0 +1,91 @@
+/*
+ * bench_volts.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+
+/** Conversions per timed pass */
+#define BENCH_VALUES				   4096
+
+/** Timed passes, the fastest one is reported */
+#define BENCH_PASSES				   200
+
+static float volts[BENCH_VALUES];
+
+static int32_t millivolts[BENCH_VALUES];
+
+static int32_t microvolts[BENCH_VALUES];
+
+static int32_t q16_volts[BENCH_VALUES];
+
+/**
+ * @brief Times one conversion over the whole input table and keeps the fastest pass
+ */
+#define BENCH_CONVERSION(best, expr)												\
+	do{																				\
+		uint32_t sum = 0;															\
+		uint64_t start = bench_now();												\
+		for(uint32_t i = 0; i < BENCH_VALUES; i++){									\
+			sum += (expr);															\
+		}																			\
+		uint64_t elapsed = bench_now() - start;										\
+		BENCH_KEEP(sum);															\
+		(best) = (elapsed < (best)) ? elapsed : (best);								\
+	}while(0)
+
+/**
+ * @brief Fixed-point conversion returning the code, for BENCH_CONVERSION
+ */
+static uint16_t fixed_code(MCP4822_Handle_t *handle, int32_t value, MCP4822_VOLT_UNIT unit){
+
+	uint16_t code;
+
+	MCP4822_fixed_volts_to_chan_units(handle, value, unit, MCP4822_CHANNEL_A, &code);
+
+	return code;
+}
+
+int main(void){
+
+	Test_Device_t device;
+	MCP4822_Handle_t *handle = &device.handle;
+	uint64_t best_float = UINT64_MAX;
+	uint64_t best_mv = UINT64_MAX;
+	uint64_t best_uv = UINT64_MAX;
+	uint64_t best_q16 = UINT64_MAX;
+	uint64_t best_write_float = UINT64_MAX;
+	uint64_t best_write_mv = UINT64_MAX;
+
+	test_device_init(&device);
+
+	//Sweep the 2X range slightly past full scale so saturation is part of the mix
+	for(uint32_t i = 0; i < BENCH_VALUES; i++){
+		microvolts[i] = (int32_t)(i * 1013U);
+		millivolts[i] = microvolts[i] / 1000;
+		volts[i] = (float)microvolts[i] * 1e-6f;
+		q16_volts[i] = (int32_t)(((int64_t)microvolts[i] << 16) / 1000000);
+	}
+
+	for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+		BENCH_CONVERSION(best_float, MCP4822_volts_to_chan_units(handle, volts[i], MCP4822_CHANNEL_A));
+		BENCH_CONVERSION(best_mv, fixed_code(handle, millivolts[i], MCP4822_UNIT_MILLIVOLTS));
+		BENCH_CONVERSION(best_uv, fixed_code(handle, microvolts[i], MCP4822_UNIT_MICROVOLTS));
+		BENCH_CONVERSION(best_q16, fixed_code(handle, q16_volts[i], MCP4822_UNIT_Q16_VOLTS));
+		BENCH_CONVERSION(best_write_float, (uint32_t)MCP4822_write_volts_to_chan(handle, volts[i], MCP4822_CHANNEL_A));
+		BENCH_CONVERSION(best_write_mv, (uint32_t)MCP4822_write_millivolts_to_chan(handle, millivolts[i], MCP4822_CHANNEL_A));
+	}
+
+	double per_value = 1.0 / BENCH_VALUES;
+	printf("voltage conversion, %s per value (best of %u passes of %u values):\n", BENCH_UNIT, BENCH_PASSES, BENCH_VALUES);
+	printf("  volts_to_chan_units (float)      %6.2f\n", best_float * per_value);
+	printf("  fixed_volts_to_chan_units mV     %6.2f\n", best_mv * per_value);
+	printf("  fixed_volts_to_chan_units uV     %6.2f\n", best_uv * per_value);
+	printf("  fixed_volts_to_chan_units Q16    %6.2f\n", best_q16 * per_value);
+	printf("  write_volts_to_chan              %6.2f\n", best_write_float * per_value);
+	printf("  write_millivolts_to_chan         %6.2f\n", best_write_mv * per_value);
+	printf("  the float path relies on the host FPU, without one it becomes soft-float library calls\n");
+
+	return test_result("bench_volts");
+}
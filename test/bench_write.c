@@ -0,0 +1,101 @@
+/*
+ * bench_write.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+
+/** Samples per timed pass */
+#define BENCH_SAMPLES				   4096
+
+/** Timed passes, the fastest one is reported */
+#define BENCH_PASSES				   200
+
+static uint16_t values[BENCH_SAMPLES];
+
+static uint8_t bytes[2 * BENCH_SAMPLES];
+
+static uint16_t frames[BENCH_SAMPLES];
+
+/**
+ * @brief The original header build: look up the channel configuration and assemble two SPI bytes per sample
+ */
+static void build_bytes(MCP4822_Handle_t *handle, const uint16_t *in, uint8_t *out, uint32_t count){
+
+	for(uint32_t i = 0; i < count; i++){
+		MCP4822_DAC_SELECT dac_channel = (MCP4822_DAC_SELECT)(i & 1);
+		volatile MCP4822_Config_t *config = (dac_channel == MCP4822_CHANNEL_A) ? &handle->chan_configs.chan_A_config
+																			   : &handle->chan_configs.chan_B_config;
+
+		out[2 * i] = ((uint8_t)((dac_channel) & FIRST_BIT_MASK) << SHIFT_7) |
+					 ((uint8_t)((config->gain) & FIRST_BIT_MASK) << SHIFT_5) |
+					 ((uint8_t)((config->shutdown) & FIRST_BIT_MASK) << SHIFT_4) |
+					 (uint8_t)((in[i] >> SHIFT_8) & LOW_HALF_BYTE_MASK);
+		out[2 * i + 1] = (uint8_t)(in[i] & FIRST_BYTE_MASK);
+	}
+}
+
+/**
+ * @brief The cached header path: OR the value into the channel's precomputed 16-bit word
+ */
+static void build_frames(const MCP4822_Handle_t *handle, const uint16_t *in, uint16_t *out, uint32_t count){
+
+	for(uint32_t i = 0; i < count; i++){
+		out[i] = MCP4822_encode_frame(handle, in[i], (MCP4822_DAC_SELECT)(i & 1));
+	}
+}
+
+int main(void){
+
+	Test_Device_t device;
+	uint64_t best_bytes = UINT64_MAX;
+	uint64_t best_frames = UINT64_MAX;
+	uint64_t best_write = UINT64_MAX;
+
+	test_device_init(&device);
+	for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+		values[i] = (uint16_t)((i * 2654435761U) >> 20);
+	}
+
+	for(uint32_t pass = 0; pass < BENCH_PASSES; pass++){
+
+		uint64_t start = bench_now();
+		build_bytes(&device.handle, values, bytes, BENCH_SAMPLES);
+		uint64_t elapsed = bench_now() - start;
+		BENCH_KEEP(bytes[pass % BENCH_SAMPLES]);
+		best_bytes = (elapsed < best_bytes) ? elapsed : best_bytes;
+
+		start = bench_now();
+		build_frames(&device.handle, values, frames, BENCH_SAMPLES);
+		elapsed = bench_now() - start;
+		BENCH_KEEP(frames[pass % BENCH_SAMPLES]);
+		best_frames = (elapsed < best_frames) ? elapsed : best_frames;
+
+		//Alternating channels keep the redundant-write check from skipping samples
+		uint32_t status = 0;
+		start = bench_now();
+		for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+			status |= MCP4822_write_to_chan(&device.handle, values[i], (MCP4822_DAC_SELECT)(i & 1));
+		}
+		elapsed = bench_now() - start;
+		BENCH_KEEP(status);
+		best_write = (elapsed < best_write) ? elapsed : best_write;
+	}
+
+	//Both encodings must describe the same command word
+	build_bytes(&device.handle, values, bytes, BENCH_SAMPLES);
+	build_frames(&device.handle, values, frames, BENCH_SAMPLES);
+	for(uint32_t i = 0; i < BENCH_SAMPLES; i++){
+		CHECK(frames[i] == (uint16_t)((bytes[2 * i] << 8) | bytes[2 * i + 1]));
+	}
+
+	double per_sample = 1.0 / BENCH_SAMPLES;
+	printf("command word build, %s per sample (best of %u passes of %u samples):\n", BENCH_UNIT, BENCH_PASSES, BENCH_SAMPLES);
+	printf("  two bytes from the channel config    %6.2f\n", best_bytes * per_sample);
+	printf("  cached header, one 16-bit frame      %6.2f\n", best_frames * per_sample);
+	printf("  MCP4822_write_to_chan (host SPI)     %6.2f\n", best_write * per_sample);
+	printf("  on target the byte path also pays a second SPI data register write per sample\n");
+
+	return test_result("bench_write");
+}
@@ -0,0 +1,393 @@
+/*
+ * stm32_standin.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#define _GNU_SOURCE
+#include <string.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include "stm32_standin.h"
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <ucontext.h>
+#define STANDIN_TRAPS				   1
+#else
+#define STANDIN_TRAPS				   0
+#endif
+
+/** x86 trap flag, raises SIGTRAP after the next instruction */
+#define STANDIN_TRAP_FLAG			   0x100
+
+#define STANDIN_PAGE_SIZE			   4096
+
+/** Words the model RX FIFO holds, as the 32-bit FIFO of the STM32L5 SPI at 16-bit frames */
+#define STANDIN_RX_DEPTH			   2
+
+/** SPI handle states used by the stand-in HAL_SPI_Transmit */
+#define STANDIN_SPI_STATE_READY		   1
+#define STANDIN_SPI_STATE_BUSY_TX	   3
+
+/**
+ * @brief Register page, SPI block first and GPIO block after it
+ */
+typedef struct
+{
+
+	SPI_TypeDef spi;
+
+	GPIO_TypeDef gpio;
+
+}Standin_Regs_t;
+
+static uint8_t register_page[STANDIN_PAGE_SIZE] __attribute__((aligned(STANDIN_PAGE_SIZE)));
+
+SPI_TypeDef *standin_spi = &((Standin_Regs_t *)register_page)->spi;
+GPIO_TypeDef *standin_gpio = &((Standin_Regs_t *)register_page)->gpio;
+
+static DWT_Type dwt;
+static CoreDebug_Type core_debug;
+DWT_Type *DWT = &dwt;
+CoreDebug_Type *CoreDebug = &core_debug;
+uint32_t SystemCoreClock = 110000000U;
+
+static Standin_Counts_t counts;
+static volatile uint8_t counting;
+static uint32_t rx_words;
+static uintptr_t access_offset;
+static uint8_t access_write;
+
+/**
+ * @brief Applies the effect of a finished register access to the SPI model
+ *
+ * @param offset - byte offset of the access in the register page
+ * @param write - non-zero for a store
+ *
+ * @return None
+ */
+static void model_access(uintptr_t offset, uint8_t write);
+
+/**
+ * @brief Locks or unlocks the register page
+ *
+ * @param locked - non-zero to make every access fault
+ *
+ * @return None
+ */
+static void lock_page(uint8_t locked);
+
+#if STANDIN_TRAPS
+/**
+ * @brief Counts a faulting register access and lets it run one instruction
+ */
+static void on_fault(int sig, siginfo_t *info, void *context);
+
+/**
+ * @brief Locks the page again once the access has run
+ */
+static void on_step(int sig, siginfo_t *info, void *context);
+#endif
+
+void standin_reset(void){
+
+	lock_page(0);
+	memset(register_page, 0, sizeof(Standin_Regs_t));
+	standin_spi->SR = SPI_SR_TXE;
+	rx_words = 0;
+}
+
+uint8_t standin_can_count(void){
+
+	return STANDIN_TRAPS;
+}
+
+void standin_count_begin(void){
+
+#if STANDIN_TRAPS
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_flags = SA_SIGINFO;
+
+	action.sa_sigaction = on_fault;
+	sigaction(SIGSEGV, &action, NULL);
+	action.sa_sigaction = on_step;
+	sigaction(SIGTRAP, &action, NULL);
+
+	memset(&counts, 0, sizeof(counts));
+	counting = 1;
+	lock_page(1);
+#endif
+}
+
+void standin_count_end(Standin_Counts_t *result){
+
+	lock_page(0);
+	counting = 0;
+	*result = counts;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState){
+
+	if(PinState != GPIO_PIN_RESET){
+		GPIOx->BSRR = GPIO_Pin;
+	}
+	else{
+		GPIOx->BRR = GPIO_Pin;
+	}
+}
+
+uint32_t HAL_GetTick(void){
+
+	if(counting){
+		counts.ticks++;
+	}
+
+	return 0;
+}
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi){
+
+	hspi->State = STANDIN_SPI_STATE_READY;
+
+	return HAL_OK;
+}
+
+/**
+ * @brief Waits for SR & Fifo to equal State, reading DR while it waits for an empty RX FIFO
+ *
+ * The register accesses and tick reads follow SPI_WaitFifoStateUntilTimeout
+ * and SPI_WaitFlagStateUntilTimeout of the STM32L5 HAL.
+ */
+static HAL_StatusTypeDef wait_state(SPI_HandleTypeDef *hspi, uint32_t Fifo, uint32_t State, uint32_t Timeout, uint32_t Tickstart){
+
+	uint32_t tmp_timeout = Timeout - (HAL_GetTick() - Tickstart);
+	uint32_t tmp_tickstart = HAL_GetTick();
+	uint32_t count = tmp_timeout * ((SystemCoreClock * 35U) >> 20U);
+
+	while((hspi->Instance->SR & Fifo) != State){
+
+		if(Fifo == SPI_SR_FRLVL && State == SPI_FRLVL_EMPTY){
+			(void)*(__IO uint8_t *)&hspi->Instance->DR;
+		}
+
+		if(Timeout != HAL_MAX_DELAY){
+			if((HAL_GetTick() - tmp_tickstart) >= tmp_timeout || tmp_timeout == 0U || count == 0U){
+				return HAL_TIMEOUT;
+			}
+			count--;
+		}
+	}
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout){
+
+	uint32_t tickstart = HAL_GetTick();
+	const uint16_t *tx = (const uint16_t *)pData;
+	HAL_StatusTypeDef status = HAL_OK;
+
+	if(hspi->Lock){
+		return HAL_BUSY;
+	}
+	hspi->Lock = 1;
+
+	if(hspi->State != STANDIN_SPI_STATE_READY || pData == NULL || Size == 0U){
+		hspi->Lock = 0;
+		return HAL_ERROR;
+	}
+
+	hspi->State = STANDIN_SPI_STATE_BUSY_TX;
+	hspi->ErrorCode = 0;
+	hspi->TxXferCount = Size;
+
+	if((hspi->Instance->CR1 & SPI_CR1_SPE) != SPI_CR1_SPE){
+		__HAL_SPI_ENABLE(hspi);
+	}
+
+	//16-bit frames: a single frame is written at once, longer transfers wait for TXE per frame
+	if(Size == 1U){
+		hspi->Instance->DR = *tx++;
+		hspi->TxXferCount--;
+	}
+	while(hspi->TxXferCount > 0U){
+		if(hspi->Instance->SR & SPI_SR_TXE){
+			hspi->Instance->DR = *tx++;
+			hspi->TxXferCount--;
+		}
+		else if((HAL_GetTick() - tickstart) >= Timeout){
+			status = HAL_TIMEOUT;
+			break;
+		}
+	}
+
+	//SPI_EndRxTxTransaction: TX FIFO empty, not busy, RX FIFO drained
+	if(status == HAL_OK){
+		if(wait_state(hspi, SPI_SR_FTLVL, SPI_FTLVL_EMPTY, Timeout, tickstart) != HAL_OK ||
+		   wait_state(hspi, SPI_SR_BSY, 0, Timeout, tickstart) != HAL_OK ||
+		   wait_state(hspi, SPI_SR_FRLVL, SPI_FRLVL_EMPTY, Timeout, tickstart) != HAL_OK){
+			status = HAL_TIMEOUT;
+		}
+	}
+
+	//__HAL_SPI_CLEAR_OVRFLAG for a two-line SPI
+	(void)hspi->Instance->DR;
+	(void)hspi->Instance->SR;
+
+	hspi->State = STANDIN_SPI_STATE_READY;
+	hspi->Lock = 0;
+
+	return status;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size){
+
+	(void)hspi;
+	(void)pData;
+	(void)Size;
+
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size){
+
+	(void)hspi;
+	(void)pData;
+	(void)Size;
+
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef *hspi){
+
+	(void)hspi;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength){
+
+	(void)hdma;
+	(void)SrcAddress;
+	(void)DstAddress;
+	(void)DataLength;
+
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma){
+
+	(void)hdma;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim){
+
+	(void)htim;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim){
+
+	(void)htim;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim){
+
+	(void)htim;
+
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim){
+
+	(void)htim;
+
+	return HAL_OK;
+}
+
+static void model_access(uintptr_t offset, uint8_t write){
+
+	if(offset >= offsetof(Standin_Regs_t, gpio)){
+		if(write){
+			counts.gpio_writes++;
+		}
+		return;
+	}
+
+	uint32_t reg = (uint32_t)(offset / sizeof(uint32_t));
+	if(reg >= 7){
+		return;
+	}
+
+	if(write){
+		counts.spi_writes[reg]++;
+	}
+	else{
+		counts.spi_reads[reg]++;
+	}
+
+	//The wire is instant, so a written word is received at once and a read takes it
+	if(reg == STANDIN_SPI_DR){
+		if(write){
+			rx_words = (rx_words < STANDIN_RX_DEPTH) ? rx_words + 1 : rx_words;
+		}
+		else if(rx_words > 0){
+			rx_words--;
+		}
+
+		uint32_t sr = SPI_SR_TXE;
+		if(rx_words > 0){
+			sr |= SPI_SR_RXNE | ((rx_words == 1) ? (2U << 9) : (3U << 9));
+		}
+		standin_spi->SR = sr;
+	}
+}
+
+static void lock_page(uint8_t locked){
+
+#if STANDIN_TRAPS
+	mprotect(register_page, STANDIN_PAGE_SIZE, locked ? PROT_NONE : (PROT_READ | PROT_WRITE));
+#else
+	(void)locked;
+#endif
+}
+
+#if STANDIN_TRAPS
+static void on_fault(int sig, siginfo_t *info, void *context){
+
+	ucontext_t *uc = (ucontext_t *)context;
+	uintptr_t address = (uintptr_t)info->si_addr;
+
+	if(!counting || address < (uintptr_t)register_page || address >= (uintptr_t)register_page + STANDIN_PAGE_SIZE){
+		signal(sig, SIG_DFL);
+		return;
+	}
+
+	//Bit 1 of the page fault error code marks a store
+	access_offset = address - (uintptr_t)register_page;
+	access_write = (uc->uc_mcontext.gregs[REG_ERR] & 2) != 0;
+
+	lock_page(0);
+	uc->uc_mcontext.gregs[REG_EFL] |= STANDIN_TRAP_FLAG;
+}
+
+static void on_step(int sig, siginfo_t *info, void *context){
+
+	ucontext_t *uc = (ucontext_t *)context;
+
+	(void)sig;
+	(void)info;
+
+	uc->uc_mcontext.gregs[REG_EFL] &= ~STANDIN_TRAP_FLAG;
+
+	//The model runs on the unlocked page so its own accesses are not counted
+	model_access(access_offset, access_write);
+	lock_page(1);
+}
+#endif
@@ -0,0 +1,82 @@
+/*
+ * stm32_standin.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __STM32_STANDIN_H_
+#define __STM32_STANDIN_H_
+
+#include "stm32l5xx_hal.h"
+
+/**
+ * Register access counting for the host HAL stand-in. The SPI and GPIO
+ * register blocks share one page. While counting, the page is inaccessible:
+ * every load or store faults, is counted, runs single-stepped and the page is
+ * locked again. A read-modify-write instruction counts as one write.
+ *
+ * The SPI model has an instant wire: TXE is always set, BSY and FTLVL always
+ * clear, and every data register write queues one word that sets RXNE and
+ * FRLVL until a data register read takes it. Without counting the page is
+ * plain memory, SR keeps TXE set and nothing is received.
+ *
+ * Counting needs x86-64 Linux (trap flag single-stepping).
+ */
+
+/**
+ * @brief Register accesses seen while counting
+ */
+typedef struct
+{
+
+	uint32_t spi_reads[7];
+
+	uint32_t spi_writes[7];
+
+	uint32_t gpio_writes;
+
+	uint32_t ticks;
+
+}Standin_Counts_t;
+
+/** Register offsets within SPI_TypeDef, in units of 32-bit registers */
+#define STANDIN_SPI_CR1				   0
+#define STANDIN_SPI_SR				   2
+#define STANDIN_SPI_DR				   3
+
+/** SPI and GPIO register blocks of the stand-in */
+extern SPI_TypeDef *standin_spi;
+extern GPIO_TypeDef *standin_gpio;
+
+/**
+ * @brief Resets the registers to an idle, disabled SPI
+ *
+ * @return None
+ */
+void standin_reset(void);
+
+/**
+ * @brief Reports whether register accesses can be counted on this host
+ *
+ * @return 1 if counting works, 0 otherwise
+ */
+uint8_t standin_can_count(void);
+
+/**
+ * @brief Clears the counts and starts trapping register accesses
+ *
+ * @return None
+ */
+void standin_count_begin(void);
+
+/**
+ * @brief Stops trapping and returns the counts
+ *
+ * @param counts - accesses seen since standin_count_begin
+ *
+ * @return None
+ */
+void standin_count_end(Standin_Counts_t *counts);
+
+#endif /* __STM32_STANDIN_H_ */
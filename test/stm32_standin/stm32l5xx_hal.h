@@ -0,0 +1,220 @@
+/*
+ * stm32l5xx_hal.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __STM32L5XX_HAL_H_
+#define __STM32L5XX_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * Host stand-in for the STM32L5 HAL, just enough to build MCP4822.c with the
+ * default binding (MCP4822_port_stm32.h) on a host. The SPI and GPIO
+ * registers live on one page whose accesses are counted, see
+ * stm32_standin.h. HAL_SPI_Transmit follows the sequence of the STM32L5 HAL
+ * for 16-bit master transfers so both SPI backends can be compared register
+ * access for register access. Nothing here is part of the driver.
+ */
+
+#define __IO						   volatile
+
+typedef enum
+{
+	HAL_OK							 = 0x00,
+	HAL_ERROR						 = 0x01,
+	HAL_BUSY						 = 0x02,
+	HAL_TIMEOUT						 = 0x03
+
+}HAL_StatusTypeDef;
+
+typedef enum
+{
+	GPIO_PIN_RESET					 = 0,
+	GPIO_PIN_SET					 = 1
+
+}GPIO_PinState;
+
+typedef struct
+{
+
+	__IO uint32_t MODER, OTYPER, OSPEEDR, PUPDR, IDR, ODR, BSRR, LCKR, AFR[2], BRR;
+
+}GPIO_TypeDef;
+
+typedef struct
+{
+
+	__IO uint32_t CR1, CR2, SR, DR, CRCPR, RXCRCR, TXCRCR;
+
+}SPI_TypeDef;
+
+typedef struct
+{
+
+	__IO uint32_t CR1, CR2, SMCR, DIER, SR, EGR, CCMR1, CCMR2, CCER, CNT, PSC, ARR, RCR, CCR1, CCR2, CCR3, CCR4;
+
+}TIM_TypeDef;
+
+typedef struct
+{
+
+	__IO uint32_t CCR, CNDTR, CPAR, CM0AR, CM1AR;
+
+}DMA_Channel_TypeDef;
+
+typedef struct
+{
+
+	uint32_t Direction, PeriphInc, MemInc, PeriphDataAlignment, MemDataAlignment, Mode, Priority;
+
+}DMA_InitTypeDef;
+
+typedef struct __DMA_HandleTypeDef
+{
+
+	DMA_Channel_TypeDef *Instance;
+
+	DMA_InitTypeDef Init;
+
+	void *Parent;
+
+	void (*XferCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+
+	void (*XferHalfCpltCallback)(struct __DMA_HandleTypeDef *hdma);
+
+}DMA_HandleTypeDef;
+
+typedef struct
+{
+
+	uint32_t Mode, Direction, DataSize, CLKPolarity, CLKPhase, NSS, BaudRatePrescaler, FirstBit, NSSPMode;
+
+}SPI_InitTypeDef;
+
+typedef struct __SPI_HandleTypeDef
+{
+
+	SPI_TypeDef *Instance;
+
+	SPI_InitTypeDef Init;
+
+	DMA_HandleTypeDef *hdmatx;
+
+	uint32_t State;
+
+	uint32_t ErrorCode;
+
+	uint32_t Lock;
+
+	uint16_t TxXferCount;
+
+}SPI_HandleTypeDef;
+
+typedef struct
+{
+
+	uint32_t Prescaler, Period;
+
+}TIM_Base_InitTypeDef;
+
+typedef struct
+{
+
+	TIM_TypeDef *Instance;
+
+	TIM_Base_InitTypeDef Init;
+
+	DMA_HandleTypeDef *hdma[7];
+
+}TIM_HandleTypeDef;
+
+typedef struct
+{
+
+	__IO uint32_t CTRL, CYCCNT;
+
+}DWT_Type;
+
+typedef struct
+{
+
+	__IO uint32_t DEMCR;
+
+}CoreDebug_Type;
+
+#define HAL_MAX_DELAY				   0xFFFFFFFFU
+
+#define SPI_DATASIZE_8BIT			   0x00000700U
+#define SPI_DATASIZE_16BIT			   0x00000F00U
+#define SPI_DIRECTION_2LINES		   0x00000000U
+#define SPI_MODE_MASTER				   0x00000104U
+#define SPI_NSS_SOFT				   0x00000200U
+#define SPI_NSS_HARD_OUTPUT			   0x00040000U
+#define SPI_NSS_PULSE_ENABLE		   0x00000008U
+#define SPI_NSS_PULSE_DISABLE		   0x00000000U
+#define SPI_PHASE_1EDGE				   0x00000000U
+#define SPI_PHASE_2EDGE				   0x00000001U
+
+#define SPI_CR1_SPE					   (1U << 6)
+#define SPI_SR_RXNE					   (1U << 0)
+#define SPI_SR_TXE					   (1U << 1)
+#define SPI_SR_OVR					   (1U << 6)
+#define SPI_SR_BSY					   (1U << 7)
+#define SPI_SR_FRLVL				   (3U << 9)
+#define SPI_SR_FTLVL				   (3U << 11)
+#define SPI_FRLVL_EMPTY				   0U
+#define SPI_FTLVL_EMPTY				   0U
+
+#define DMA_NORMAL					   0x00000000U
+#define DMA_CIRCULAR				   0x00000020U
+#define DMA_PDATAALIGN_HALFWORD		   (1U << 8)
+#define DMA_MDATAALIGN_HALFWORD		   (1U << 10)
+
+#define TIM_DMA_UPDATE				   (1U << 8)
+#define TIM_DMA_ID_UPDATE			   0
+#define TIM_FLAG_UPDATE				   (1U << 0)
+#define TIM_EGR_UG					   (1U << 0)
+
+#define DWT_CTRL_CYCCNTENA_Msk		   (1U << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk	   (1U << 24)
+
+#define READ_BIT(REG, BIT)			   ((REG) & (BIT))
+#define SET_BIT(REG, BIT)			   ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)			   ((REG) &= ~(BIT))
+
+#define __HAL_SPI_ENABLE(h)			   SET_BIT((h)->Instance->CR1, SPI_CR1_SPE)
+#define __HAL_TIM_ENABLE_DMA(h, d)	   SET_BIT((h)->Instance->DIER, (d))
+#define __HAL_TIM_DISABLE_DMA(h, d)	   CLEAR_BIT((h)->Instance->DIER, (d))
+#define __HAL_TIM_SET_PRESCALER(h, p)  ((h)->Instance->PSC = (p))
+#define __HAL_TIM_SET_AUTORELOAD(h, a) do{ (h)->Instance->ARR = (a); (h)->Init.Period = (a); }while(0)
+#define __HAL_TIM_SET_COUNTER(h, c)	   ((h)->Instance->CNT = (c))
+#define __HAL_TIM_CLEAR_FLAG(h, f)	   ((h)->Instance->SR = ~(f))
+
+extern DWT_Type *DWT;
+extern CoreDebug_Type *CoreDebug;
+extern uint32_t SystemCoreClock;
+
+static inline uint32_t __get_PRIMASK(void){ return 0; }
+static inline void __set_PRIMASK(uint32_t primask){ (void)primask; }
+static inline void __disable_irq(void){}
+static inline void __DMB(void){}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+uint32_t HAL_GetTick(void);
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_IT(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size);
+HAL_StatusTypeDef HAL_SPI_DMAStop(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef *hdma);
+HAL_StatusTypeDef HAL_TIM_Base_Start(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Start_IT(TIM_HandleTypeDef *htim);
+HAL_StatusTypeDef HAL_TIM_Base_Stop_IT(TIM_HandleTypeDef *htim);
+
+#endif /* __STM32L5XX_HAL_H_ */
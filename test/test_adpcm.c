@@ -0,0 +1,215 @@
+/*
+ * test_adpcm.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_adpcm.h"
+
+/** Random bytes decoded against the reference */
+#define TEST_BYTES					   4096
+
+/** Step sizes of the IMA ADPCM reference (IMA Digital Audio Focus and Technical Working Groups, 1992) */
+static const int32_t ref_steps[89] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+	253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+	3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+	12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/** Step index change of the IMA ADPCM reference, by code magnitude */
+static const int32_t ref_index_steps[8] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+
+static uint8_t data[TEST_BYTES];
+
+/**
+ * @brief Decodes one code as the reference does
+ *
+ * @param predictor - predictor, updated in place
+ * @param index - step index, updated in place
+ * @param code - 4-bit code
+ *
+ * @return Decoded sample
+ */
+static int16_t ref_decode(int32_t *predictor, int32_t *index, uint8_t code){
+
+	int32_t step = ref_steps[*index];
+	int32_t diff = step >> 3;
+
+	if(code & 4){
+		diff += step;
+	}
+	if(code & 2){
+		diff += step >> 1;
+	}
+	if(code & 1){
+		diff += step >> 2;
+	}
+
+	*predictor += (code & 8) ? -diff : diff;
+	*predictor = (*predictor > 32767) ? 32767 : (*predictor < -32768) ? -32768 : *predictor;
+
+	*index += ref_index_steps[code & 7];
+	*index = (*index > 88) ? 88 : (*index < 0) ? 0 : *index;
+
+	return (int16_t)*predictor;
+}
+
+/**
+ * @brief Every code at every step index matches the reference, so both tables do
+ */
+static void tables(void){
+
+	uint32_t wrong = 0;
+
+	for(int32_t index = 0; index <= MCP4822_ADPCM_STEP_INDEX_MAX; index++){
+		for(uint8_t code = 0; code < 16; code++){
+			MCP4822_ADPCM_State_t state = { 1000, (uint8_t)index };
+			int32_t predictor = 1000;
+			int32_t ref_index = index;
+			uint8_t byte = (uint8_t)(code << MCP4822_ADPCM_NIBBLE_BITS);
+			int16_t sample;
+
+			MCP4822_adpcm_decode(&state, &byte, 0, &sample, 1, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+
+			wrong += (sample != ref_decode(&predictor, &ref_index, code));
+			wrong += (state.predictor != predictor) + (state.step_index != ref_index);
+		}
+	}
+
+	CHECK(wrong == 0);
+}
+
+/**
+ * @brief A hand-decoded vector, in both nibble orders
+ */
+static void known_vector(void){
+
+	//Codes 7, 7, F, 0, 8, 4 from predictor 0 at step index 0
+	static const uint8_t high_first[] = { 0x77, 0xF0, 0x84 };
+	static const uint8_t low_first[] = { 0x77, 0x0F, 0x48 };
+	static const int16_t expected[] = { 11, 41, -22, -13, -21, 46 };
+	MCP4822_ADPCM_State_t state;
+	int16_t pcm[6];
+
+	state.predictor = 0;
+	state.step_index = 0;
+	MCP4822_adpcm_decode(&state, high_first, 0, pcm, 6, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	for(uint32_t i = 0; i < 6; i++){
+		CHECK(pcm[i] == expected[i]);
+	}
+	CHECK(state.predictor == 46 && state.step_index == 24);
+
+	state.predictor = 0;
+	state.step_index = 0;
+	MCP4822_adpcm_decode(&state, low_first, 0, pcm, 6, MCP4822_ADPCM_LOW_NIBBLE_FIRST);
+	for(uint32_t i = 0; i < 6; i++){
+		CHECK(pcm[i] == expected[i]);
+	}
+
+	//Starting on an odd sample picks the second nibble of the byte
+	state.predictor = 11;
+	state.step_index = 8;
+	MCP4822_adpcm_decode(&state, high_first, 1, pcm, 5, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	CHECK(pcm[0] == 41 && pcm[4] == 46);
+}
+
+/**
+ * @brief The step index stays within 0 .. 88 and the predictor within int16
+ */
+static void clamping(void){
+
+	MCP4822_ADPCM_State_t state;
+	uint8_t codes[64];
+	int16_t pcm[128];
+
+	//Code 0 lowers the index, at index 0 it stays there and adds step / 8, nothing at the smallest step
+	for(uint32_t i = 0; i < 64; i++){
+		codes[i] = 0x00;
+	}
+	state.predictor = 0;
+	state.step_index = 0;
+	MCP4822_adpcm_decode(&state, codes, 0, pcm, 128, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	CHECK(state.step_index == 0);
+	CHECK(pcm[127] == 0);
+
+	//Largest positive codes run the index to its top and the predictor into saturation
+	for(uint32_t i = 0; i < 64; i++){
+		codes[i] = 0x77;
+	}
+	MCP4822_adpcm_decode(&state, codes, 0, pcm, 128, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	CHECK(state.step_index == MCP4822_ADPCM_STEP_INDEX_MAX);
+	CHECK(state.predictor == 32767 && pcm[127] == 32767);
+
+	//And the largest negative ones into the bottom
+	for(uint32_t i = 0; i < 64; i++){
+		codes[i] = 0xFF;
+	}
+	MCP4822_adpcm_decode(&state, codes, 0, pcm, 128, MCP4822_ADPCM_HIGH_NIBBLE_FIRST);
+	CHECK(state.step_index == MCP4822_ADPCM_STEP_INDEX_MAX);
+	CHECK(state.predictor == -32768 && pcm[127] == -32768);
+
+	//A PCM sample at either rail still maps into the DAC range
+	CHECK(MCP4822_pcm_to_DAC_units(32767) == MCP4822_DAC_MAX);
+	CHECK(MCP4822_pcm_to_DAC_units(-32768) == 0);
+}
+
+/**
+ * @brief Random streams decode like the reference, and the PCM, frame and skip paths agree
+ */
+static void random_streams(void){
+
+	static int16_t pcm[TEST_BYTES * 2];
+	static uint16_t frames[TEST_BYTES * 2];
+	uint32_t seed = 0xACE1ACE1U;
+	uint32_t wrong = 0;
+
+	for(uint32_t i = 0; i < TEST_BYTES; i++){
+		seed = seed * 1664525U + 1013904223U;
+		data[i] = (uint8_t)(seed >> 24);
+	}
+
+	for(uint32_t order = 0; order < 2; order++){
+		MCP4822_ADPCM_State_t state = { 0, 0 };
+		MCP4822_ADPCM_State_t frame_state = { 0, 0 };
+		int32_t predictor = 0;
+		int32_t index = 0;
+
+		MCP4822_adpcm_decode(&state, data, 0, pcm, TEST_BYTES * 2, (MCP4822_ADPCM_NIBBLE_ORDER)order);
+		MCP4822_adpcm_decode_frames(&frame_state, data, 0, frames, TEST_BYTES * 2, (MCP4822_ADPCM_NIBBLE_ORDER)order, 0x3000);
+
+		for(uint32_t i = 0; i < TEST_BYTES * 2; i++){
+			uint8_t byte = data[i / 2];
+			uint8_t first = (order == MCP4822_ADPCM_HIGH_NIBBLE_FIRST) ? (byte >> 4) : (byte & 0x0F);
+			uint8_t second = (order == MCP4822_ADPCM_HIGH_NIBBLE_FIRST) ? (byte & 0x0F) : (byte >> 4);
+
+			wrong += (pcm[i] != ref_decode(&predictor, &index, (i & 1) ? second : first));
+			wrong += (frames[i] != (0x3000 | MCP4822_pcm_to_DAC_units(pcm[i])));
+		}
+
+		//Skipping to the middle leaves the decoder where decoding would have
+		MCP4822_ADPCM_State_t skipped = { 0, 0 };
+		MCP4822_adpcm_skip(&skipped, data, 0, TEST_BYTES + 1, (MCP4822_ADPCM_NIBBLE_ORDER)order);
+		int16_t next;
+		MCP4822_adpcm_decode(&skipped, data, TEST_BYTES + 1, &next, 1, (MCP4822_ADPCM_NIBBLE_ORDER)order);
+		wrong += (next != pcm[TEST_BYTES + 1]);
+
+		wrong += (state.predictor != frame_state.predictor) + (state.step_index != frame_state.step_index);
+	}
+
+	CHECK(wrong == 0);
+}
+
+int main(void){
+
+	tables();
+	known_vector();
+	clamping();
+	random_streams();
+
+	return test_result("test_adpcm");
+}
@@ -0,0 +1,182 @@
+/*
+ * test_asset.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_asset.h"
+
+/** Samples of the test assets */
+#define TEST_SAMPLES				   100
+
+/** Samples between seek table snapshots */
+#define TEST_SEEK_INTERVAL			   32
+
+/** Image storage, words keep the header aligned */
+static uint32_t image[256];
+
+/**
+ * @brief Writes a valid asset header for a codec and layout, payload directly after the header
+ *
+ * @param codec - payload codec
+ * @param layout - channel layout
+ * @param sample_count - samples per channel
+ *
+ * @return The header, for the test to break
+ */
+static MCP4822_Asset_Header_t *image_init(MCP4822_ASSET_CODEC codec, MCP4822_ASSET_LAYOUT layout, uint32_t sample_count){
+
+	MCP4822_Asset_Header_t *header = (MCP4822_Asset_Header_t *)image;
+
+	memset(image, 0, sizeof(image));
+	header->magic = MCP4822_ASSET_MAGIC;
+	header->version = MCP4822_ASSET_VERSION;
+	header->codec = (uint8_t)codec;
+	header->layout = (uint8_t)layout;
+	header->sample_rate = 16000;
+	header->sample_count = sample_count;
+	header->loop_end = sample_count;
+	header->header_size = sizeof(MCP4822_Asset_Header_t);
+	header->payload_size = MCP4822_asset_payload_size(codec, layout, sample_count);
+
+	return header;
+}
+
+/**
+ * @brief Bytes of the image in use
+ */
+static uint32_t image_size(void){
+
+	const MCP4822_Asset_Header_t *header = (const MCP4822_Asset_Header_t *)image;
+
+	return header->header_size + header->payload_size;
+}
+
+/**
+ * @brief A good header loads, a bad magic, version, header size or payload size does not
+ */
+static void header_checks(void){
+
+	MCP4822_Asset_t asset;
+	MCP4822_Asset_Header_t *header;
+
+	header = image_init(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, TEST_SAMPLES);
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_OK);
+	CHECK(asset.header == header);
+	CHECK(asset.payload == (const uint8_t *)image + sizeof(MCP4822_Asset_Header_t));
+	CHECK(asset.seek_table == NULL);
+	CHECK(header->payload_size == TEST_SAMPLES * 2 * 2);
+
+	header->magic ^= 1;
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+
+	header = image_init(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, TEST_SAMPLES);
+	header->version = MCP4822_ASSET_VERSION - 1;
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+
+	header = image_init(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, TEST_SAMPLES);
+	header->header_size = sizeof(MCP4822_Asset_Header_t) - 4;
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+
+	//The payload size must be the one the samples imply, and it must fit in the image
+	header = image_init(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, TEST_SAMPLES);
+	header->payload_size -= 2;
+	CHECK(MCP4822_asset_load(image, 0, &asset) == MCP4822_ERROR_FORMAT);
+
+	header = image_init(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, TEST_SAMPLES);
+	CHECK(MCP4822_asset_load(image, image_size() - 1, &asset) == MCP4822_ERROR_FORMAT);
+	CHECK(MCP4822_asset_load(image, sizeof(MCP4822_Asset_Header_t) - 1, &asset) == MCP4822_ERROR_FORMAT);
+
+	//ADPCM carries one channel, and the codec must be known
+	header = image_init(MCP4822_CODEC_IMA_ADPCM, MCP4822_LAYOUT_STEREO, TEST_SAMPLES);
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+	header = image_init(MCP4822_CODEC_ULAW, MCP4822_LAYOUT_MONO, TEST_SAMPLES);
+	header->codec = 7;
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+
+	//Loop points stay inside the samples
+	header = image_init(MCP4822_CODEC_ULAW, MCP4822_LAYOUT_MONO, TEST_SAMPLES);
+	header->loop_end = TEST_SAMPLES + 1;
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+
+	//The header is read in place
+	image_init(MCP4822_CODEC_ULAW, MCP4822_LAYOUT_MONO, TEST_SAMPLES);
+	CHECK(MCP4822_asset_load((const uint8_t *)image + 2, 0, &asset) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(MCP4822_asset_load(NULL, 0, &asset) == MCP4822_ERROR_INVALID_ARG);
+}
+
+/**
+ * @brief Sample counts whose payload would not fit in 32 bits are rejected instead of wrapping
+ */
+static void payload_overflow(void){
+
+	MCP4822_Asset_t asset;
+	MCP4822_Asset_Header_t *header;
+
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_MONO, 0x7FFFFFFFUL) == 0xFFFFFFFEUL);
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_MONO, 0x80000000UL) == 0);
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, 0x40000001UL) == 0);
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_ULAW, MCP4822_LAYOUT_STEREO, 0x80000000UL) == 0);
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_ULAW, MCP4822_LAYOUT_MONO, UINT32_MAX) == UINT32_MAX);
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_IMA_ADPCM, MCP4822_LAYOUT_MONO, UINT32_MAX) == 0x80000000UL);
+	CHECK(MCP4822_asset_payload_size(MCP4822_CODEC_IMA_ADPCM, MCP4822_LAYOUT_STEREO, UINT32_MAX) == UINT32_MAX);
+
+	//In 32 bits 0x40000001 stereo PCM12 samples wrap to a 4-byte payload
+	header = image_init(MCP4822_CODEC_PCM12, MCP4822_LAYOUT_STEREO, 0x40000001UL);
+	header->payload_size = 4;
+	CHECK(MCP4822_asset_load(image, 0, &asset) == MCP4822_ERROR_FORMAT);
+	header->payload_size = 0;
+	CHECK(MCP4822_asset_load(image, 0, &asset) == MCP4822_ERROR_FORMAT);
+}
+
+/**
+ * @brief The seek table is only accepted on ADPCM assets with an interval and room for every entry
+ */
+static void seek_table(void){
+
+	MCP4822_Asset_t asset;
+	MCP4822_Asset_Header_t *header;
+	uint32_t entries = MCP4822_asset_seek_entries(TEST_SAMPLES, TEST_SEEK_INTERVAL);
+
+	CHECK(entries == 4);
+	CHECK(MCP4822_asset_seek_entries(2 * TEST_SEEK_INTERVAL, TEST_SEEK_INTERVAL) == 2);
+	CHECK(MCP4822_asset_seek_entries(UINT32_MAX, 2) == 0x80000000UL);
+
+	header = image_init(MCP4822_CODEC_IMA_ADPCM, MCP4822_LAYOUT_MONO, TEST_SAMPLES);
+	header->flags = MCP4822_ASSET_FLAG_SEEK_TABLE;
+	header->seek_interval = TEST_SEEK_INTERVAL;
+	header->header_size = (uint16_t)(sizeof(MCP4822_Asset_Header_t) + entries * sizeof(MCP4822_Asset_Seek_t));
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_OK);
+	CHECK((const uint8_t *)asset.seek_table == (const uint8_t *)image + sizeof(MCP4822_Asset_Header_t));
+	CHECK(asset.payload == (const uint8_t *)image + header->header_size);
+
+	//One entry short
+	header->header_size -= sizeof(MCP4822_Asset_Seek_t);
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+	header->header_size += sizeof(MCP4822_Asset_Seek_t);
+
+	header->seek_interval = 0;
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+	header->seek_interval = TEST_SEEK_INTERVAL;
+
+	header->codec = MCP4822_CODEC_ULAW;
+	header->payload_size = MCP4822_asset_payload_size(MCP4822_CODEC_ULAW, MCP4822_LAYOUT_MONO, TEST_SAMPLES);
+	CHECK(MCP4822_asset_load(image, image_size(), &asset) == MCP4822_ERROR_FORMAT);
+
+	//An entry count that wrapped to zero would let a table-less header through
+	header = image_init(MCP4822_CODEC_IMA_ADPCM, MCP4822_LAYOUT_MONO, UINT32_MAX);
+	header->flags = MCP4822_ASSET_FLAG_SEEK_TABLE;
+	header->seek_interval = 2;
+	CHECK(MCP4822_asset_load(image, 0, &asset) == MCP4822_ERROR_FORMAT);
+}
+
+int main(void){
+
+	header_checks();
+	payload_overflow();
+	seek_table();
+
+	return test_result("test_asset");
+}
@@ -0,0 +1,275 @@
+/*
+ * test_async.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_async.h"
+#include "MCP4822_stream.h"
+#include "MCP4822_bus.h"
+#include "MCP4822_dispatch.h"
+
+/** Frames of the stream buffer used by the ownership test */
+#define STREAM_LEN					   16
+
+/**
+ * @brief Completion log shared by the requests of one test
+ */
+typedef struct
+{
+
+	uint32_t count;
+
+	uint32_t order[64];
+
+	MCP4822_STATUS status[64];
+
+}Completions_t;
+
+/**
+ * @brief One request tagged with its position in the completion log
+ */
+typedef struct
+{
+
+	Completions_t *log;
+
+	uint32_t id;
+
+}Request_t;
+
+/** Frames seen at the SPI, one per serviced interrupt */
+static uint16_t sent_frames[64];
+static uint32_t sent_count;
+
+static void request_done(void *context, MCP4822_STATUS status){
+
+	Request_t *request = (Request_t *)context;
+	Completions_t *log = request->log;
+
+	log->order[log->count] = request->id;
+	log->status[log->count] = status;
+	log->count++;
+}
+
+/**
+ * @brief Plays SPI interrupts until the transfer chain ends, as HAL_SPI_TxCpltCallback would
+ *
+ * @param device - devices of the test handle
+ * @param fail - non-zero to report every transfer as failed through HAL_SPI_ErrorCallback
+ */
+static void service_spi(Test_Device_t *device, uint8_t fail){
+
+	while(device->spi.pending){
+		device->spi.pending = 0;
+		if(sent_count < 64){
+			sent_frames[sent_count++] = device->spi.last_frame;
+		}
+
+		if(fail){
+			MCP4822_dispatch_error(&device->spi);
+		}
+		else{
+			MCP4822_dispatch_tx_complete(&device->spi);
+		}
+	}
+}
+
+static uint32_t silence_refill(void *context, uint16_t *frames, uint32_t count){
+
+	(void)context;
+
+	for(uint32_t i = 0; i < count; i++){
+		frames[i] = 0x3000;
+	}
+
+	return count;
+}
+
+/**
+ * @brief Requests complete in the order they were queued and their frames go out in that order
+ */
+static void fifo_order(void){
+
+	Test_Device_t device;
+	MCP4822_Async_t async;
+	Completions_t log = {0};
+	Request_t requests[5];
+
+	test_device_init(&device);
+	CHECK(MCP4822_async_init(&device.handle, &async) == MCP4822_OK);
+	CHECK(MCP4822_dispatch_owner(&device.spi) == MCP4822_DISPATCH_ASYNC);
+
+	for(uint32_t i = 0; i < 5; i++){
+		requests[i].log = &log;
+		requests[i].id = i;
+	}
+
+	sent_count = 0;
+	CHECK(MCP4822_write_to_chan_async(&device.handle, 100, MCP4822_CHANNEL_A, request_done, &requests[0]) == MCP4822_OK);
+	CHECK(MCP4822_write_to_both_chans_async(&device.handle, 200, request_done, &requests[1]) == MCP4822_OK);
+	CHECK(MCP4822_write_to_chan_async(&device.handle, 300, MCP4822_CHANNEL_B, request_done, &requests[2]) == MCP4822_OK);
+	CHECK(MCP4822_write_to_both_chans_async(&device.handle, 400, request_done, &requests[3]) == MCP4822_OK);
+	CHECK(MCP4822_write_to_chan_async(&device.handle, 500, MCP4822_CHANNEL_A, request_done, &requests[4]) == MCP4822_OK);
+	CHECK(MCP4822_async_pending(&device.handle) == 7);
+
+	service_spi(&device, 0);
+
+	static const uint16_t expected[] = {100, 200, 200, 300, 400, 400, 500};
+	static const uint8_t channel[] = {0, 0, 1, 1, 0, 1, 0};
+
+	CHECK(sent_count == 7);
+	for(uint32_t i = 0; i < 7 && i < sent_count; i++){
+		CHECK((sent_frames[i] & MCP4822_FRAME_DATA_MASK) == expected[i]);
+		CHECK((sent_frames[i] >> MCP4822_FRAME_CHAN_POS) == channel[i]);
+	}
+
+	CHECK(log.count == 5);
+	for(uint32_t i = 0; i < 5 && i < log.count; i++){
+		CHECK(log.order[i] == i);
+		CHECK(log.status[i] == MCP4822_OK);
+	}
+	CHECK(MCP4822_async_pending(&device.handle) == 0);
+
+	CHECK(MCP4822_async_init(&device.handle, NULL) == MCP4822_OK);
+	CHECK(MCP4822_dispatch_owner(&device.spi) == MCP4822_DISPATCH_NONE);
+}
+
+/**
+ * @brief A full queue refuses requests whole and takes them again once frames are retired
+ */
+static void back_pressure(void){
+
+	Test_Device_t device;
+	MCP4822_Async_t async;
+	Completions_t log = {0};
+	Request_t requests[MCP4822_ASYNC_QUEUE_LEN];
+
+	test_device_init(&device);
+	CHECK(MCP4822_async_init(&device.handle, &async) == MCP4822_OK);
+
+	for(uint32_t i = 0; i < MCP4822_ASYNC_QUEUE_LEN; i++){
+		requests[i].log = &log;
+		requests[i].id = i;
+	}
+
+	//Two-frame requests fill the queue, the frame in flight keeps its slot
+	for(uint32_t i = 0; i < MCP4822_ASYNC_QUEUE_LEN / 2; i++){
+		CHECK(MCP4822_write_to_both_chans_async(&device.handle, (uint16_t)i, request_done, &requests[i]) == MCP4822_OK);
+	}
+	CHECK(MCP4822_async_pending(&device.handle) == MCP4822_ASYNC_QUEUE_LEN);
+	CHECK(MCP4822_write_to_chan_async(&device.handle, 1, MCP4822_CHANNEL_A, NULL, NULL) == MCP4822_ERROR_BUSY);
+	CHECK(MCP4822_write_to_both_chans_async(&device.handle, 1, NULL, NULL) == MCP4822_ERROR_BUSY);
+
+	//The queue is owned by the handle until it drains
+	CHECK(MCP4822_async_init(&device.handle, NULL) == MCP4822_ERROR_BUSY);
+
+	//One retired frame leaves room for a single frame but never half a pair
+	device.spi.pending = 0;
+	MCP4822_dispatch_tx_complete(&device.spi);
+	CHECK(MCP4822_async_pending(&device.handle) == MCP4822_ASYNC_QUEUE_LEN - 1);
+	CHECK(log.count == 0);
+	CHECK(MCP4822_write_to_both_chans_async(&device.handle, 1, NULL, NULL) == MCP4822_ERROR_BUSY);
+	CHECK(MCP4822_async_pending(&device.handle) == MCP4822_ASYNC_QUEUE_LEN - 1);
+	CHECK(MCP4822_write_to_chan_async(&device.handle, 1, MCP4822_CHANNEL_A, NULL, NULL) == MCP4822_OK);
+	CHECK(MCP4822_async_pending(&device.handle) == MCP4822_ASYNC_QUEUE_LEN);
+
+	sent_count = 0;
+	service_spi(&device, 0);
+	CHECK(sent_count == MCP4822_ASYNC_QUEUE_LEN);
+	CHECK(log.count == MCP4822_ASYNC_QUEUE_LEN / 2);
+	for(uint32_t i = 0; i < log.count; i++){
+		CHECK(log.order[i] == i);
+	}
+
+	CHECK(MCP4822_async_init(&device.handle, NULL) == MCP4822_OK);
+}
+
+/**
+ * @brief SPI errors reach the queue through the dispatcher and fail every request in flight
+ */
+static void error_routing(void){
+
+	Test_Device_t device;
+	MCP4822_Async_t async;
+	Completions_t log = {0};
+	Request_t requests[2] = {{&log, 0}, {&log, 1}};
+
+	test_device_init(&device);
+	CHECK(MCP4822_async_init(&device.handle, &async) == MCP4822_OK);
+
+	CHECK(MCP4822_write_to_both_chans_async(&device.handle, 10, request_done, &requests[0]) == MCP4822_OK);
+	CHECK(MCP4822_write_to_chan_async(&device.handle, 20, MCP4822_CHANNEL_B, request_done, &requests[1]) == MCP4822_OK);
+	service_spi(&device, 1);
+
+	CHECK(log.count == 2);
+	CHECK(log.status[0] == MCP4822_ERROR_SPI);
+	CHECK(log.status[1] == MCP4822_ERROR_SPI);
+
+	CHECK(MCP4822_async_init(&device.handle, NULL) == MCP4822_OK);
+}
+
+/**
+ * @brief An SPI has one interrupt owner at a time, the others get MCP4822_ERROR_BUSY until it lets go
+ */
+static void ownership(void){
+
+	Test_Device_t device;
+	MCP4822_Async_t async;
+	MCP4822_Stream_t stream;
+	MCP4822_Bus_t bus;
+	MCP4822_Bus_Device_t devices[1];
+	uint16_t buffer[STREAM_LEN];
+
+	test_device_init(&device);
+	CHECK(MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS) == MCP4822_OK);
+	CHECK(MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, silence_refill, NULL) == MCP4822_OK);
+
+	CHECK(MCP4822_async_init(&device.handle, &async) == MCP4822_OK);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_ERROR_BUSY);
+	CHECK(stream.state == MCP4822_STREAM_IDLE);
+	CHECK(MCP4822_bus_init(&bus, &device.spi, devices, 1, 1) == MCP4822_ERROR_BUSY);
+
+	//Interrupts without a transfer in flight are dropped by the owner
+	MCP4822_dispatch_tx_complete(&device.spi);
+	MCP4822_dispatch_tx_half_complete(&device.spi);
+	CHECK(MCP4822_async_pending(&device.handle) == 0);
+
+	CHECK(MCP4822_async_init(&device.handle, NULL) == MCP4822_OK);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+	CHECK(MCP4822_dispatch_owner(&device.spi) == MCP4822_DISPATCH_STREAM);
+	CHECK(MCP4822_async_init(&device.handle, &async) == MCP4822_ERROR_BUSY);
+	CHECK(device.handle.async == NULL);
+
+	//Half and full interrupts reach the stream through the dispatcher
+	uint32_t sent = device.spi.frames;
+	MCP4822_port_posix_dma_run(&device.tx_dma, STREAM_LEN);
+	CHECK(device.spi.half_pending && device.spi.pending);
+	device.spi.half_pending = 0;
+	device.spi.pending = 0;
+	MCP4822_dispatch_tx_half_complete(&device.spi);
+	MCP4822_dispatch_tx_complete(&device.spi);
+	CHECK(device.spi.frames == sent + STREAM_LEN);
+	CHECK(stream.state == MCP4822_STREAM_RUNNING);
+
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+	CHECK(MCP4822_dispatch_owner(&device.spi) == MCP4822_DISPATCH_NONE);
+
+	CHECK(MCP4822_bus_init(&bus, &device.spi, devices, 1, 1) == MCP4822_OK);
+	CHECK(MCP4822_dispatch_owner(&device.spi) == MCP4822_DISPATCH_BUS);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_ERROR_BUSY);
+	CHECK(MCP4822_bus_deinit(&bus) == MCP4822_OK);
+	CHECK(MCP4822_dispatch_owner(&device.spi) == MCP4822_DISPATCH_NONE);
+}
+
+int main(void){
+
+	fifo_order();
+	back_pressure();
+	error_routing();
+	ownership();
+
+	return test_result("test_async");
+}
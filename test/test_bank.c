@@ -0,0 +1,210 @@
+/*
+ * test_bank.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_bank.h"
+
+/** Assets in the test bank */
+#define TEST_ASSETS					   5
+
+/** Name slots of the test bank, a power of two above TEST_ASSETS */
+#define TEST_SLOTS					   8
+
+/** Mu-law samples in each test asset, asset i has TEST_SAMPLES + i */
+#define TEST_SAMPLES				   16U
+
+static const char *names[TEST_ASSETS] = { "bell", "chime", "alarm", "beep", "click" };
+
+/** Bank storage, words keep the tables aligned */
+static uint32_t image[1024];
+
+/**
+ * @brief Rounds a byte offset up to a whole word
+ */
+static uint32_t align4(uint32_t offset){
+
+	return (offset + 3) & ~3U;
+}
+
+/**
+ * @brief Lays out a bank of mu-law assets as the asset compiler does
+ *
+ * @return Bytes of the bank image
+ */
+static uint32_t bank_build(void){
+
+	uint8_t *bytes = (uint8_t *)image;
+	MCP4822_Bank_Header_t *header = (MCP4822_Bank_Header_t *)image;
+	MCP4822_Bank_Entry_t *entries = (MCP4822_Bank_Entry_t *)(bytes + sizeof(MCP4822_Bank_Header_t));
+	uint16_t *slots = (uint16_t *)&entries[TEST_ASSETS];
+	uint32_t offset = (uint32_t)((uint8_t *)&slots[TEST_SLOTS] - bytes);
+
+	memset(image, 0, sizeof(image));
+	header->magic = MCP4822_BANK_MAGIC;
+	header->version = MCP4822_BANK_VERSION;
+	header->asset_count = TEST_ASSETS;
+	header->hash_slots = TEST_SLOTS;
+	header->header_size = sizeof(MCP4822_Bank_Header_t);
+
+	for(uint32_t s = 0; s < TEST_SLOTS; s++){
+		slots[s] = MCP4822_BANK_SLOT_EMPTY;
+	}
+
+	//Names first, each reached from its hash slot by linear probing
+	for(uint16_t id = 0; id < TEST_ASSETS; id++){
+		entries[id].name_hash = MCP4822_bank_hash(names[id]);
+		entries[id].name_offset = offset;
+		strcpy((char *)&bytes[offset], names[id]);
+		offset += (uint32_t)strlen(names[id]) + 1;
+
+		uint32_t slot = entries[id].name_hash & (TEST_SLOTS - 1);
+		while(slots[slot] != MCP4822_BANK_SLOT_EMPTY){
+			slot = (slot + 1) & (TEST_SLOTS - 1);
+		}
+		slots[slot] = id;
+	}
+
+	//Then the asset images, word aligned
+	for(uint16_t id = 0; id < TEST_ASSETS; id++){
+		offset = align4(offset);
+
+		MCP4822_Asset_Header_t *asset = (MCP4822_Asset_Header_t *)&bytes[offset];
+		asset->magic = MCP4822_ASSET_MAGIC;
+		asset->version = MCP4822_ASSET_VERSION;
+		asset->codec = MCP4822_CODEC_ULAW;
+		asset->layout = MCP4822_LAYOUT_MONO;
+		asset->sample_rate = 8000;
+		asset->sample_count = TEST_SAMPLES + id;
+		asset->loop_end = asset->sample_count;
+		asset->header_size = sizeof(MCP4822_Asset_Header_t);
+		asset->payload_size = asset->sample_count;
+		memset(&bytes[offset + asset->header_size], 0xFF, asset->payload_size);
+
+		entries[id].offset = offset;
+		entries[id].length = asset->header_size + asset->payload_size;
+		entries[id].codec = MCP4822_CODEC_ULAW;
+		entries[id].layout = MCP4822_LAYOUT_MONO;
+		offset += entries[id].length;
+	}
+
+	header->total_size = align4(offset);
+
+	return header->total_size;
+}
+
+/**
+ * @brief Only a well formed header opens
+ */
+static void open_checks(void){
+
+	MCP4822_Bank_t bank;
+	MCP4822_Bank_Header_t *header = (MCP4822_Bank_Header_t *)image;
+	uint32_t size = bank_build();
+
+	CHECK(MCP4822_bank_open(image, size, &bank) == MCP4822_OK);
+	CHECK(MCP4822_bank_count(&bank) == TEST_ASSETS);
+	CHECK(MCP4822_bank_open(image, 0, &bank) == MCP4822_OK);
+	CHECK(MCP4822_bank_open(image, size - 4, &bank) == MCP4822_ERROR_FORMAT);
+	CHECK(MCP4822_bank_open((const uint8_t *)image + 2, 0, &bank) == MCP4822_ERROR_INVALID_ARG);
+
+	header->magic ^= 1;
+	CHECK(MCP4822_bank_open(image, size, &bank) == MCP4822_ERROR_FORMAT);
+	header->magic ^= 1;
+
+	header->version++;
+	CHECK(MCP4822_bank_open(image, size, &bank) == MCP4822_ERROR_FORMAT);
+	header->version--;
+
+	//The slot count must be a power of two with room to spare
+	header->hash_slots = 6;
+	CHECK(MCP4822_bank_open(image, size, &bank) == MCP4822_ERROR_FORMAT);
+	header->hash_slots = 4;
+	CHECK(MCP4822_bank_open(image, size, &bank) == MCP4822_ERROR_FORMAT);
+	header->hash_slots = TEST_SLOTS;
+
+	CHECK(MCP4822_bank_open(image, size, &bank) == MCP4822_OK);
+}
+
+/**
+ * @brief Every asset is reached by ID and by name, unknown IDs and names are not found
+ */
+static void find_and_get(void){
+
+	MCP4822_Bank_t bank;
+	MCP4822_Asset_t asset;
+	uint16_t id;
+
+	CHECK(MCP4822_bank_open(image, bank_build(), &bank) == MCP4822_OK);
+
+	for(uint16_t i = 0; i < TEST_ASSETS; i++){
+		CHECK(MCP4822_bank_find(&bank, names[i], &id) == MCP4822_OK);
+		CHECK(id == i);
+		CHECK(strcmp(MCP4822_bank_name(&bank, i), names[i]) == 0);
+
+		CHECK(MCP4822_bank_get(&bank, i, &asset) == MCP4822_OK);
+		CHECK(asset.header->sample_count == TEST_SAMPLES + i);
+
+		CHECK(MCP4822_bank_get_by_name(&bank, names[i], &asset) == MCP4822_OK);
+		CHECK(asset.header->sample_count == TEST_SAMPLES + i);
+	}
+
+	id = 0xBEEF;
+	CHECK(MCP4822_bank_find(&bank, "gong", &id) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(MCP4822_bank_find(&bank, "", &id) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(MCP4822_bank_find(&bank, "bel", &id) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(id == 0xBEEF);
+	CHECK(MCP4822_bank_get_by_name(&bank, "gong", &asset) == MCP4822_ERROR_INVALID_ARG);
+
+	CHECK(MCP4822_bank_get(&bank, TEST_ASSETS, &asset) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(MCP4822_bank_name(&bank, TEST_ASSETS) == NULL);
+
+	//An entry running past the bank is refused before its asset is read
+	MCP4822_Bank_Entry_t *entries = (MCP4822_Bank_Entry_t *)((uint8_t *)image + sizeof(MCP4822_Bank_Header_t));
+	entries[2].length = bank.header->total_size;
+	CHECK(MCP4822_bank_get(&bank, 2, &asset) == MCP4822_ERROR_FORMAT);
+}
+
+/**
+ * @brief A corrupt slot table with no empty slot ends the search after every slot
+ */
+static void full_table(void){
+
+	MCP4822_Bank_t bank;
+	uint16_t id;
+
+	CHECK(MCP4822_bank_open(image, bank_build(), &bank) == MCP4822_OK);
+
+	//Fill the free slots with an ID whose name never matches the probe
+	uint16_t *slots = (uint16_t *)bank.slots;
+	for(uint32_t s = 0; s < TEST_SLOTS; s++){
+		if(slots[s] == MCP4822_BANK_SLOT_EMPTY){
+			slots[s] = 0;
+		}
+	}
+
+	CHECK(MCP4822_bank_find(&bank, "gong", &id) == MCP4822_ERROR_INVALID_ARG);
+
+	//Names stored in the table are still found
+	for(uint16_t i = 0; i < TEST_ASSETS; i++){
+		CHECK(MCP4822_bank_find(&bank, names[i], &id) == MCP4822_OK && id == i);
+	}
+
+	//An ID past the table of contents stops the search
+	for(uint32_t s = 0; s < TEST_SLOTS; s++){
+		slots[s] = TEST_ASSETS;
+	}
+	CHECK(MCP4822_bank_find(&bank, "bell", &id) == MCP4822_ERROR_INVALID_ARG);
+}
+
+int main(void){
+
+	open_checks();
+	find_and_get();
+	full_table();
+
+	return test_result("test_bank");
+}
@@ -0,0 +1,226 @@
+/*
+ * test_bus.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_bus.h"
+#include "MCP4822_dispatch.h"
+
+/** Most devices simulated on the bus, one CS pin each on a shared port */
+#define TEST_DEVICES_MAX			   16
+
+/** Queue length of every device */
+#define TEST_QUEUE					   32
+
+/** Frames pushed through the bus by each throughput run */
+#define TEST_FRAMES					   400000
+
+/**
+ * @brief Devices sharing one host SPI, with the interrupt played by the test
+ */
+typedef struct
+{
+
+	Test_Device_t host;
+
+	MCP4822_Bus_t bus;
+
+	MCP4822_Bus_Device_t slots[TEST_DEVICES_MAX];
+
+	MCP4822_Handle_t handles[TEST_DEVICES_MAX];
+
+	uint16_t queues[TEST_DEVICES_MAX][TEST_QUEUE];
+
+	uint32_t device_count;
+
+	uint32_t next_value[TEST_DEVICES_MAX];
+
+	uint32_t expected[TEST_DEVICES_MAX];
+
+	uint32_t last_turn_end[TEST_DEVICES_MAX];
+
+	uint32_t longest_wait;
+
+	uint32_t wrong_cs;
+
+	uint32_t wrong_order;
+
+}Bus_Rig_t;
+
+static Bus_Rig_t rig;
+
+/**
+ * @brief Sets up a bus with device_count devices attached
+ *
+ * @param device_count - number of devices, at most TEST_DEVICES_MAX
+ * @param quantum - frames per turn
+ *
+ * @return None
+ */
+static void rig_init(uint32_t device_count, uint32_t quantum){
+
+	test_device_init(&rig.host);
+
+	//Every CS idles high, a device is selected while its pin is low
+	rig.host.gpio.levels = (1U << TEST_DEVICES_MAX) - 1;
+	rig.device_count = device_count;
+	rig.longest_wait = 0;
+	rig.wrong_cs = 0;
+	rig.wrong_order = 0;
+
+	CHECK(MCP4822_bus_init(&rig.bus, &rig.host.spi, rig.slots, device_count, quantum) == MCP4822_OK);
+
+	for(uint32_t d = 0; d < device_count; d++){
+		CHECK(MCP4822_handle_init(&rig.handles[d], &rig.host.gpio, (uint16_t)(1U << d), &rig.host.spi) == MCP4822_OK);
+		CHECK(MCP4822_bus_attach(&rig.bus, d, &rig.handles[d], rig.queues[d], TEST_QUEUE) == MCP4822_OK);
+		rig.next_value[d] = d;
+		rig.expected[d] = d;
+		rig.last_turn_end[d] = 0;
+	}
+}
+
+/**
+ * @brief Plays one SPI interrupt, checking which CS frames the word and that each device's words arrive in order
+ *
+ * @return 1 if a frame was in flight, 0 once the bus is idle
+ */
+static uint8_t rig_service(void){
+
+	if(!rig.host.spi.pending){
+		return 0;
+	}
+	rig.host.spi.pending = 0;
+
+	//Exactly one CS must be low while a word is on the bus
+	uint32_t selected = ~rig.host.gpio.levels & ((1U << rig.device_count) - 1);
+	if(selected == 0 || (selected & (selected - 1)) != 0){
+		rig.wrong_cs++;
+	}
+	else{
+		uint32_t d = (uint32_t)__builtin_ctz(selected);
+		uint32_t frames = rig.host.spi.frames;
+
+		//Frames sent to other devices since this device's previous frame
+		if(rig.last_turn_end[d] != 0 && frames - rig.last_turn_end[d] - 1 > rig.longest_wait){
+			rig.longest_wait = frames - rig.last_turn_end[d] - 1;
+		}
+		rig.last_turn_end[d] = frames;
+
+		rig.wrong_order += ((rig.host.spi.last_frame & MCP4822_FRAME_DATA_MASK) != (rig.expected[d] & MCP4822_DAC_MAX));
+		rig.expected[d] += rig.device_count;
+	}
+
+	MCP4822_dispatch_tx_complete(&rig.host.spi);
+
+	return 1;
+}
+
+/**
+ * @brief Keeps every queue topped up with channel pairs and serves the bus until frames have been sent
+ *
+ * @param frames - number of frames to send
+ *
+ * @return None
+ */
+static void rig_run(uint32_t frames){
+
+	uint32_t target = rig.host.spi.frames + frames;
+
+	while(rig.host.spi.frames < target){
+
+		for(uint32_t d = 0; d < rig.device_count; d++){
+			while(MCP4822_bus_pending(&rig.bus, d) + 2 <= TEST_QUEUE){
+				uint16_t a = (uint16_t)(rig.next_value[d] & MCP4822_DAC_MAX);
+				uint16_t b = (uint16_t)((rig.next_value[d] + rig.device_count) & MCP4822_DAC_MAX);
+
+				CHECK(MCP4822_bus_write_pair(&rig.bus, d, a, b) == MCP4822_OK);
+				rig.next_value[d] += 2 * rig.device_count;
+			}
+		}
+
+		//One round of turns, then the producers refill
+		for(uint32_t i = 0; i < rig.device_count * rig.bus.quantum; i++){
+			rig_service();
+		}
+	}
+
+	while(rig_service()){
+	}
+}
+
+/**
+ * @brief A write longer than the queue is a bad argument, a write that only lacks room right now is busy
+ */
+static void capacity(void){
+
+	uint16_t frames[TEST_QUEUE + 1] = {0};
+
+	rig_init(1, 2);
+
+	CHECK(MCP4822_bus_write_frames(&rig.bus, 0, frames, TEST_QUEUE + 1) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(MCP4822_bus_pending(&rig.bus, 0) == 0);
+	CHECK(MCP4822_bus_write_frames(&rig.bus, 0, frames, TEST_QUEUE) == MCP4822_OK);
+	CHECK(MCP4822_bus_write_frames(&rig.bus, 0, frames, 1) == MCP4822_ERROR_BUSY);
+
+	//Even with the queue drained, an oversized write is refused the same way
+	while(rig_service()){
+	}
+	CHECK(MCP4822_bus_pending(&rig.bus, 0) == 0);
+	CHECK(MCP4822_bus_write_frames(&rig.bus, 0, frames, TEST_QUEUE + 1) == MCP4822_ERROR_INVALID_ARG);
+
+	CHECK(MCP4822_bus_deinit(&rig.bus) == MCP4822_OK);
+}
+
+/**
+ * @brief Backlogged devices share the bus in equal turns, without two CS pins low at once, and each device's frames stay in order
+ *
+ * @param device_count - number of devices simulated
+ */
+static void fairness(uint32_t device_count){
+
+	const uint32_t quantum = 2;
+
+	rig_init(device_count, quantum);
+
+	uint64_t start = bench_now();
+	struct timespec begin;
+	struct timespec end;
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+
+	rig_run(TEST_FRAMES);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	uint64_t elapsed = bench_now() - start;
+	double seconds = (double)(end.tv_sec - begin.tv_sec) + (double)(end.tv_nsec - begin.tv_nsec) * 1e-9;
+
+	uint32_t fewest = UINT32_MAX;
+	uint32_t most = 0;
+	for(uint32_t d = 0; d < device_count; d++){
+		fewest = (rig.slots[d].sent < fewest) ? rig.slots[d].sent : fewest;
+		most = (rig.slots[d].sent > most) ? rig.slots[d].sent : most;
+		CHECK(rig.slots[d].errors == 0);
+	}
+
+	printf("  %2u devices: %10.0f frames/s aggregate, %6.1f %s per frame, sent per device %u .. %u, longest wait %u frames\n",
+		   device_count, (double)rig.host.spi.frames / seconds, (double)elapsed / rig.host.spi.frames, BENCH_UNIT, fewest, most,
+		   rig.longest_wait);
+
+	//A device waits for every other device's turn at most, and turns are whole pairs
+	CHECK(rig.wrong_cs == 0);
+	CHECK(rig.wrong_order == 0);
+	CHECK(rig.longest_wait <= (device_count - 1) * quantum);
+	CHECK(most - fewest <= quantum);
+
+	CHECK(MCP4822_bus_deinit(&rig.bus) == MCP4822_OK);
+}
+
+int main(void){
+
+	capacity();
+	fairness(8);
+	fairness(TEST_DEVICES_MAX);
+
+	return test_result("test_bus");
+}
@@ -0,0 +1,140 @@
+/*
+ * test_cal.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+#include "MCP4822_cal.h"
+#include "MCP4822_block.h"
+
+/** Offsets in codes of the test calibration, one per gain, channel B's are doubled */
+#define TEST_OFFSET_1X				   10
+#define TEST_OFFSET_2X				   (-20)
+
+/**
+ * @brief Sets up a calibration whose offset tells which channel and gain correction was used
+ *
+ * @param cal - calibration to be set
+ *
+ * @return None
+ */
+static void cal_setup(MCP4822_Cal_t *cal){
+
+	MCP4822_cal_init(cal);
+
+	for(uint32_t chan = 0; chan < 2; chan++){
+		cal->chans[chan][MCP4822_GAIN_1X].offset_q16 = TEST_OFFSET_1X * (int32_t)(chan + 1) * MCP4822_CAL_GAIN_UNITY;
+		cal->chans[chan][MCP4822_GAIN_2X].offset_q16 = TEST_OFFSET_2X * (int32_t)(chan + 1) * MCP4822_CAL_GAIN_UNITY;
+	}
+}
+
+/**
+ * @brief Writes use the correction of the channel's current gain
+ */
+static void gain_keyed(void){
+
+	Test_Device_t device;
+	MCP4822_Cal_t cal;
+	uint16_t frames[4];
+
+	test_device_init(&device);
+	cal_setup(&cal);
+	MCP4822_attach_cal(&device.handle, &cal);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 1000 + TEST_OFFSET_1X);
+
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_B, MCP4822_GAIN_2X) == MCP4822_OK);
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_B) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 1000 + 2 * TEST_OFFSET_2X);
+
+	//Block conversions pick the correction from the gain in the frame header
+	float volts[4] = { 0.1f, 0.5f, 1.0f, 1.5f };
+	MCP4822_volts_to_frames(&device.handle, volts, frames, 4, MCP4822_CHANNEL_B);
+	for(uint32_t i = 0; i < 4; i++){
+		uint16_t ideal = (uint16_t)(volts[i] * MCP4822_chan_volt_scale(&device.handle, MCP4822_CHANNEL_B) + 0.5f);
+		CHECK((frames[i] & MCP4822_FRAME_DATA_MASK) == ideal + 2 * TEST_OFFSET_2X);
+	}
+}
+
+/**
+ * @brief A gain change re-sends the level corrected for the new gain, not the code corrected for the old one
+ */
+static void gain_change(void){
+
+	Test_Device_t device;
+	MCP4822_Cal_t cal;
+	MCP4822_Chan_Configs_t configs;
+
+	test_device_init(&device);
+	cal_setup(&cal);
+	MCP4822_attach_cal(&device.handle, &cal);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 2000, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_A, MCP4822_GAIN_2X) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 2000 + TEST_OFFSET_2X);
+	CHECK(((device.spi.last_frame >> MCP4822_FRAME_GAIN_POS) & 1) == MCP4822_GAIN_2X);
+
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_A, MCP4822_GAIN_1X) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 2000 + TEST_OFFSET_1X);
+
+	//Shutdown keeps the gain, the code is left as it is
+	CHECK(MCP4822_shutdown_chan(&device.handle, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 2000 + TEST_OFFSET_1X);
+	CHECK(MCP4822_activate_chan(&device.handle, MCP4822_CHANNEL_A) == MCP4822_OK);
+
+	//configure switches both channels on one update, each re-corrected
+	CHECK(MCP4822_write_pair(&device.handle, 300, 400) == MCP4822_OK);
+	configs.chan_A_config.gain = MCP4822_GAIN_2X;
+	configs.chan_A_config.shutdown = MCP4822_ACTIVE_MODE;
+	configs.chan_B_config.gain = MCP4822_GAIN_2X;
+	configs.chan_B_config.shutdown = MCP4822_ACTIVE_MODE;
+	CHECK(MCP4822_configure(&device.handle, &configs) == MCP4822_OK);
+	CHECK((device.handle.shadow_frames[MCP4822_CHANNEL_A] & MCP4822_FRAME_DATA_MASK) == 300 + TEST_OFFSET_2X);
+	CHECK((device.handle.shadow_frames[MCP4822_CHANNEL_B] & MCP4822_FRAME_DATA_MASK) == 400 + 2 * TEST_OFFSET_2X);
+
+	//A raw frame sent after the corrected write is re-sent as it is
+	uint16_t raw = MCP4822_encode_frame(&device.handle, 777, MCP4822_CHANNEL_A);
+	CHECK(MCP4822_write_frames(&device.handle, &raw, 1) == MCP4822_OK);
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_A, MCP4822_GAIN_1X) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 777);
+}
+
+/**
+ * @brief A fit recovers the gain and offset of measured points
+ */
+static void fit(void){
+
+	MCP4822_Cal_t cal;
+	uint16_t codes[] = { 100, 1000, 2000, 3000, 4000 };
+	float volts[5];
+
+	MCP4822_cal_init(&cal);
+
+	//2 % high with 5 mV of offset at 1x gain, 2 codes per mV
+	for(uint32_t i = 0; i < 5; i++){
+		volts[i] = codes[i] * 1.02f / 2000.0f + 0.005f;
+	}
+
+	CHECK(MCP4822_cal_fit(&cal.chans[MCP4822_CHANNEL_A][MCP4822_GAIN_1X], codes, volts, 5, 2000.0f) == MCP4822_OK);
+	for(uint16_t code = 0; code <= 4000; code += 500){
+		uint16_t sent = MCP4822_cal_apply(&cal, MCP4822_CHANNEL_A, MCP4822_GAIN_1X, code);
+		float out = sent * 1.02f / 2000.0f + 0.005f;
+		if(sent > 0){
+			CHECK(out * 2000.0f - code < 1.0f && code - out * 2000.0f < 1.0f);
+		}
+	}
+
+	//The other gain's correction is untouched
+	CHECK(MCP4822_cal_apply(&cal, MCP4822_CHANNEL_A, MCP4822_GAIN_2X, 1234) == 1234);
+}
+
+int main(void){
+
+	gain_keyed();
+	gain_change();
+	fit();
+
+	return test_result("test_cal");
+}
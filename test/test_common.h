@@ -0,0 +1,115 @@
+/*
+ * test_common.h
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+
+#ifndef __TEST_COMMON_H_
+#define __TEST_COMMON_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include "MCP4822.h"
+
+/**
+ * Shared pieces of the host tests and benchmarks. Everything builds against
+ * the POSIX binding, see MCP4822_port_posix.h, except the SPI backend
+ * benchmark, which builds the default binding against stm32_standin/.
+ */
+
+/** Failed checks of the running test program */
+static uint32_t test_failures;
+
+/** Records a failed condition without stopping the test */
+#define CHECK(cond)																	\
+	do{																				\
+		if(!(cond)){																\
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);		\
+			test_failures++;														\
+		}																			\
+	}while(0)
+
+/** Keeps a benchmark result alive without a store the compiler could drop */
+#define BENCH_KEEP(value)			   __asm__ volatile("" : : "r"(value) : "memory")
+
+/**
+ * @brief Host devices behind one test handle
+ */
+typedef struct
+{
+
+	MCP4822_Handle_t handle;
+
+	MCP4822_Gpio_t gpio;
+
+	MCP4822_Spi_t spi;
+
+	MCP4822_Dma_t tx_dma;
+
+	MCP4822_Dma_t timer_dma;
+
+	MCP4822_Timer_t timer;
+
+}Test_Device_t;
+
+#ifdef MCP4822_PORT_POSIX
+/**
+ * @brief Sets up a handle on a host SPI whose TX DMA and timer update DMA channels are circular
+ *
+ * @param device - devices to be initialized
+ *
+ * @return None
+ */
+static inline void test_device_init(Test_Device_t *device){
+
+	MCP4822_port_posix_dma_init(&device->tx_dma, 1);
+	MCP4822_port_posix_dma_init(&device->timer_dma, 1);
+	MCP4822_port_posix_spi_init(&device->spi, -1, &device->tx_dma);
+	MCP4822_port_posix_timer_init(&device->timer, &device->timer_dma);
+	MCP4822_port_posix_gpio_init(&device->gpio);
+
+	CHECK(MCP4822_handle_init(&device->handle, &device->gpio, 1, &device->spi) == MCP4822_OK);
+}
+#endif
+
+/**
+ * @brief Reads the benchmark clock
+ *
+ * @return Time stamp counter cycles on x86, nanoseconds elsewhere
+ */
+static inline uint64_t bench_now(void){
+
+#if defined(__x86_64__) || defined(__i386__)
+	uint32_t low, high;
+	__asm__ volatile("rdtsc" : "=a"(low), "=d"(high));
+	return ((uint64_t)high << 32) | low;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/** Unit of bench_now differences */
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_UNIT					   "cycles"
+#else
+#define BENCH_UNIT					   "ns"
+#endif
+
+/**
+ * @brief Prints the test verdict
+ *
+ * @param name - test program name
+ *
+ * @return Process exit status
+ */
+static inline int test_result(const char *name){
+
+	printf("%s: %s\n", name, (test_failures == 0) ? "PASS" : "FAIL");
+
+	return (test_failures == 0) ? 0 : 1;
+}
+
+#endif /* __TEST_COMMON_H_ */
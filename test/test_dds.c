@@ -0,0 +1,165 @@
+/*
+ * test_dds.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <math.h>
+#include "test_common.h"
+#include "MCP4822_dds.h"
+
+/** Points of the spectrum, the sine completes a whole number of cycles in them */
+#define TEST_FFT_POINTS				   4096
+
+/** Sample rate giving 10 Hz FFT bins */
+#define TEST_RATE					   40960
+
+/** Frames compared between the odd and the even refills */
+#define TEST_FRAMES					   600
+
+static double fft_re[TEST_FFT_POINTS];
+
+static double fft_im[TEST_FFT_POINTS];
+
+/**
+ * @brief In-place radix-2 FFT of fft_re/fft_im
+ */
+static void fft(void){
+
+	const double pi = 3.14159265358979323846;
+
+	for(uint32_t i = 1, j = 0; i < TEST_FFT_POINTS; i++){
+		uint32_t bit = TEST_FFT_POINTS >> 1;
+		for(; j & bit; bit >>= 1){
+			j ^= bit;
+		}
+		j ^= bit;
+
+		if(i < j){
+			double re = fft_re[i], im = fft_im[i];
+			fft_re[i] = fft_re[j];
+			fft_im[i] = fft_im[j];
+			fft_re[j] = re;
+			fft_im[j] = im;
+		}
+	}
+
+	for(uint32_t len = 2; len <= TEST_FFT_POINTS; len <<= 1){
+		double angle = -2.0 * pi / len;
+		for(uint32_t i = 0; i < TEST_FFT_POINTS; i += len){
+			for(uint32_t k = 0; k < len / 2; k++){
+				double w_re = cos(angle * k), w_im = sin(angle * k);
+				double *a_re = &fft_re[i + k], *a_im = &fft_im[i + k];
+				double *b_re = &fft_re[i + k + len / 2], *b_im = &fft_im[i + k + len / 2];
+				double t_re = *b_re * w_re - *b_im * w_im;
+				double t_im = *b_re * w_im + *b_im * w_re;
+
+				*b_re = *a_re - t_re;
+				*b_im = *a_im - t_im;
+				*a_re += t_re;
+				*a_im += t_im;
+			}
+		}
+	}
+}
+
+/**
+ * @brief Refills of any length, odd ones included, give the same A/B frame sequence
+ */
+static void odd_count(void){
+
+	static const uint32_t lengths[] = { 7, 1, 2, 13, 64, 3, 33 };
+	Test_Device_t device;
+	MCP4822_DDS_t reference;
+	MCP4822_DDS_t dds;
+	uint16_t expected[TEST_FRAMES];
+	uint16_t frames[TEST_FRAMES];
+
+	test_device_init(&device);
+
+	MCP4822_DDS_t *engines[2] = { &reference, &dds };
+	for(uint32_t e = 0; e < 2; e++){
+		CHECK(MCP4822_dds_init(engines[e], &device.handle, 48000) == MCP4822_OK);
+		CHECK(MCP4822_dds_configure(engines[e], MCP4822_CHANNEL_A, MCP4822_WAVE_SINE, 1000000, MCP4822_DDS_FULL_SCALE) == MCP4822_OK);
+		CHECK(MCP4822_dds_configure(engines[e], MCP4822_CHANNEL_B, MCP4822_WAVE_TRIANGLE, 3000000, 20000) == MCP4822_OK);
+	}
+
+	CHECK(MCP4822_dds_refill(&reference, expected, TEST_FRAMES) == TEST_FRAMES);
+
+	uint32_t done = 0;
+	for(uint32_t i = 0; done < TEST_FRAMES; i++){
+		uint32_t count = lengths[i % (sizeof(lengths) / sizeof(lengths[0]))];
+		if(count > TEST_FRAMES - done){
+			count = TEST_FRAMES - done;
+		}
+		CHECK(MCP4822_dds_refill(&dds, &frames[done], count) == count);
+		done += count;
+	}
+
+	uint32_t wrong = 0;
+	for(uint32_t i = 0; i < TEST_FRAMES; i++){
+		wrong += (frames[i] != expected[i]);
+		CHECK((frames[i] >> MCP4822_FRAME_CHAN_POS) == (i & 1));
+	}
+	CHECK(wrong == 0);
+}
+
+/**
+ * @brief The sine's spurs and noise stay near the 12-bit quantization floor
+ */
+static void sine_purity(void){
+
+	static const uint32_t bins[] = { 1, 127, 1021, 1843 };
+	Test_Device_t device;
+	MCP4822_DDS_t dds;
+	uint16_t frames[TEST_FFT_POINTS];
+
+	test_device_init(&device);
+
+	for(uint32_t b = 0; b < sizeof(bins) / sizeof(bins[0]); b++){
+		uint32_t bin = bins[b];
+
+		//Coherent sampling: a whole number of cycles, so no window is needed
+		CHECK(MCP4822_dds_init(&dds, &device.handle, TEST_RATE) == MCP4822_OK);
+		CHECK(MCP4822_dds_configure(&dds, MCP4822_CHANNEL_A, MCP4822_WAVE_SINE, bin * (TEST_RATE / TEST_FFT_POINTS) * 1000,
+									MCP4822_DDS_FULL_SCALE) == MCP4822_OK);
+		MCP4822_dds_render(&dds, MCP4822_CHANNEL_A, frames, TEST_FFT_POINTS);
+
+		for(uint32_t i = 0; i < TEST_FFT_POINTS; i++){
+			fft_re[i] = (double)(frames[i] & MCP4822_FRAME_DATA_MASK);
+			fft_im[i] = 0.0;
+		}
+		fft();
+
+		double signal = 0.0;
+		double noise = 0.0;
+		double spur = 0.0;
+		for(uint32_t k = 1; k <= TEST_FFT_POINTS / 2; k++){
+			double power = fft_re[k] * fft_re[k] + fft_im[k] * fft_im[k];
+			if(k == bin){
+				signal = power;
+			}
+			else{
+				noise += power;
+				spur = (power > spur) ? power : spur;
+			}
+		}
+
+		double sinad = 10.0 * log10(signal / noise);
+		double sfdr = 10.0 * log10(signal / spur);
+		printf("  sine at %5u Hz: SINAD %5.1f dB (%4.1f bits), SFDR %5.1f dBc\n", bin * (TEST_RATE / TEST_FFT_POINTS), sinad,
+			   (sinad - 1.76) / 6.02, sfdr);
+
+		//An ideal 12-bit sine gives 74 dB SINAD, the interpolated table may cost a third of a bit at most
+		CHECK(sinad > 72.0);
+		CHECK(sfdr > 85.0);
+	}
+}
+
+int main(void){
+
+	odd_count();
+	sine_purity();
+
+	return test_result("test_dds");
+}
@@ -0,0 +1,130 @@
+/*
+ * test_driver.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+
+/** Inputs of each unit scale, indexed like MCP4822_VOLT_UNIT */
+static const int64_t unit_per_volt[3] = { 1000, 1000000, 65536 };
+
+/**
+ * @brief Hardware NSS mode needs CPHA = 0, where the SPI pulses NSS between frames
+ */
+static void cs_mode_phase(void){
+
+	Test_Device_t device;
+
+	test_device_init(&device);
+	CHECK(device.handle.cs_mode == MCP4822_CS_SOFTWARE);
+
+	device.spi.cpha = 1;
+	CHECK(MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(device.handle.cs_mode == MCP4822_CS_SOFTWARE);
+	CHECK(!device.spi.hardware_nss);
+	CHECK(MCP4822_set_cs_mode(&device.handle, MCP4822_CS_SOFTWARE) == MCP4822_OK);
+
+	device.spi.cpha = 0;
+	CHECK(MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS) == MCP4822_OK);
+	CHECK(device.handle.cs_mode == MCP4822_CS_HARDWARE_NSS);
+	CHECK(device.spi.hardware_nss);
+
+	//A pulse mode setup left by the SPI init code is only adopted in the right phase
+	device.spi.cpha = 1;
+	CHECK(MCP4822_handle_init(&device.handle, &device.gpio, 1, &device.spi) == MCP4822_OK);
+	CHECK(device.handle.cs_mode == MCP4822_CS_SOFTWARE);
+
+	device.spi.cpha = 0;
+	CHECK(MCP4822_handle_init(&device.handle, &device.gpio, 1, &device.spi) == MCP4822_OK);
+	CHECK(device.handle.cs_mode == MCP4822_CS_HARDWARE_NSS);
+}
+
+/**
+ * @brief handle_init switches the SPI to 16-bit frames and reports the result
+ */
+static void init_data_size(void){
+
+	Test_Device_t device;
+
+	test_device_init(&device);
+
+	device.spi.format = 8;
+	CHECK(MCP4822_handle_init(&device.handle, &device.gpio, 1, &device.spi) == MCP4822_OK);
+	CHECK(device.spi.format == MCP4822_PORT_SPI_16BIT);
+
+	CHECK(MCP4822_handle_init(&device.handle, &device.gpio, 1, &device.spi) == MCP4822_OK);
+	CHECK(device.spi.format == MCP4822_PORT_SPI_16BIT);
+}
+
+/**
+ * @brief Every integer input converts to the correctly rounded, saturated code and stays within a code of the float path
+ */
+static void fixed_volts_exhaustive(void){
+
+	static const MCP4822_OUTPUT_GAIN gains[2] = { MCP4822_GAIN_2X, MCP4822_GAIN_1X };
+	static const char *unit_names[3] = { "mV", "uV", "Q16.16" };
+	Test_Device_t device;
+
+	test_device_init(&device);
+
+	for(uint32_t g = 0; g < 2; g++){
+		CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_A, gains[g]) == MCP4822_OK);
+
+		//Codes per volt at this gain
+		int64_t codes = (gains[g] == MCP4822_GAIN_2X) ? 1000 : 2000;
+
+		for(uint32_t unit = 0; unit < 3; unit++){
+			int64_t per_volt = unit_per_volt[unit];
+			int64_t last = (int64_t)(MCP4822_DAC_MAX + 2) * per_volt / codes + 64;
+			uint32_t wrong = 0;
+			uint32_t float_off = 0;
+
+			for(int64_t value = -64; value <= last; value++){
+
+				//Round half up on the exact ratio, then saturate
+				int64_t exact = (value * codes * 2 + per_volt) / (per_volt * 2);
+				if(value * codes * 2 + per_volt < 0){
+					exact = 0;
+				}
+				if(exact > MCP4822_DAC_MAX){
+					exact = MCP4822_DAC_MAX;
+				}
+
+				uint16_t fixed = 0xFFFF;
+				CHECK(MCP4822_fixed_volts_to_chan_units(&device.handle, (int32_t)value, (MCP4822_VOLT_UNIT)unit, MCP4822_CHANNEL_A, &fixed) == MCP4822_OK);
+				uint16_t from_float = MCP4822_volts_to_chan_units(&device.handle, (float)((double)value / per_volt), MCP4822_CHANNEL_A);
+
+				wrong += (fixed != exact);
+				float_off += (fixed != from_float);
+				CHECK(fixed - from_float <= 1 && from_float - fixed <= 1);
+			}
+
+			printf("  gain %s %-6s: %8lld inputs, %u off the exact code, %u off the float path by one code\n",
+				   (gains[g] == MCP4822_GAIN_2X) ? "2X" : "1X", unit_names[unit], (long long)(last + 65), wrong, float_off);
+			CHECK(wrong == 0);
+		}
+
+		//Extremes saturate instead of wrapping
+		uint16_t code;
+		CHECK(MCP4822_fixed_volts_to_chan_units(&device.handle, INT32_MAX, MCP4822_UNIT_MICROVOLTS, MCP4822_CHANNEL_A, &code) == MCP4822_OK);
+		CHECK(code == MCP4822_DAC_MAX);
+		CHECK(MCP4822_fixed_volts_to_chan_units(&device.handle, INT32_MIN, MCP4822_UNIT_Q16_VOLTS, MCP4822_CHANNEL_A, &code) == MCP4822_OK);
+		CHECK(code == 0);
+
+		//An unknown unit is refused before it reaches the scale table
+		code = 1234;
+		CHECK(MCP4822_fixed_volts_to_chan_units(&device.handle, 1000, (MCP4822_VOLT_UNIT)3, MCP4822_CHANNEL_A, &code) == MCP4822_ERROR_INVALID_ARG);
+		CHECK(MCP4822_fixed_volts_to_chan_units(&device.handle, 1000, (MCP4822_VOLT_UNIT)255, MCP4822_CHANNEL_A, &code) == MCP4822_ERROR_INVALID_ARG);
+		CHECK(code == 1234);
+	}
+}
+
+int main(void){
+
+	cs_mode_phase();
+	init_data_size();
+	fixed_volts_exhaustive();
+
+	return test_result("test_driver");
+}
@@ -0,0 +1,230 @@
+/*
+ * test_fifo.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "test_common.h"
+#include "MCP4822_fifo.h"
+
+/** Frames moved through the FIFO by the stress test */
+#define STRESS_FRAMES				   (2U * 1024U * 1024U)
+
+/** FIFO length of the stress test, small so both ends wrap and collide often */
+#define STRESS_CAPACITY				   64
+
+/**
+ * @brief State shared by the producer and consumer threads
+ */
+typedef struct
+{
+
+	MCP4822_Fifo_t fifo;
+
+	uint16_t storage[STRESS_CAPACITY];
+
+	pthread_t producer;
+
+	pthread_t consumer;
+
+	atomic_uint high_calls;
+
+	atomic_uint low_calls;
+
+	atomic_uint wrong_thread;
+
+	atomic_uint go;
+
+	uint32_t out_of_order;
+
+	uint32_t bad_level;
+
+}Stress_t;
+
+static void on_high(void *context, uint32_t level){
+
+	Stress_t *stress = (Stress_t *)context;
+
+	atomic_fetch_add(&stress->high_calls, 1);
+	if(!pthread_equal(pthread_self(), stress->producer) || level > STRESS_CAPACITY){
+		atomic_fetch_add(&stress->wrong_thread, 1);
+	}
+}
+
+static void on_low(void *context, uint32_t level){
+
+	Stress_t *stress = (Stress_t *)context;
+
+	atomic_fetch_add(&stress->low_calls, 1);
+	if(!pthread_equal(pthread_self(), stress->consumer) || level > STRESS_CAPACITY){
+		atomic_fetch_add(&stress->wrong_thread, 1);
+	}
+}
+
+/**
+ * @brief Main loop stand-in: pushes a frame counter in chunks of varying size
+ */
+static void *producer_thread(void *argument){
+
+	Stress_t *stress = (Stress_t *)argument;
+	uint16_t chunk[17];
+	uint32_t next = 0;
+	uint32_t size = 1;
+
+	while(!atomic_load(&stress->go)){
+		sched_yield();
+	}
+
+	while(next < STRESS_FRAMES){
+		uint32_t offer = (STRESS_FRAMES - next < size) ? STRESS_FRAMES - next : size;
+		for(uint32_t i = 0; i < offer; i++){
+			chunk[i] = (uint16_t)(next + i);
+		}
+
+		uint32_t pushed = MCP4822_fifo_push(&stress->fifo, chunk, offer);
+		next += pushed;
+
+		//A full FIFO waits for the other side, which may share the core
+		if(pushed == 0){
+			sched_yield();
+		}
+
+		//Rejected frames are offered again, only the accepted prefix counts
+		if(MCP4822_fifo_level(&stress->fifo) > STRESS_CAPACITY){
+			stress->bad_level++;
+		}
+
+		size = (size % 17) + 1;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief ISR stand-in: pops in chunks of varying size and checks the counter runs on unbroken
+ */
+static void *consumer_thread(void *argument){
+
+	Stress_t *stress = (Stress_t *)argument;
+	uint16_t chunk[13];
+	uint32_t expected = 0;
+	uint32_t size = 1;
+
+	while(!atomic_load(&stress->go)){
+		sched_yield();
+	}
+
+	while(expected < STRESS_FRAMES){
+		uint32_t popped = MCP4822_fifo_pop(&stress->fifo, chunk, size);
+		if(popped == 0){
+			sched_yield();
+		}
+
+		for(uint32_t i = 0; i < popped; i++){
+			if(chunk[i] != (uint16_t)expected){
+				stress->out_of_order++;
+			}
+			expected++;
+		}
+
+		if(MCP4822_fifo_space(&stress->fifo) > STRESS_CAPACITY){
+			stress->bad_level++;
+		}
+
+		size = (size % 13) + 1;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Two threads standing in for main loop and ISR move every frame once, in order
+ */
+static void two_thread_stress(void){
+
+	static Stress_t stress;
+
+	CHECK(MCP4822_fifo_init(&stress.fifo, stress.storage, STRESS_CAPACITY));
+	MCP4822_fifo_set_watermarks(&stress.fifo, 48, on_high, 16, on_low, &stress);
+	atomic_init(&stress.high_calls, 0);
+	atomic_init(&stress.low_calls, 0);
+	atomic_init(&stress.wrong_thread, 0);
+	atomic_init(&stress.go, 0);
+
+	//Both thread ids must be known before either side can cross a watermark
+	CHECK(pthread_create(&stress.consumer, NULL, consumer_thread, &stress) == 0);
+	CHECK(pthread_create(&stress.producer, NULL, producer_thread, &stress) == 0);
+	atomic_store(&stress.go, 1);
+
+	pthread_join(stress.producer, NULL);
+	pthread_join(stress.consumer, NULL);
+
+	printf("  %u frames through a %u frame FIFO: %u out of order, %u high and %u low watermark calls\n",
+		   STRESS_FRAMES, STRESS_CAPACITY, stress.out_of_order, atomic_load(&stress.high_calls), atomic_load(&stress.low_calls));
+
+	CHECK(stress.out_of_order == 0);
+	CHECK(stress.bad_level == 0);
+	CHECK(atomic_load(&stress.wrong_thread) == 0);
+	CHECK(MCP4822_fifo_level(&stress.fifo) == 0);
+}
+
+/** Watermark calls of the single-threaded test, high then low */
+static uint32_t calls[2];
+
+static void count_high(void *context, uint32_t level){
+
+	(void)context;
+	(void)level;
+	calls[0]++;
+}
+
+static void count_low(void *context, uint32_t level){
+
+	(void)context;
+	(void)level;
+	calls[1]++;
+}
+
+/**
+ * @brief Watermarks fire once per crossing and an empty FIFO holds the last frame as a stream source
+ */
+static void watermarks_and_underrun(void){
+
+	MCP4822_Fifo_t fifo;
+	uint16_t storage[8];
+	uint16_t frames[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+	uint16_t out[8];
+
+	CHECK(!MCP4822_fifo_init(&fifo, storage, 6));
+	CHECK(MCP4822_fifo_init(&fifo, storage, 8));
+	MCP4822_fifo_set_watermarks(&fifo, 6, count_high, 2, count_low, NULL);
+
+	CHECK(MCP4822_fifo_push(&fifo, frames, 5) == 5);
+	CHECK(calls[0] == 0);
+	CHECK(MCP4822_fifo_push(&fifo, frames, 5) == 3);
+	CHECK(calls[0] == 1);
+	CHECK(MCP4822_fifo_space(&fifo) == 0);
+
+	CHECK(MCP4822_fifo_pop(&fifo, out, 5) == 5);
+	CHECK(calls[1] == 0);
+	CHECK(MCP4822_fifo_pop(&fifo, out, 1) == 1);
+	CHECK(calls[1] == 1);
+	CHECK(MCP4822_fifo_pop(&fifo, out, 1) == 1);
+	CHECK(calls[1] == 1);
+
+	//One frame left, then the refill repeats it and counts the underrun
+	CHECK(MCP4822_fifo_stream_refill(&fifo, out, 4) == 4);
+	CHECK(out[0] == 3 && out[1] == 3 && out[2] == 3 && out[3] == 3);
+	CHECK(fifo.underruns == 1);
+}
+
+int main(void){
+
+	watermarks_and_underrun();
+	two_thread_stress();
+
+	return test_result("test_fifo");
+}
@@ -0,0 +1,262 @@
+/*
+ * test_mixer.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <math.h>
+#include "test_common.h"
+#include "MCP4822_mixer.h"
+
+/** Voices of the mixing tests */
+#define TEST_VOICES					   8
+
+/** Frame pairs per refill, more than one mixer block */
+#define TEST_PAIRS					   (MCP4822_MIXER_BLOCK * 3 + 5)
+
+/** Frames compared between the odd and the even refills */
+#define TEST_FRAMES					   1024
+
+/**
+ * @brief Pseudo-random sample source
+ */
+typedef struct
+{
+
+	uint32_t seed;
+
+	int16_t history[TEST_PAIRS];
+
+	uint32_t produced;
+
+}Noise_Source_t;
+
+/**
+ * @brief Source interrupted by a stop, as from a higher priority interrupt
+ */
+typedef struct
+{
+
+	MCP4822_Mixer_t *mixer;
+
+	uint32_t voice;
+
+	bool released_inside;
+
+	MCP4822_STATUS play_inside;
+
+}Stop_Source_t;
+
+static uint32_t noise_source(void *context, int16_t *samples, uint32_t count){
+
+	Noise_Source_t *noise = (Noise_Source_t *)context;
+
+	for(uint32_t i = 0; i < count; i++){
+		noise->seed = noise->seed * 1664525U + 1013904223U;
+		samples[i] = (int16_t)(noise->seed >> 16);
+		if(noise->produced < TEST_PAIRS){
+			noise->history[noise->produced++] = samples[i];
+		}
+	}
+
+	return count;
+}
+
+static uint32_t full_scale_source(void *context, int16_t *samples, uint32_t count){
+
+	int16_t value = *(const int16_t *)context;
+
+	for(uint32_t i = 0; i < count; i++){
+		samples[i] = value;
+	}
+
+	return count;
+}
+
+static uint32_t stop_source(void *context, int16_t *samples, uint32_t count){
+
+	Stop_Source_t *stop = (Stop_Source_t *)context;
+
+	CHECK(MCP4822_mixer_stop(stop->mixer, stop->voice) == MCP4822_OK);
+	stop->released_inside = MCP4822_mixer_voice_released(stop->mixer, stop->voice);
+	stop->play_inside = MCP4822_mixer_play(stop->mixer, stop->voice, stop_source, stop, MCP4822_MIXER_UNITY, 0);
+
+	for(uint32_t i = 0; i < count; i++){
+		samples[i] = 0;
+	}
+
+	return count;
+}
+
+/**
+ * @brief The mix is the exact sum of all products, rounded to a code once
+ */
+static void exact_sum(void){
+
+	Test_Device_t device;
+	MCP4822_Mixer_t mixer;
+	MCP4822_Mixer_Voice_t voices[TEST_VOICES];
+	Noise_Source_t noise[TEST_VOICES];
+	uint16_t frames[TEST_PAIRS * 2];
+	uint32_t gain_a[TEST_VOICES];
+	uint32_t gain_b[TEST_VOICES];
+	uint32_t wrong = 0;
+
+	test_device_init(&device);
+	CHECK(MCP4822_mixer_init(&mixer, &device.handle, voices, TEST_VOICES) == MCP4822_OK);
+
+	//Quiet voices, each product alone is a fraction of a code
+	for(uint32_t v = 0; v < TEST_VOICES; v++){
+		uint16_t volume = (uint16_t)(MCP4822_MIXER_UNITY / TEST_VOICES - 97 * v);
+		int16_t pan = (int16_t)(-20000 + 5000 * (int32_t)v);
+
+		noise[v].seed = 0x1234 + v;
+		noise[v].produced = 0;
+		CHECK(MCP4822_mixer_play(&mixer, v, noise_source, &noise[v], volume, pan) == MCP4822_OK);
+
+		uint32_t gains = atomic_load(&voices[v].gains);
+		gain_a[v] = gains & 0xFFFF;
+		gain_b[v] = gains >> 16;
+	}
+
+	CHECK(MCP4822_mixer_refill(&mixer, frames, TEST_PAIRS * 2) == TEST_PAIRS * 2);
+
+	for(uint32_t i = 0; i < TEST_PAIRS; i++){
+		double sum_a = 0.0;
+		double sum_b = 0.0;
+
+		for(uint32_t v = 0; v < TEST_VOICES; v++){
+			sum_a += (double)noise[v].history[i] * gain_a[v] / MCP4822_MIXER_UNITY;
+			sum_b += (double)noise[v].history[i] * gain_b[v] / MCP4822_MIXER_UNITY;
+		}
+
+		double code_a = fmin(fmax(floor((sum_a + 32768.0) / 16.0 + 0.5), 0.0), MCP4822_DAC_MAX);
+		double code_b = fmin(fmax(floor((sum_b + 32768.0) / 16.0 + 0.5), 0.0), MCP4822_DAC_MAX);
+
+		wrong += ((frames[2 * i] & MCP4822_FRAME_DATA_MASK) != (uint16_t)code_a);
+		wrong += ((frames[2 * i + 1] & MCP4822_FRAME_DATA_MASK) != (uint16_t)code_b);
+		CHECK((frames[2 * i] >> MCP4822_FRAME_CHAN_POS) == MCP4822_CHANNEL_A);
+		CHECK((frames[2 * i + 1] >> MCP4822_FRAME_CHAN_POS) == MCP4822_CHANNEL_B);
+	}
+
+	CHECK(wrong == 0);
+}
+
+/**
+ * @brief Sums past full scale saturate instead of wrapping
+ */
+static void saturation(void){
+
+	Test_Device_t device;
+	MCP4822_Mixer_t mixer;
+	MCP4822_Mixer_Voice_t voices[4];
+	uint16_t frames[8];
+	int16_t high = INT16_MAX;
+	int16_t low = INT16_MIN;
+
+	test_device_init(&device);
+	CHECK(MCP4822_mixer_init(&mixer, &device.handle, voices, 4) == MCP4822_OK);
+
+	for(uint32_t v = 0; v < 4; v++){
+		CHECK(MCP4822_mixer_play(&mixer, v, full_scale_source, (v < 3) ? &high : &low, MCP4822_MIXER_UNITY, MCP4822_MIXER_PAN_A) == MCP4822_OK);
+	}
+
+	MCP4822_mixer_refill(&mixer, frames, 8);
+	CHECK((frames[0] & MCP4822_FRAME_DATA_MASK) == MCP4822_DAC_MAX);
+	CHECK((frames[1] & MCP4822_FRAME_DATA_MASK) == 2048);
+
+	for(uint32_t v = 0; v < 4; v++){
+		CHECK(MCP4822_mixer_stop(&mixer, v) == MCP4822_OK);
+		CHECK(MCP4822_mixer_play(&mixer, v, full_scale_source, &low, MCP4822_MIXER_UNITY, MCP4822_MIXER_PAN_B) == MCP4822_OK);
+	}
+
+	MCP4822_mixer_refill(&mixer, frames, 8);
+	CHECK((frames[0] & MCP4822_FRAME_DATA_MASK) == 2048);
+	CHECK((frames[1] & MCP4822_FRAME_DATA_MASK) == 0);
+}
+
+/**
+ * @brief A stop that lands while the refill is inside the source is only released once the refill is done with it
+ */
+static void stop_handoff(void){
+
+	Test_Device_t device;
+	MCP4822_Mixer_t mixer;
+	MCP4822_Mixer_Voice_t voices[2];
+	Stop_Source_t stop;
+	uint16_t frames[MCP4822_MIXER_BLOCK * 4];
+
+	test_device_init(&device);
+	CHECK(MCP4822_mixer_init(&mixer, &device.handle, voices, 2) == MCP4822_OK);
+
+	stop.mixer = &mixer;
+	stop.voice = 1;
+	stop.released_inside = true;
+	stop.play_inside = MCP4822_OK;
+	CHECK(MCP4822_mixer_play(&mixer, 1, stop_source, &stop, MCP4822_MIXER_UNITY, 0) == MCP4822_OK);
+	CHECK(!MCP4822_mixer_voice_released(&mixer, 1));
+
+	//Two blocks: the source runs for the first only
+	MCP4822_mixer_refill(&mixer, frames, MCP4822_MIXER_BLOCK * 4);
+	CHECK(!stop.released_inside);
+	CHECK(stop.play_inside == MCP4822_ERROR_BUSY);
+	CHECK(MCP4822_mixer_voice_released(&mixer, 1));
+	CHECK(MCP4822_mixer_free_voice(&mixer) == 0);
+	CHECK(MCP4822_mixer_play(&mixer, 1, full_scale_source, &(int16_t){0}, MCP4822_MIXER_UNITY, 0) == MCP4822_OK);
+}
+
+/**
+ * @brief Refills of any length, odd ones and ones ending inside a mixer block included, give the same A/B frame sequence
+ */
+static void odd_count(void){
+
+	static const uint32_t lengths[] = { 7, 1, 2, 13, 64, 3, 2 * MCP4822_MIXER_BLOCK + 1, 33, 4 * MCP4822_MIXER_BLOCK - 1 };
+	static const int16_t pans[TEST_VOICES] = { -32768, -20000, -5000, 0, 3000, 12000, 25000, 32767 };
+	Test_Device_t device;
+	MCP4822_Mixer_t mixers[2];
+	MCP4822_Mixer_Voice_t voices[2][TEST_VOICES];
+	Noise_Source_t noise[2][TEST_VOICES];
+	uint16_t expected[TEST_FRAMES];
+	uint16_t frames[TEST_FRAMES];
+
+	test_device_init(&device);
+
+	//Both mixers play the same voices, one refilled at once and one in pieces
+	for(uint32_t m = 0; m < 2; m++){
+		CHECK(MCP4822_mixer_init(&mixers[m], &device.handle, voices[m], TEST_VOICES) == MCP4822_OK);
+		for(uint32_t v = 0; v < TEST_VOICES; v++){
+			noise[m][v].seed = 0x1234567U * (v + 1);
+			noise[m][v].produced = 0;
+			CHECK(MCP4822_mixer_play(&mixers[m], v, noise_source, &noise[m][v], MCP4822_MIXER_UNITY / TEST_VOICES, pans[v]) == MCP4822_OK);
+		}
+	}
+
+	CHECK(MCP4822_mixer_refill(&mixers[0], expected, TEST_FRAMES) == TEST_FRAMES);
+
+	uint32_t done = 0;
+	for(uint32_t i = 0; done < TEST_FRAMES; i++){
+		uint32_t count = lengths[i % (sizeof(lengths) / sizeof(lengths[0]))];
+		if(count > TEST_FRAMES - done){
+			count = TEST_FRAMES - done;
+		}
+		CHECK(MCP4822_mixer_refill(&mixers[1], &frames[done], count) == count);
+		done += count;
+	}
+
+	uint32_t wrong = 0;
+	for(uint32_t i = 0; i < TEST_FRAMES; i++){
+		wrong += (frames[i] != expected[i]);
+		CHECK((frames[i] >> MCP4822_FRAME_CHAN_POS) == (i & 1));
+	}
+	CHECK(wrong == 0);
+}
+
+int main(void){
+
+	exact_sum();
+	saturation();
+	stop_handoff();
+	odd_count();
+
+	return test_result("test_mixer");
+}
@@ -0,0 +1,180 @@
+/*
+ * test_resample.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <math.h>
+#include "test_common.h"
+#include "MCP4822_resample.h"
+
+/** Output samples measured, after the filter has settled */
+#define TEST_SAMPLES				   4800
+
+/** Output samples dropped in front of the measurement */
+#define TEST_SETTLE					   256
+
+/** Peak of the test tones */
+#define TEST_AMPLITUDE				   16000.0
+
+/**
+ * @brief Sine source at the input rate
+ */
+typedef struct
+{
+
+	double step;
+
+	double phase;
+
+}Tone_Source_t;
+
+static uint32_t tone_source(void *context, int16_t *samples, uint32_t count){
+
+	Tone_Source_t *tone = (Tone_Source_t *)context;
+
+	for(uint32_t i = 0; i < count; i++){
+		samples[i] = (int16_t)lrint(TEST_AMPLITUDE * sin(tone->phase));
+		tone->phase += tone->step;
+	}
+
+	return count;
+}
+
+/**
+ * @brief Converts a gain to decibels, floored at -120 dB for a gain that rounded to silence
+ */
+static double to_db(double gain){
+
+	return 20.0 * log10(fmax(gain, 1e-6));
+}
+
+/**
+ * @brief Converts a tone and measures the output amplitude at one frequency
+ *
+ * @param quality - interpolation quality
+ * @param input_rate - rate of the tone in Hz
+ * @param output_rate - rate of the output in Hz
+ * @param tone_hz - frequency of the tone
+ * @param probe_hz - output frequency measured, the tone itself or where it aliases to
+ *
+ * @return Amplitude at probe_hz relative to the tone
+ */
+static double tone_gain(MCP4822_RESAMPLE_QUALITY quality, uint32_t input_rate, uint32_t output_rate, double tone_hz, double probe_hz){
+
+	const double pi = 3.14159265358979323846;
+	Test_Device_t device;
+	MCP4822_Resampler_t resampler;
+	Tone_Source_t tone = { 2.0 * pi * tone_hz / input_rate, 0.0 };
+	int16_t samples[TEST_SETTLE + TEST_SAMPLES];
+
+	test_device_init(&device);
+	CHECK(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, tone_source, &tone, quality, input_rate, output_rate) == MCP4822_OK);
+	CHECK(MCP4822_resample_read(&resampler, samples, TEST_SETTLE + TEST_SAMPLES) == TEST_SETTLE + TEST_SAMPLES);
+
+	//Correlate against the probe, TEST_SAMPLES spans whole cycles of every probe used
+	double re = 0.0;
+	double im = 0.0;
+	for(uint32_t i = 0; i < TEST_SAMPLES; i++){
+		double angle = 2.0 * pi * probe_hz * i / output_rate;
+		re += samples[TEST_SETTLE + i] * cos(angle);
+		im += samples[TEST_SETTLE + i] * sin(angle);
+	}
+
+	return 2.0 * sqrt(re * re + im * im) / TEST_SAMPLES / TEST_AMPLITUDE;
+}
+
+/**
+ * @brief Converting down keeps the passband and rejects what would fold back into it
+ */
+static void downward_alias(void){
+
+	static const MCP4822_RESAMPLE_QUALITY qualities[] = { MCP4822_RESAMPLE_SINC8, MCP4822_RESAMPLE_SINC16 };
+	static const double rejection_db[] = { 40.0, 60.0 };
+
+	for(uint32_t q = 0; q < 2; q++){
+
+		//48 kHz to 16 kHz: 3 kHz passes, 13 kHz would fold onto 3 kHz
+		double pass = tone_gain(qualities[q], 48000, 16000, 3000.0, 3000.0);
+		double alias = tone_gain(qualities[q], 48000, 16000, 13000.0, 3000.0);
+
+		//A ratio that is not a whole number, 44.1 kHz down to 32 kHz: 20 kHz would fold onto 12 kHz
+		double alias_frac = tone_gain(qualities[q], 44100, 32000, 20000.0, 12000.0);
+
+		printf("  %s down: 3 kHz gain %6.3f dB, alias %6.1f dB, 44.1 to 32 kHz alias %6.1f dB\n",
+			   (qualities[q] == MCP4822_RESAMPLE_SINC8) ? "sinc8 " : "sinc16", to_db(pass), to_db(alias), to_db(alias_frac));
+
+		CHECK(fabs(to_db(pass)) < 0.1);
+		CHECK(to_db(alias) < -rejection_db[q]);
+		CHECK(to_db(alias_frac) < -rejection_db[q]);
+	}
+}
+
+/**
+ * @brief The stretched kernel keeps unity gain at DC for every output phase
+ */
+static void downward_dc(void){
+
+	Test_Device_t device;
+	MCP4822_Resampler_t resampler;
+	Tone_Source_t tone = { 0.0, 3.14159265358979323846 / 2.0 };
+	int16_t samples[TEST_SETTLE + TEST_SAMPLES];
+
+	test_device_init(&device);
+
+	for(MCP4822_RESAMPLE_QUALITY q = MCP4822_RESAMPLE_SINC8; q <= MCP4822_RESAMPLE_SINC16; q++){
+		CHECK(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, tone_source, &tone, q, 44100, 16000) == MCP4822_OK);
+		CHECK(MCP4822_resample_read(&resampler, samples, TEST_SETTLE + TEST_SAMPLES) == TEST_SETTLE + TEST_SAMPLES);
+
+		int32_t worst = 0;
+		for(uint32_t i = TEST_SETTLE; i < TEST_SETTLE + TEST_SAMPLES; i++){
+			int32_t error = abs(samples[i] - (int32_t)TEST_AMPLITUDE);
+			worst = (error > worst) ? error : worst;
+		}
+
+		//Below one 12-bit code
+		CHECK(worst < 16);
+	}
+}
+
+/**
+ * @brief Ratios needing more taps than MCP4822_RESAMPLE_TAPS_MAX are rejected, the cutoff then stops at the tap limit
+ */
+static void tap_limit(void){
+
+	Test_Device_t device;
+	MCP4822_Resampler_t resampler;
+	Tone_Source_t tone = { 0.0, 0.0 };
+
+	test_device_init(&device);
+
+	uint32_t sinc16_lowest = 48000 * 16 / MCP4822_RESAMPLE_TAPS_MAX;
+	CHECK(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, tone_source, &tone, MCP4822_RESAMPLE_SINC16, 48000,
+								sinc16_lowest) == MCP4822_OK);
+	CHECK(resampler.taps == MCP4822_RESAMPLE_TAPS_MAX);
+	CHECK(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, tone_source, &tone, MCP4822_RESAMPLE_SINC16, 48000,
+								sinc16_lowest - 1) == MCP4822_ERROR_INVALID_ARG);
+
+	//Nearest and linear never stretch, any ratio is accepted
+	CHECK(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, tone_source, &tone, MCP4822_RESAMPLE_LINEAR, 48000,
+								1000) == MCP4822_OK);
+
+	//Drifting further down than the taps allow keeps the widest kernel
+	CHECK(MCP4822_resample_init(&resampler, &device.handle, MCP4822_CHANNEL_A, tone_source, &tone, MCP4822_RESAMPLE_SINC8, 48000,
+								16000) == MCP4822_OK);
+	uint32_t taps = resampler.taps;
+	CHECK(MCP4822_resample_set_rates(&resampler, 48000, 8000) == MCP4822_OK);
+	CHECK(resampler.taps == taps);
+	CHECK(resampler.scale_q16 * taps >= 8u * 65536u);
+	CHECK(MCP4822_resample_set_rates(&resampler, 48000, 48000) == MCP4822_OK);
+	CHECK(resampler.scale_q16 == 65536);
+}
+
+int main(void){
+
+	downward_alias();
+	downward_dc();
+	tap_limit();
+
+	return test_result("test_resample");
+}
@@ -0,0 +1,180 @@
+/*
+ * test_shadow.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include "test_common.h"
+
+/** LDAC pin of the test device */
+#define TEST_LDAC_PIN				   2
+
+/**
+ * @brief Counts LDAC pulses, one per falling edge
+ */
+static void count_ldac(void *context, uint16_t pin, uint8_t high){
+
+	if((pin & TEST_LDAC_PIN) && !high){
+		(*(uint32_t *)context)++;
+	}
+}
+
+/**
+ * @brief Sets up a device with an LDAC pin whose pulses are counted
+ *
+ * @param device - device to be set up
+ * @param pulses - LDAC pulse counter
+ *
+ * @return None
+ */
+static void shadow_device_init(Test_Device_t *device, uint32_t *pulses){
+
+	test_device_init(device);
+	*pulses = 0;
+	device->gpio.changed = count_ldac;
+	device->gpio.context = pulses;
+	MCP4822_set_ldac_pin(&device->handle, &device->gpio, TEST_LDAC_PIN);
+}
+
+/**
+ * @brief A repeated frame is neither sent nor latched, a changed value or configuration is
+ */
+static void suppression(void){
+
+	Test_Device_t device;
+	uint32_t pulses;
+
+	shadow_device_init(&device, &pulses);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(device.spi.frames == 1 && pulses == 1);
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(device.spi.frames == 1 && pulses == 1);
+	CHECK(device.handle.frames_sent == 1 && device.handle.frames_suppressed == 1);
+
+	//Each channel has its own shadow
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_B) == MCP4822_OK);
+	CHECK(device.spi.frames == 2 && pulses == 2);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 1001, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(device.spi.frames == 3 && (device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == 1001);
+
+	//The gain bit is part of the compared frame, a gain change resends the level
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_A, MCP4822_GAIN_2X) == MCP4822_OK);
+	CHECK(device.spi.frames == 4);
+	CHECK(MCP4822_write_to_chan(&device.handle, 1001, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(device.spi.frames == 4);
+
+	//A pair only sends the channel that changed, and latches once
+	uint32_t pulses_before = pulses;
+	CHECK(MCP4822_write_pair(&device.handle, 1001, 2000) == MCP4822_OK);
+	CHECK(device.spi.frames == 5 && (device.spi.last_frame >> MCP4822_FRAME_CHAN_POS) == MCP4822_CHANNEL_B);
+	CHECK(pulses == pulses_before + 1);
+	CHECK(MCP4822_write_pair(&device.handle, 1001, 2000) == MCP4822_OK);
+	CHECK(device.spi.frames == 5 && pulses == pulses_before + 1);
+
+	CHECK(device.handle.frames_sent == 5);
+	CHECK(device.handle.frames_suppressed == 5);
+}
+
+/**
+ * @brief Forced writes send every frame, and the check is back once they are turned off
+ */
+static void force_writes(void){
+
+	Test_Device_t device;
+	uint32_t pulses;
+
+	shadow_device_init(&device, &pulses);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 500, MCP4822_CHANNEL_A) == MCP4822_OK);
+	MCP4822_set_force_writes(&device.handle, 1);
+	for(uint32_t i = 0; i < 3; i++){
+		CHECK(MCP4822_write_to_chan(&device.handle, 500, MCP4822_CHANNEL_A) == MCP4822_OK);
+	}
+	CHECK(device.spi.frames == 4 && pulses == 4);
+	CHECK(device.handle.frames_sent == 4 && device.handle.frames_suppressed == 0);
+
+	MCP4822_set_force_writes(&device.handle, 0);
+	CHECK(MCP4822_write_to_chan(&device.handle, 500, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(device.spi.frames == 4 && pulses == 4);
+	CHECK(device.handle.frames_sent == 4 && device.handle.frames_suppressed == 1);
+}
+
+/**
+ * @brief Invalidating the shadow, a raw frame write or a failed transfer makes the next write go out
+ */
+static void invalidation(void){
+
+	Test_Device_t device;
+	uint32_t pulses;
+
+	shadow_device_init(&device, &pulses);
+
+	CHECK(MCP4822_write_pair(&device.handle, 100, 200) == MCP4822_OK);
+	CHECK(device.spi.frames == 2);
+
+	MCP4822_invalidate_shadow(&device.handle);
+	CHECK(MCP4822_write_pair(&device.handle, 100, 200) == MCP4822_OK);
+	CHECK(device.spi.frames == 4);
+	CHECK(MCP4822_write_pair(&device.handle, 100, 200) == MCP4822_OK);
+	CHECK(device.spi.frames == 4);
+
+	//A raw frame bypasses the shadow, so the tracked value may no longer be on the device
+	device.spi.tx_dma = NULL;
+	uint16_t raw = MCP4822_encode_frame(&device.handle, 100, MCP4822_CHANNEL_A);
+	CHECK(MCP4822_write_frames(&device.handle, &raw, 1) == MCP4822_OK);
+	CHECK(device.spi.frames == 5);
+	CHECK(MCP4822_write_to_chan(&device.handle, 100, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(device.spi.frames == 6);
+
+	//Part of a failed burst may have reached the device
+	device.spi.fd = 1 << 20;
+	CHECK(MCP4822_write_to_chan(&device.handle, 300, MCP4822_CHANNEL_A) == MCP4822_ERROR_SPI);
+	device.spi.fd = -1;
+	uint32_t sent = device.handle.frames_sent;
+	CHECK(MCP4822_write_to_chan(&device.handle, 100, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(MCP4822_write_to_chan(&device.handle, 200, MCP4822_CHANNEL_B) == MCP4822_OK);
+	CHECK(device.handle.frames_sent == sent + 2);
+}
+
+/**
+ * @brief A raw burst is latched once after its last frame, a failed one not at all
+ */
+static void raw_frames_latch(void){
+
+	Test_Device_t device;
+	uint32_t pulses;
+	uint16_t frames[4];
+
+	shadow_device_init(&device, &pulses);
+	device.spi.tx_dma = NULL;
+
+	frames[0] = MCP4822_encode_frame(&device.handle, 100, MCP4822_CHANNEL_A);
+	frames[1] = MCP4822_encode_frame(&device.handle, 200, MCP4822_CHANNEL_B);
+	frames[2] = MCP4822_encode_frame(&device.handle, 300, MCP4822_CHANNEL_A);
+	frames[3] = MCP4822_encode_frame(&device.handle, 400, MCP4822_CHANNEL_B);
+
+	CHECK(MCP4822_write_frames(&device.handle, frames, 4) == MCP4822_OK);
+	CHECK(device.spi.frames == 4 && pulses == 1);
+	CHECK(MCP4822_write_frames(&device.handle, frames, 1) == MCP4822_OK);
+	CHECK(device.spi.frames == 5 && pulses == 2);
+
+	device.spi.fd = 1 << 20;
+	CHECK(MCP4822_write_frames(&device.handle, frames, 2) == MCP4822_ERROR_SPI);
+	CHECK(pulses == 2);
+	device.spi.fd = -1;
+
+	CHECK(MCP4822_write_frames(&device.handle, frames, 0) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(pulses == 2);
+}
+
+int main(void){
+
+	suppression();
+	force_writes();
+	invalidation();
+	raw_frames_latch();
+
+	return test_result("test_shadow");
+}
@@ -0,0 +1,198 @@
+/*
+ * test_stats.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <fcntl.h>
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_stats.h"
+
+#ifndef MCP4822_ENABLE_STATS
+#error "test_stats needs the driver built with MCP4822_ENABLE_STATS"
+#endif
+
+/**
+ * @brief Every instrumented blocking write is counted under its own path
+ */
+static void counts(void){
+
+	Test_Device_t device;
+	MCP4822_Stats_t stats;
+	MCP4822_Stats_t snapshot;
+
+	test_device_init(&device);
+	CHECK(device.handle.stats == NULL);
+	CHECK(MCP4822_stats_snapshot(&device.handle, &snapshot) == MCP4822_ERROR_INVALID_ARG);
+
+	MCP4822_stats_attach(&device.handle, &stats);
+	for(uint32_t i = 0; i < 5; i++){
+		CHECK(MCP4822_write_to_chan(&device.handle, (uint16_t)(100 * i), MCP4822_CHANNEL_A) == MCP4822_OK);
+	}
+	for(uint32_t i = 0; i < 3; i++){
+		CHECK(MCP4822_write_pair(&device.handle, (uint16_t)i, (uint16_t)(i + 1)) == MCP4822_OK);
+	}
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_B, MCP4822_GAIN_2X) == MCP4822_OK);
+
+	uint16_t frames[4] = { 0x3000, 0xB000, 0x3001, 0xB001 };
+	CHECK(MCP4822_write_frames(&device.handle, frames, 4) == MCP4822_OK);
+	CHECK(MCP4822_write_frames(&device.handle, frames, 2) == MCP4822_OK);
+
+	CHECK(stats.apis[MCP4822_STATS_WRITE_TO_CHAN].count == 5);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_PAIR].count == 3);
+	CHECK(stats.apis[MCP4822_STATS_CONFIGURE].count == 1);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_FRAMES].count == 2);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_FRAMES_DMA].count == 0);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_FRAMES_DMA].min == UINT32_MAX);
+
+	//The summary agrees with its histogram
+	for(uint32_t api = 0; api < MCP4822_STATS_API_COUNT; api++){
+		uint32_t bucketed = 0;
+		for(uint32_t b = 0; b < MCP4822_STATS_BUCKETS; b++){
+			bucketed += stats.apis[api].histogram[b];
+		}
+		CHECK(bucketed == stats.apis[api].count);
+		if(stats.apis[api].count > 0){
+			CHECK(stats.apis[api].min <= MCP4822_stats_mean(&stats.apis[api]));
+			CHECK(MCP4822_stats_mean(&stats.apis[api]) <= stats.apis[api].max);
+		}
+	}
+	CHECK(stats.spi_errors == 0 && stats.timeouts == 0);
+	CHECK(MCP4822_stats_tick_hz() == MCP4822_port_tick_hz());
+
+	//Detached, nothing is recorded
+	MCP4822_stats_attach(&device.handle, NULL);
+	CHECK(MCP4822_write_to_chan(&device.handle, 4000, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_TO_CHAN].count == 5);
+}
+
+/**
+ * @brief Known durations land in their bit-length buckets with the right min, max and mean
+ */
+static void summary(void){
+
+	static const struct { uint32_t ticks; uint32_t bucket; } samples[] = {
+		{ 0, 0 }, { 1, 1 }, { 2, 2 }, { 3, 2 }, { 4, 3 }, { 7, 3 }, { 8, 4 }, { 1000, 10 }, { 0x80000000UL, 31 }, { UINT32_MAX, 31 }
+	};
+	MCP4822_Stats_t stats;
+	Test_Device_t device;
+	uint64_t total = 0;
+	uint32_t expected[MCP4822_STATS_BUCKETS] = {0};
+
+	test_device_init(&device);
+	MCP4822_stats_attach(&device.handle, &stats);
+
+	for(uint32_t i = 0; i < sizeof(samples) / sizeof(samples[0]); i++){
+		MCP4822_stats_add(&stats, MCP4822_STATS_BUS_WRITE, samples[i].ticks);
+		total += samples[i].ticks;
+		expected[samples[i].bucket]++;
+	}
+
+	const MCP4822_Stats_Api_t *api = &stats.apis[MCP4822_STATS_BUS_WRITE];
+	CHECK(api->count == sizeof(samples) / sizeof(samples[0]));
+	CHECK(api->min == 0);
+	CHECK(api->max == UINT32_MAX);
+	CHECK(api->total == total);
+	CHECK(MCP4822_stats_mean(api) == (uint32_t)((total + api->count / 2) / api->count));
+	CHECK(memcmp(api->histogram, expected, sizeof(expected)) == 0);
+
+	//The mean rounds to the nearest tick
+	MCP4822_stats_add(&stats, MCP4822_STATS_ASYNC_COMPLETE, 1);
+	MCP4822_stats_add(&stats, MCP4822_STATS_ASYNC_COMPLETE, 2);
+	CHECK(MCP4822_stats_mean(&stats.apis[MCP4822_STATS_ASYNC_COMPLETE]) == 2);
+	CHECK(MCP4822_stats_mean(&stats.apis[MCP4822_STATS_ASYNC_ENQUEUE]) == 0);
+}
+
+/**
+ * @brief A transfer that runs out of time is a timeout, any other failure is an SPI error
+ */
+static void error_split(void){
+
+	Test_Device_t device;
+	MCP4822_Stats_t stats;
+	int fds[2];
+
+	test_device_init(&device);
+	MCP4822_stats_attach(&device.handle, &stats);
+
+	//A full non-blocking pipe stands in for a device that stopped taking frames
+	CHECK(pipe(fds) == 0);
+	CHECK(fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL) | O_NONBLOCK) == 0);
+	uint16_t fill[256] = {0};
+	while(write(fds[1], fill, sizeof(fill)) > 0){
+	}
+
+	device.spi.fd = fds[1];
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_A) == MCP4822_ERROR_SPI);
+	CHECK(stats.timeouts == 1 && stats.spi_errors == 0);
+
+	//A closed descriptor fails outright
+	close(fds[0]);
+	close(fds[1]);
+	CHECK(MCP4822_write_to_chan(&device.handle, 1000, MCP4822_CHANNEL_A) == MCP4822_ERROR_SPI);
+	CHECK(stats.timeouts == 1 && stats.spi_errors == 1);
+
+	//So does a DMA burst that cannot start
+	device.spi.fd = -1;
+	CHECK(MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS) == MCP4822_OK);
+	uint16_t frames[2] = { 0x3000, 0xB000 };
+	device.tx_dma.active = 1;
+	CHECK(MCP4822_write_frames_dma(&device.handle, frames, 2) == MCP4822_ERROR_SPI);
+	CHECK(stats.timeouts == 1 && stats.spi_errors == 2);
+
+	//Failed writes are still timed
+	CHECK(stats.apis[MCP4822_STATS_WRITE_TO_CHAN].count == 2);
+}
+
+/**
+ * @brief A snapshot is a copy that later writes leave alone, a reset starts the stats over
+ */
+static void snapshot_reset(void){
+
+	Test_Device_t device;
+	MCP4822_Stats_t stats;
+	MCP4822_Stats_t snapshot;
+
+	test_device_init(&device);
+	MCP4822_stats_attach(&device.handle, &stats);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 1, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(MCP4822_write_pair(&device.handle, 2, 3) == MCP4822_OK);
+	stats.spi_errors = 4;
+	stats.timeouts = 5;
+
+	CHECK(MCP4822_stats_snapshot(&device.handle, NULL) == MCP4822_ERROR_INVALID_ARG);
+	CHECK(MCP4822_stats_snapshot(&device.handle, &snapshot) == MCP4822_OK);
+	CHECK(memcmp(&snapshot, &stats, sizeof(stats)) == 0);
+
+	CHECK(MCP4822_write_to_chan(&device.handle, 6, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(snapshot.apis[MCP4822_STATS_WRITE_TO_CHAN].count == 1);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_TO_CHAN].count == 2);
+
+	MCP4822_stats_reset(&device.handle);
+	CHECK(stats.spi_errors == 0 && stats.timeouts == 0);
+	for(uint32_t api = 0; api < MCP4822_STATS_API_COUNT; api++){
+		uint32_t bucketed = 0;
+		for(uint32_t b = 0; b < MCP4822_STATS_BUCKETS; b++){
+			bucketed += stats.apis[api].histogram[b];
+		}
+		CHECK(stats.apis[api].count == 0 && stats.apis[api].total == 0 && bucketed == 0);
+		CHECK(stats.apis[api].min == UINT32_MAX && stats.apis[api].max == 0);
+	}
+
+	//Recording carries on after the reset
+	CHECK(MCP4822_write_to_chan(&device.handle, 7, MCP4822_CHANNEL_A) == MCP4822_OK);
+	CHECK(stats.apis[MCP4822_STATS_WRITE_TO_CHAN].count == 1);
+	CHECK(snapshot.apis[MCP4822_STATS_WRITE_PAIR].count == 1);
+}
+
+int main(void){
+
+	counts();
+	summary();
+	error_split();
+	snapshot_reset();
+
+	return test_result("test_stats");
+}
@@ -0,0 +1,581 @@
+/*
+ * test_stream.c
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ */
+#include <string.h>
+#include "test_common.h"
+#include "MCP4822_stream.h"
+#include "MCP4822_dispatch.h"
+
+/** Timer kernel clock of the paced tests, as on an STM32L5 at 80 MHz */
+#define TIMER_CLOCK_HZ				   80000000U
+
+/** Frames of the test stream buffer */
+#define STREAM_LEN					   64
+
+/**
+ * @brief Refill source producing a frame counter, so skipped or repeated frames show up
+ */
+typedef struct
+{
+
+	uint32_t next;
+
+	uint32_t limit;
+
+}Counter_t;
+
+/**
+ * @brief Frame timing seen at the SPI of a paced stream
+ */
+typedef struct
+{
+
+	uint32_t frames;
+
+	uint64_t min_interval;
+
+	uint64_t max_interval;
+
+	uint64_t first_clocks;
+
+	uint64_t last_clocks;
+
+	uint32_t out_of_order;
+
+}Timing_t;
+
+/**
+ * @brief MCP4822 model: frames load the input registers, LDAC going low copies both to the output registers
+ */
+typedef struct
+{
+
+	uint16_t input[2];
+
+	uint16_t output[2];
+
+	uint16_t ldac_pin;
+
+	uint32_t latches;
+
+}Dac_Model_t;
+
+static uint32_t counter_refill(void *context, uint16_t *frames, uint32_t count){
+
+	Counter_t *counter = (Counter_t *)context;
+	uint32_t i;
+
+	for(i = 0; i < count && counter->next < counter->limit; i++){
+		frames[i] = (uint16_t)(0x3000 | (counter->next++ & MCP4822_FRAME_DATA_MASK));
+	}
+
+	return i;
+}
+
+static void dummy_half(MCP4822_Dma_t *dma){
+
+	(void)dma;
+}
+
+static void dummy_full(MCP4822_Dma_t *dma){
+
+	(void)dma;
+}
+
+/**
+ * @brief Plays a paced stream at one rate for one second of frames and checks that every update sends exactly one frame
+ */
+static void paced_rate(uint32_t rate){
+
+	Test_Device_t device;
+	uint16_t buffer[STREAM_LEN];
+	MCP4822_Stream_t stream;
+	Counter_t counter = {0, rate};
+	Timing_t timing = {0, UINT64_MAX, 0, 0, 0, 0};
+
+	test_device_init(&device);
+	CHECK(MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS) == MCP4822_OK);
+	CHECK(MCP4822_set_sample_rate(&device.handle, &device.timer, TIMER_CLOCK_HZ, rate) == MCP4822_OK);
+	CHECK(MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, counter_refill, &counter) == MCP4822_OK);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+
+	uint64_t previous = 0;
+	while(stream.state != MCP4822_STREAM_IDLE){
+
+		uint32_t sent = device.spi.frames;
+		MCP4822_port_posix_timer_tick(&device.timer);
+
+		//Every update event must move one frame, refills included
+		CHECK(device.spi.frames == sent + 1 || stream.state == MCP4822_STREAM_IDLE);
+		if(device.spi.frames != sent + 1 || timing.frames >= rate){
+			continue;
+		}
+
+		uint64_t now = device.timer.clocks;
+		if(timing.frames == 0){
+			timing.first_clocks = now;
+		}
+		else{
+			uint64_t interval = now - previous;
+			timing.min_interval = (interval < timing.min_interval) ? interval : timing.min_interval;
+			timing.max_interval = (interval > timing.max_interval) ? interval : timing.max_interval;
+		}
+		if((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) != (timing.frames & MCP4822_FRAME_DATA_MASK)){
+			timing.out_of_order++;
+		}
+
+		previous = now;
+		timing.last_clocks = now;
+		timing.frames++;
+	}
+
+	double seconds = (double)(timing.last_clocks - timing.first_clocks) / TIMER_CLOCK_HZ;
+	double measured = (timing.frames - 1) / seconds;
+	double error_ppm = (measured - rate) / rate * 1e6;
+	double jitter_ns = (double)(timing.max_interval - timing.min_interval) * 1e9 / TIMER_CLOCK_HZ;
+	double actual = MCP4822_get_actual_sample_rate(&device.handle);
+
+	//Whole timer ticks per frame leave at most half a tick of period error
+	double limit_ppm = 0.5e6 * rate / TIMER_CLOCK_HZ + 1.0;
+
+	printf("  %6u frames/s: measured %10.2f (%+8.1f ppm), interval jitter %.1f ns, out of order %u\n",
+		   rate, measured, error_ppm, jitter_ns, timing.out_of_order);
+
+	CHECK(timing.frames == rate);
+	CHECK(timing.out_of_order == 0);
+	CHECK(timing.max_interval == timing.min_interval);
+	CHECK(error_ppm < limit_ppm && error_ppm > -limit_ppm);
+	CHECK((measured - actual) / actual * 1e6 < 1.0 && (measured - actual) / actual * 1e6 > -1.0);
+}
+
+/**
+ * @brief The borrowed timer update DMA channel gets its owner and both callbacks back
+ */
+static void paced_restores_dma(void){
+
+	Test_Device_t device;
+	uint16_t buffer[STREAM_LEN];
+	MCP4822_Stream_t stream;
+	Counter_t counter = {0, 1000};
+	int owner;
+
+	test_device_init(&device);
+	MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS);
+	MCP4822_set_sample_rate(&device.handle, &device.timer, TIMER_CLOCK_HZ, 48000);
+
+	device.timer_dma.parent = &owner;
+	device.timer_dma.half = dummy_half;
+	device.timer_dma.full = dummy_full;
+
+	MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, counter_refill, &counter);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+	CHECK(device.timer_dma.parent == &stream);
+
+	for(uint32_t i = 0; i < 100; i++){
+		MCP4822_port_posix_timer_tick(&device.timer);
+	}
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+
+	CHECK(device.timer_dma.parent == &owner);
+	CHECK(device.timer_dma.half == dummy_half);
+	CHECK(device.timer_dma.full == dummy_full);
+	CHECK(!device.timer.running && !device.timer.dma_enabled && !device.timer_dma.active);
+
+	//A failed start puts them back as well
+	device.timer_dma.active = 1;
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_ERROR_SPI);
+	CHECK(device.timer_dma.parent == &owner);
+	CHECK(device.timer_dma.half == dummy_half);
+	CHECK(device.timer_dma.full == dummy_full);
+
+	//So does a timer that fails to start, with the DMA stopped and the update request off
+	device.timer_dma.active = 0;
+	device.timer.running = 1;
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_ERROR_SPI);
+	CHECK(stream.state == MCP4822_STREAM_IDLE && stream.paced_dma == NULL);
+	CHECK(device.timer_dma.parent == &owner);
+	CHECK(device.timer_dma.half == dummy_half);
+	CHECK(device.timer_dma.full == dummy_full);
+	CHECK(!device.timer_dma.active && !device.timer.dma_enabled);
+	device.timer.running = 0;
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+}
+
+/**
+ * @brief DMA channels that do not move half-words are refused
+ */
+static void rejects_byte_dma(void){
+
+	Test_Device_t device;
+	uint16_t buffer[STREAM_LEN];
+	MCP4822_Stream_t stream;
+	Counter_t counter = {0, 1000};
+
+	test_device_init(&device);
+	MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS);
+	MCP4822_set_sample_rate(&device.handle, &device.timer, TIMER_CLOCK_HZ, 48000);
+	MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, counter_refill, &counter);
+
+	device.timer_dma.width_16bit = 0;
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_ERROR_INVALID_ARG);
+
+	device.handle.htim = NULL;
+	device.tx_dma.width_16bit = 0;
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_ERROR_INVALID_ARG);
+}
+
+/**
+ * @brief Plays the SPI TX DMA interrupts of an unpaced stream, as HAL_SPI_TxHalfCpltCallback and HAL_SPI_TxCpltCallback would
+ */
+static void service_spi(Test_Device_t *device){
+
+	if(device->spi.half_pending){
+		device->spi.half_pending = 0;
+		MCP4822_dispatch_tx_half_complete(&device->spi);
+	}
+
+	if(device->spi.pending){
+		device->spi.pending = 0;
+		MCP4822_dispatch_tx_complete(&device->spi);
+	}
+}
+
+/**
+ * @brief An unpaced stream that ends by itself halts from its interrupt and leaves the SPI format to stream_stop
+ */
+static void unpaced_self_end(void){
+
+	Test_Device_t device;
+	uint16_t buffer[STREAM_LEN];
+	MCP4822_Stream_t stream;
+	Counter_t counter = {0, 1000};
+
+	test_device_init(&device);
+	MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS);
+	device.spi.format = 8;
+
+	CHECK(MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, counter_refill, &counter) == MCP4822_OK);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+	CHECK(device.spi.format == MCP4822_PORT_SPI_16BIT);
+
+	//Clock the frames out a few at a time, taking the interrupts in between
+	uint32_t guard = 0;
+	while(stream.state != MCP4822_STREAM_IDLE && guard++ < 100000){
+		MCP4822_port_posix_dma_run(&device.tx_dma, 5);
+		service_spi(&device);
+	}
+
+	//Every counter frame went out in order before the held level
+	CHECK(stream.state == MCP4822_STREAM_IDLE);
+	CHECK(device.spi.frames >= counter.limit);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == ((counter.limit - 1) & MCP4822_FRAME_DATA_MASK));
+	CHECK(!device.tx_dma.active);
+
+	//The interrupt did not re-initialize the SPI
+	CHECK(device.spi.format == MCP4822_PORT_SPI_16BIT);
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+	CHECK(device.spi.format == 8);
+
+	//A second stop has nothing left to do
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+	CHECK(device.spi.format == 8);
+
+	//Restarting after a self-ended stream keeps the original format
+	counter.next = 0;
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+	while(stream.state != MCP4822_STREAM_IDLE && guard++ < 200000){
+		MCP4822_port_posix_dma_run(&device.tx_dma, 5);
+		service_spi(&device);
+	}
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+	CHECK(device.spi.format == 8);
+}
+
+/**
+ * @brief Refill source producing interleaved A/B pairs with counting data
+ */
+static uint32_t pair_refill(void *context, uint16_t *frames, uint32_t count){
+
+	Counter_t *counter = (Counter_t *)context;
+	uint32_t i;
+
+	for(i = 0; i + 1 < count && counter->next < counter->limit; i += 2){
+		frames[i] = (uint16_t)(0x3000 | (counter->next & MCP4822_FRAME_DATA_MASK));
+		frames[i + 1] = (uint16_t)(0xB000 | ((counter->next + 2048) & MCP4822_FRAME_DATA_MASK));
+		counter->next++;
+	}
+
+	return i;
+}
+
+/**
+ * @brief Latches the model's input registers on the falling edge of LDAC
+ */
+static void dac_pin_changed(void *context, uint16_t pin, uint8_t high){
+
+	Dac_Model_t *dac = (Dac_Model_t *)context;
+
+	if((pin & dac->ldac_pin) && !high){
+		dac->output[MCP4822_CHANNEL_A] = dac->input[MCP4822_CHANNEL_A];
+		dac->output[MCP4822_CHANNEL_B] = dac->input[MCP4822_CHANNEL_B];
+		dac->latches++;
+	}
+}
+
+/**
+ * @brief Moves frames of the pair transfer into the model's input registers
+ *
+ * @param device - device whose SPI TX DMA runs
+ * @param dac - model receiving the frames
+ * @param frames - maximum number of frames to move
+ *
+ * @return None
+ */
+static void dac_run(Test_Device_t *device, Dac_Model_t *dac, uint32_t frames){
+
+	for(uint32_t i = 0; i < frames; i++){
+		if(MCP4822_port_posix_dma_run(&device->tx_dma, 1) != 1){
+			break;
+		}
+		dac->input[device->spi.last_frame >> 15] = device->spi.last_frame & MCP4822_FRAME_DATA_MASK;
+	}
+}
+
+/**
+ * @brief Pair mode: A and B reach the outputs on the same tick, a pair caught half-loaded by the tick is latched on the next one
+ */
+static void pair_latch_together(void){
+
+	Test_Device_t device;
+	uint16_t buffer[STREAM_LEN];
+	MCP4822_Stream_t stream;
+	Counter_t counter = {0, 300};
+	Dac_Model_t dac = { {MCP4822_DAC_MAX, MCP4822_DAC_MAX}, {MCP4822_DAC_MAX, MCP4822_DAC_MAX}, 2, 0 };
+	uint32_t torn = 0;
+	uint32_t skipped = 0;
+	uint32_t half_loaded_ticks = 0;
+	uint32_t next_a = 0;
+
+	test_device_init(&device);
+	device.tx_dma.circular = 0;
+	device.gpio.changed = dac_pin_changed;
+	device.gpio.context = &dac;
+	MCP4822_set_ldac_pin(&device.handle, &device.gpio, dac.ldac_pin);
+	MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS);
+	MCP4822_set_sample_rate(&device.handle, &device.timer, TIMER_CLOCK_HZ, 48000);
+	MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, pair_refill, &counter);
+	CHECK(MCP4822_stream_start_pairs(&stream) == MCP4822_OK);
+
+	uint32_t tick = 0;
+	while(stream.state != MCP4822_STREAM_IDLE && tick < 10000){
+
+		uint16_t before[2] = { dac.output[MCP4822_CHANNEL_A], dac.output[MCP4822_CHANNEL_B] };
+		uint8_t half_loaded = device.tx_dma.active && device.tx_dma.index == 1;
+
+		if(MCP4822_port_posix_timer_tick(&device.timer)){
+			MCP4822_stream_pair_tick_handler(&stream);
+		}
+
+		uint8_t changed_a = (dac.output[MCP4822_CHANNEL_A] != before[MCP4822_CHANNEL_A]);
+		uint8_t changed_b = (dac.output[MCP4822_CHANNEL_B] != before[MCP4822_CHANNEL_B]);
+
+		//Every pair differs from the one before on both channels, so a latch moves both outputs or neither
+		torn += (changed_a != changed_b);
+		half_loaded_ticks += half_loaded;
+		if(half_loaded){
+			CHECK(!changed_a && !changed_b);
+		}
+
+		//B always sits 2048 codes above A, and the latched pairs count up without gaps
+		if(changed_a && next_a < counter.limit){
+			CHECK(dac.output[MCP4822_CHANNEL_B] == ((dac.output[MCP4822_CHANNEL_A] + 2048) & MCP4822_FRAME_DATA_MASK));
+			skipped += (dac.output[MCP4822_CHANNEL_A] != (next_a & MCP4822_FRAME_DATA_MASK));
+			next_a = dac.output[MCP4822_CHANNEL_A] + 1U;
+		}
+
+		//Every fifth tick the SPI only gets channel A out before the next tick
+		dac_run(&device, &dac, ((++tick % 5) == 0) ? 1 : 2);
+		service_spi(&device);
+	}
+
+	printf("  pair latch: %u latches, %u underruns, %u ticks on a half-loaded pair\n", dac.latches, stream.underruns, half_loaded_ticks);
+
+	CHECK(stream.state == MCP4822_STREAM_IDLE);
+	CHECK(half_loaded_ticks > 0);
+	CHECK(stream.underruns >= half_loaded_ticks);
+	CHECK(torn == 0);
+	CHECK(skipped == 0);
+	CHECK(next_a >= counter.limit);
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+}
+
+/**
+ * @brief Pair mode: a busy SPI counts an underrun and the pair is retried, the drain holds both channels
+ */
+static void pair_underrun_and_drain(void){
+
+	Test_Device_t device;
+	uint16_t buffer[STREAM_LEN];
+	MCP4822_Stream_t stream;
+	Counter_t counter = {0, 100};
+	uint16_t last[2] = {0, 0};
+	uint32_t pairs = 0;
+	uint32_t wrong_channel = 0;
+
+	test_device_init(&device);
+	device.tx_dma.circular = 0;
+	MCP4822_set_ldac_pin(&device.handle, &device.gpio, 2);
+	MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS);
+	MCP4822_set_sample_rate(&device.handle, &device.timer, TIMER_CLOCK_HZ, 48000);
+	MCP4822_stream_init(&stream, &device.handle, buffer, STREAM_LEN, pair_refill, &counter);
+	CHECK(MCP4822_stream_start_pairs(&stream) == MCP4822_OK);
+
+	uint32_t tick = 0;
+	while(stream.state != MCP4822_STREAM_IDLE && tick < 10000){
+
+		if(MCP4822_port_posix_timer_tick(&device.timer)){
+			MCP4822_stream_pair_tick_handler(&stream);
+		}
+
+		//Every seventh tick the SPI is too slow and the pair is still in flight at the next tick
+		if((++tick % 7) == 0){
+			continue;
+		}
+
+		uint16_t frames[2];
+		if(MCP4822_port_posix_dma_run(&device.tx_dma, 1) == 1){
+			frames[0] = device.spi.last_frame;
+			if(MCP4822_port_posix_dma_run(&device.tx_dma, 1) == 1){
+				frames[1] = device.spi.last_frame;
+
+				wrong_channel += ((frames[0] >> 15) != 0) + ((frames[1] >> 15) != 1);
+				if(pairs < counter.limit){
+					CHECK((frames[0] & MCP4822_FRAME_DATA_MASK) == (pairs & MCP4822_FRAME_DATA_MASK));
+				}
+				last[0] = frames[0];
+				last[1] = frames[1];
+				pairs++;
+			}
+		}
+		service_spi(&device);
+	}
+
+	printf("  pair mode: %u pairs, %u underruns retried\n", pairs, stream.underruns);
+
+	CHECK(stream.state == MCP4822_STREAM_IDLE);
+	CHECK(stream.underruns > 0);
+	CHECK(pairs >= counter.limit);
+	CHECK(wrong_channel == 0);
+
+	//The drain held the last A and B levels, not one frame on both slots
+	CHECK((last[0] & MCP4822_FRAME_DATA_MASK) == ((counter.limit - 1) & MCP4822_FRAME_DATA_MASK));
+	CHECK((last[1] & MCP4822_FRAME_DATA_MASK) == ((counter.limit - 1 + 2048) & MCP4822_FRAME_DATA_MASK));
+	CHECK(MCP4822_stream_stop(&stream) == MCP4822_OK);
+
+	//The streamed levels are what configuration changes resend afterwards
+	CHECK(device.handle.shadow_frames[MCP4822_CHANNEL_A] == last[0]);
+	CHECK(device.handle.shadow_frames[MCP4822_CHANNEL_B] == last[1]);
+
+	device.spi.tx_dma = NULL;
+	CHECK(MCP4822_set_chan_gain(&device.handle, MCP4822_CHANNEL_B, MCP4822_GAIN_2X) == MCP4822_OK);
+	CHECK((device.spi.last_frame & MCP4822_FRAME_DATA_MASK) == (last[1] & MCP4822_FRAME_DATA_MASK));
+	CHECK((device.spi.last_frame >> 15) == MCP4822_CHANNEL_B);
+}
+
+/**
+ * @brief Both channel volts go out as one pair
+ */
+static void volts_pair(void){
+
+	Test_Device_t device;
+
+	test_device_init(&device);
+	device.spi.tx_dma = NULL;
+	MCP4822_set_ldac_pin(&device.handle, &device.gpio, 2);
+
+	uint32_t sent = device.spi.frames;
+	CHECK(MCP4822_write_volts_to_both_chans(&device.handle, 1.0f) == MCP4822_OK);
+	CHECK(device.spi.frames == sent + 2);
+	CHECK((device.spi.last_frame >> 15) == MCP4822_CHANNEL_B);
+	CHECK(device.handle.shadow_frames[MCP4822_CHANNEL_A] != 0);
+}
+
+/**
+ * @brief Stereo playback through odd buffer halves keeps the A/B order and only ends with the samples
+ */
+static void stereo_odd_halves(void){
+
+	enum { PAIRS = 101, ODD_LEN = 30 };
+	Test_Device_t device;
+	uint16_t buffer[ODD_LEN];
+	int16_t samples[2 * PAIRS];
+	MCP4822_Stream_t stream;
+	MCP4822_Stereo_t stereo;
+	uint32_t frames = 0;
+	uint32_t mismatches = 0;
+
+	for(uint32_t i = 0; i < PAIRS; i++){
+		samples[2 * i] = (int16_t)(i * 16 - 32768);
+		samples[2 * i + 1] = (int16_t)(32767 - i * 16);
+	}
+
+	test_device_init(&device);
+	MCP4822_set_cs_mode(&device.handle, MCP4822_CS_HARDWARE_NSS);
+	CHECK(MCP4822_stereo_init(&stereo, &device.handle, samples, PAIRS, 0) == MCP4822_OK);
+	CHECK(MCP4822_stream_init(&stream, &device.handle, buffer, ODD_LEN, MCP4822_stereo_refill, &stereo) == MCP4822_OK);
+	CHECK(MCP4822_stream_start(&stream) == MCP4822_OK);
+
+	while(stream.state != MCP4822_STREAM_IDLE && frames < 10 * PAIRS){
+
+		if(MCP4822_port_posix_dma_run(&device.tx_dma, 1) != 1){
+			break;
+		}
+
+		if(frames < 2 * PAIRS){
+			uint16_t frame = device.spi.last_frame;
+			int16_t sample = samples[frames];
+			uint16_t expected = (uint16_t)((((uint16_t)sample ^ 0x8000U) >> 4) | ((frames & 1) ? 0xB000 : 0x3000));
+			mismatches += (frame != expected);
+		}
+		frames++;
+		service_spi(&device);
+	}
+
+	CHECK(mismatches == 0);
+	CHECK(frames >= 2 * PAIRS);
+	CHECK(stream.state == MCP4822_STREAM_IDLE);
+	MCP4822_stream_stop(&stream);
+
+	//Refills straight from the player, odd counts included, are never short before the end
+	uint16_t out[7];
+	MCP4822_stereo_init(&stereo, &device.handle, samples, PAIRS, 1);
+	for(uint32_t i = 0; i < 100; i++){
+		CHECK(MCP4822_stereo_refill(&stereo, out, 7) == 7);
+		CHECK((out[0] >> 15) == (i & 1));
+	}
+}
+
+int main(void){
+
+	static const uint32_t rates[] = {8000, 11025, 22050, 44100, 48000, 96000};
+
+	printf("paced stream, one frame per timer update at %u Hz:\n", TIMER_CLOCK_HZ);
+	for(uint32_t i = 0; i < sizeof(rates) / sizeof(rates[0]); i++){
+		paced_rate(rates[i]);
+	}
+
+	paced_restores_dma();
+	unpaced_self_end();
+	pair_underrun_and_drain();
+	pair_latch_together();
+	volts_pair();
+	stereo_odd_halves();
+	rejects_byte_dma();
+
+	return test_result("test_stream");
+}
@@ -0,0 +1,1372 @@
+/*
+ * MCP4822_assetc.cpp
+ *
+ *  Created on: October 16, 2026
+ *      Author: agent
+ *
+ * Host asset compiler: converts a directory of WAV files into MCP4822 asset
+ * images (see include/MCP4822_asset.h), either as C sources for the
+ * .myAudioFiles section, as one linkable binary blob, or as an indexed sound
+ * bank (see include/MCP4822_bank.h). Bank images can be verified on their own.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread tools/MCP4822_assetc.cpp -o MCP4822_assetc
+ */
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/** Asset format constants, mirrored from MCP4822_asset.h which needs the target HAL */
+#define ASSET_MAGIC					   0x4150434DUL
+#define ASSET_VERSION				   2
+#define ASSET_HEADER_SIZE			   36
+#define ASSET_FLAG_LOOP				   0x01
+#define ASSET_FLAG_LOW_NIBBLE		   0x02
+#define ASSET_FLAG_SEEK_TABLE		   0x04
+#define ASSET_SEEK_ENTRY_SIZE		   4
+#define ASSET_ALIGN					   4
+
+/** Bank format constants, mirrored from MCP4822_bank.h */
+#define BANK_MAGIC					   0x4250434DUL
+#define BANK_VERSION				   1
+#define BANK_HEADER_SIZE			   16
+#define BANK_ENTRY_SIZE				   20
+#define BANK_SLOT_EMPTY				   0xFFFF
+#define BANK_SLOTS_MAX				   32768    //largest power of two in the uint16_t slot count
+#define BANK_ASSETS_MAX				   (BANK_SLOTS_MAX / 2)    //keeps the slot table at most half full
+#define FNV_OFFSET_BASIS			   0x811C9DC5UL
+#define FNV_PRIME					   0x01000193UL
+
+#define DAC_MAX						   4095
+#define ADPCM_STEP_INDEX_MAX		   88
+
+/** Resampler half width in zero crossings */
+#define SINC_HALF_WIDTH				   16
+
+/** pi, M_PI is not standard C++ */
+#define PI							   3.14159265358979323846
+
+/** Default decode block hint written to the header */
+#define DEFAULT_BLOCK_SIZE			   64
+
+/** Default ADPCM seek snapshot interval in samples, 4 bytes per 512 payload bytes */
+#define DEFAULT_SEEK_INTERVAL		   1024
+
+/**
+ * @brief Payload codec mapping, values match MCP4822_ASSET_CODEC
+ */
+enum Codec
+{
+	CODEC_PCM12				 = 0,
+	CODEC_IMA_ADPCM			 = 1,
+	CODEC_ULAW				 = 2
+};
+
+/**
+ * @brief Output kind
+ */
+enum OutputFormat
+{
+	OUTPUT_C,
+	OUTPUT_BINARY,
+	OUTPUT_BANK,
+	OUTPUT_BANK_C
+};
+
+/**
+ * @brief Command line options
+ */
+struct Options
+{
+
+	fs::path input_dir;
+
+	fs::path output;
+
+	Codec codec = CODEC_PCM12;
+
+	OutputFormat format = OUTPUT_C;
+
+	uint32_t sample_rate = 0;    //0 keeps each file's own rate
+
+	bool dither = true;
+
+	bool mono = false;
+
+	bool loop = false;
+
+	uint16_t block_size = DEFAULT_BLOCK_SIZE;
+
+	uint16_t seek_interval = DEFAULT_SEEK_INTERVAL;    //0 disables ADPCM seek tables
+
+	unsigned jobs = 0;    //0 uses every core
+
+	fs::path verify;    //bank image to check instead of compiling
+
+};
+
+/**
+ * @brief Decoded WAV file, samples normalized to -1 .. 1 and interleaved
+ */
+struct Audio
+{
+
+	uint32_t sample_rate = 0;
+
+	uint32_t channels = 0;
+
+	std::vector<float> samples;
+
+	bool has_loop = false;
+
+	uint32_t loop_start = 0;
+
+	uint32_t loop_end = 0;    //exclusive
+
+};
+
+/**
+ * @brief One compiled asset and its timings
+ */
+struct Result
+{
+
+	fs::path source;
+
+	std::string symbol;
+
+	std::vector<uint8_t> image;    //header followed by payload
+
+	uint32_t input_rate = 0;
+
+	uint32_t output_rate = 0;
+
+	uint32_t sample_count = 0;
+
+	uint32_t channels = 0;
+
+	double decode_ms = 0.0;
+
+	double encode_ms = 0.0;
+
+	std::string error;
+
+};
+
+/** IMA ADPCM quantizer step sizes, identical to the firmware decoder */
+static const int16_t adpcm_steps[ADPCM_STEP_INDEX_MAX + 1] =
+{
+	7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+	50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+	253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+	1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+	3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487,
+	12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+/** IMA ADPCM step index adjustment per code */
+static const int8_t adpcm_index_steps[16] =
+{
+	-1, -1, -1, -1, 2, 4, 6, 8,
+	-1, -1, -1, -1, 2, 4, 6, 8
+};
+
+/**
+ * @brief Reads a little-endian integer from a byte buffer
+ *
+ * @param data - source bytes
+ * @param bytes - integer width, 1 .. 4
+ *
+ * @return Value, zero extended
+ */
+static uint32_t read_le(const uint8_t *data, unsigned bytes){
+
+	uint32_t value = 0;
+	for(unsigned i = 0; i < bytes; i++){
+		value |= (uint32_t)data[i] << (8 * i);
+	}
+	return value;
+}
+
+/**
+ * @brief Appends a little-endian integer to a byte buffer
+ *
+ * @param out - destination buffer
+ * @param value - value to append
+ * @param bytes - integer width, 1 .. 4
+ *
+ * @return None
+ */
+static void write_le(std::vector<uint8_t> &out, uint32_t value, unsigned bytes){
+
+	for(unsigned i = 0; i < bytes; i++){
+		out.push_back((uint8_t)(value >> (8 * i)));
+	}
+}
+
+/**
+ * @brief Reads a whole file
+ *
+ * @param path - file to read
+ *
+ * @return File contents, throws std::runtime_error on I/O failure
+ */
+static std::vector<uint8_t> read_file(const fs::path &path){
+
+	std::ifstream file(path, std::ios::binary);
+	if(!file){
+		throw std::runtime_error("cannot open " + path.string());
+	}
+	return std::vector<uint8_t>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Writes a whole file
+ *
+ * @param path - file to write
+ * @param data - contents
+ *
+ * @return None, throws std::runtime_error on I/O failure
+ */
+static void write_file(const fs::path &path, const std::vector<uint8_t> &data){
+
+	std::ofstream out(path, std::ios::binary);
+	if(!out || !out.write((const char *)data.data(), (std::streamsize)data.size())){
+		throw std::runtime_error("cannot write " + path.string());
+	}
+}
+
+/**
+ * @brief Parses a RIFF/WAVE file holding integer or float PCM
+ *
+ * Reads the first sampler loop from a smpl chunk when one is present.
+ *
+ * @param path - WAV file
+ *
+ * @return Decoded audio, throws std::runtime_error on malformed input
+ */
+static Audio read_wav(const fs::path &path){
+
+	std::vector<uint8_t> bytes = read_file(path);
+
+	if(bytes.size() < 12 || std::memcmp(&bytes[0], "RIFF", 4) != 0 || std::memcmp(&bytes[8], "WAVE", 4) != 0){
+		throw std::runtime_error("not a RIFF/WAVE file");
+	}
+
+	Audio audio;
+	uint32_t format = 0;
+	uint32_t bits = 0;
+	const uint8_t *data = nullptr;
+	size_t data_size = 0;
+
+	//Walk the chunk list, chunks are padded to an even length
+	size_t pos = 12;
+	while(pos + 8 <= bytes.size()){
+		const uint8_t *chunk = &bytes[pos];
+		size_t size = read_le(chunk + 4, 4);
+		size_t avail = std::min(size, bytes.size() - pos - 8);
+
+		if(std::memcmp(chunk, "fmt ", 4) == 0 && avail >= 16){
+			format = read_le(chunk + 8, 2);
+			audio.channels = read_le(chunk + 10, 2);
+			audio.sample_rate = read_le(chunk + 12, 4);
+			bits = read_le(chunk + 22, 2);
+
+			//WAVE_FORMAT_EXTENSIBLE carries the real format in its sub-format GUID
+			if(format == 0xFFFE && avail >= 40){
+				format = read_le(chunk + 32, 2);
+			}
+		}
+		else if(std::memcmp(chunk, "data", 4) == 0){
+			data = chunk + 8;
+			data_size = avail;
+		}
+		else if(std::memcmp(chunk, "smpl", 4) == 0 && avail >= 36 + 24 && read_le(chunk + 36, 4) > 0){
+			audio.has_loop = true;
+			audio.loop_start = read_le(chunk + 8 + 36 + 8, 4);
+			audio.loop_end = read_le(chunk + 8 + 36 + 12, 4) + 1;
+		}
+
+		pos += 8 + size + (size & 1);
+	}
+
+	if(data == nullptr || audio.channels == 0 || audio.sample_rate == 0){
+		throw std::runtime_error("missing fmt or data chunk");
+	}
+	if(!(format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) && !(format == 3 && bits == 32)){
+		throw std::runtime_error("unsupported sample format (need 8/16/24/32-bit PCM or 32-bit float)");
+	}
+
+	unsigned width = bits / 8;
+	size_t count = data_size / width;
+	count -= count % audio.channels;
+	audio.samples.resize(count);
+
+	for(size_t i = 0; i < count; i++){
+		const uint8_t *p = data + i * width;
+		uint32_t raw = read_le(p, width);
+
+		if(format == 3){
+			float value;
+			std::memcpy(&value, &raw, sizeof(value));
+			audio.samples[i] = value;
+		}
+		else if(width == 1){
+			//8-bit WAV is the only unsigned width
+			audio.samples[i] = ((int32_t)raw - 128) / 128.0f;
+		}
+		else{
+			//Sign extend from the top bit of the sample width
+			int32_t value = (int32_t)(raw << (32 - bits));
+			audio.samples[i] = (float)(value / 2147483648.0);
+		}
+	}
+
+	uint32_t frames = (uint32_t)(count / audio.channels);
+	if(audio.has_loop && (audio.loop_start >= audio.loop_end || audio.loop_end > frames)){
+		audio.has_loop = false;
+	}
+
+	return audio;
+}
+
+/**
+ * @brief Averages all channels into one
+ *
+ * @param audio - audio to be downmixed in place
+ *
+ * @return None
+ */
+static void downmix(Audio &audio){
+
+	if(audio.channels == 1){
+		return;
+	}
+
+	size_t frames = audio.samples.size() / audio.channels;
+	for(size_t i = 0; i < frames; i++){
+		float sum = 0.0f;
+		for(uint32_t c = 0; c < audio.channels; c++){
+			sum += audio.samples[i * audio.channels + c];
+		}
+		audio.samples[i] = sum / audio.channels;
+	}
+	audio.samples.resize(frames);
+	audio.channels = 1;
+}
+
+/**
+ * @brief Band-limited resampling with a Blackman windowed sinc
+ *
+ * The cutoff follows the lower of the two rates, so downsampling is
+ * anti-aliased. Loop points are scaled to the new rate.
+ *
+ * @param audio - audio to be resampled in place
+ * @param rate - output sample rate
+ *
+ * @return None
+ */
+static void resample(Audio &audio, uint32_t rate){
+
+	if(rate == 0 || rate == audio.sample_rate){
+		return;
+	}
+
+	const double ratio = (double)audio.sample_rate / rate;
+	const double cutoff = std::min(1.0, 1.0 / ratio);
+	const int half_width = (int)std::ceil(SINC_HALF_WIDTH / cutoff);
+	const int64_t in_frames = (int64_t)(audio.samples.size() / audio.channels);
+	const int64_t out_frames = (int64_t)std::floor(in_frames / ratio);
+
+	std::vector<float> out((size_t)out_frames * audio.channels);
+
+	for(int64_t n = 0; n < out_frames; n++){
+		double t = n * ratio;
+		int64_t center = (int64_t)std::floor(t);
+
+		for(uint32_t c = 0; c < audio.channels; c++){
+			double sum = 0.0;
+
+			for(int64_t k = center - half_width + 1; k <= center + half_width; k++){
+				if(k < 0 || k >= in_frames){
+					continue;
+				}
+				double x = t - k;
+				double w = 0.42 + 0.5 * std::cos(PI * x / half_width) + 0.08 * std::cos(2.0 * PI * x / half_width);
+				double arg = PI * cutoff * x;
+				double sinc = (arg == 0.0) ? 1.0 : std::sin(arg) / arg;
+				sum += audio.samples[(size_t)k * audio.channels + c] * cutoff * sinc * w;
+			}
+
+			out[(size_t)n * audio.channels + c] = (float)sum;
+		}
+	}
+
+	if(audio.has_loop){
+		audio.loop_start = (uint32_t)std::llround(audio.loop_start / ratio);
+		audio.loop_end = std::min((uint32_t)std::llround(audio.loop_end / ratio), (uint32_t)out_frames);
+		audio.has_loop = audio.loop_start < audio.loop_end;
+	}
+
+	audio.samples.swap(out);
+	audio.sample_rate = rate;
+}
+
+/**
+ * @brief Quantizes a normalized sample to an integer range with optional TPDF dither
+ *
+ * @param sample - sample in -1 .. 1
+ * @param levels - number of output codes, e.g. 4096
+ * @param rng - per-file random source
+ * @param dither - add +-1 LSB triangular dither before rounding
+ *
+ * @return Code in 0 .. levels - 1
+ */
+static uint32_t quantize(float sample, uint32_t levels, std::mt19937 &rng, bool dither){
+
+	double code = (sample + 1.0) * 0.5 * (levels - 1);
+
+	if(dither){
+		std::uniform_real_distribution<double> lsb(-0.5, 0.5);
+		code += lsb(rng) + lsb(rng);
+	}
+
+	double rounded = std::floor(code + 0.5);
+	return (uint32_t)std::clamp(rounded, 0.0, (double)(levels - 1));
+}
+
+/**
+ * @brief Quantizes a normalized sample to signed 16-bit
+ *
+ * @param sample - sample in -1 .. 1
+ * @param rng - per-file random source
+ * @param dither - add +-1 LSB triangular dither before rounding
+ *
+ * @return Signed 16-bit sample
+ */
+static int16_t quantize_pcm16(float sample, std::mt19937 &rng, bool dither){
+
+	return (int16_t)((int32_t)quantize(sample, 65536, rng, dither) - 32768);
+}
+
+/**
+ * @brief Encodes one sample with IMA ADPCM, tracking the decoder exactly
+ *
+ * @param sample - signed 16-bit sample
+ * @param predictor - decoder predictor, updated in place
+ * @param step_index - decoder step index, updated in place
+ *
+ * @return 4-bit ADPCM code
+ */
+static uint8_t adpcm_encode(int16_t sample, int32_t &predictor, int32_t &step_index){
+
+	int32_t step = adpcm_steps[step_index];
+	int32_t delta = sample - predictor;
+	uint8_t code = 0;
+
+	if(delta < 0){
+		code = 8;
+		delta = -delta;
+	}
+	if(delta >= step){
+		code |= 4;
+		delta -= step;
+	}
+	if(delta >= (step >> 1)){
+		code |= 2;
+		delta -= step >> 1;
+	}
+	if(delta >= (step >> 2)){
+		code |= 1;
+	}
+
+	//Reconstruct as the firmware will, so the predictor never drifts
+	int32_t diff = step >> 3;
+	if(code & 4){
+		diff += step;
+	}
+	if(code & 2){
+		diff += step >> 1;
+	}
+	if(code & 1){
+		diff += step >> 2;
+	}
+
+	predictor = std::clamp(predictor + ((code & 8) ? -diff : diff), (int32_t)INT16_MIN, (int32_t)INT16_MAX);
+	step_index = std::clamp(step_index + adpcm_index_steps[code], 0, ADPCM_STEP_INDEX_MAX);
+
+	return code;
+}
+
+/**
+ * @brief Encodes one sample as a G.711 mu-law byte
+ *
+ * @param sample - signed 16-bit sample
+ *
+ * @return mu-law byte
+ */
+static uint8_t ulaw_encode(int16_t sample){
+
+	const int32_t bias = 0x84;
+	const int32_t clip = 32635;
+
+	int32_t magnitude = sample;
+	uint8_t sign = 0;
+	if(magnitude < 0){
+		sign = 0x80;
+		magnitude = -magnitude;
+	}
+	magnitude = std::min(magnitude, clip) + bias;
+
+	//Segment is the position of the top set bit above bit 7
+	uint8_t exponent = 7;
+	while(exponent > 0 && (magnitude & (0x4000 >> (7 - exponent))) == 0){
+		exponent--;
+	}
+	uint8_t mantissa = (magnitude >> (exponent + 3)) & 0x0F;
+
+	return (uint8_t)~(sign | (exponent << 4) | mantissa);
+}
+
+/**
+ * @brief Turns a file name into a C identifier
+ *
+ * @param path - source file
+ *
+ * @return Identifier built from the file stem
+ */
+static std::string make_symbol(const fs::path &path){
+
+	std::string symbol = path.stem().string();
+	for(char &c : symbol){
+		if(!std::isalnum((unsigned char)c)){
+			c = '_';
+		}
+	}
+	if(symbol.empty() || std::isdigit((unsigned char)symbol[0])){
+		symbol.insert(0, "asset_");
+	}
+	return symbol;
+}
+
+/**
+ * @brief Converts one WAV file into an asset image
+ *
+ * @param path - WAV file
+ * @param options - command line options
+ *
+ * @return Compiled asset, with error set on failure
+ */
+static Result compile_asset(const fs::path &path, const Options &options){
+
+	Result result;
+	result.source = path;
+	result.symbol = make_symbol(path);
+
+	try{
+		auto start = std::chrono::steady_clock::now();
+
+		Audio audio = read_wav(path);
+		result.input_rate = audio.sample_rate;
+
+		//ADPCM keeps one predictor, so it is always mono
+		if(options.mono || options.codec == CODEC_IMA_ADPCM || audio.channels > 2){
+			downmix(audio);
+		}
+		resample(audio, options.sample_rate);
+
+		auto decoded = std::chrono::steady_clock::now();
+
+		uint32_t channels = audio.channels;
+		uint32_t count = (uint32_t)(audio.samples.size() / channels);
+		if(count == 0){
+			throw std::runtime_error("no samples");
+		}
+
+		//Seed from the name so output is reproducible regardless of thread order
+		std::mt19937 rng((uint32_t)std::hash<std::string>{}(path.filename().string()));
+
+		std::vector<uint8_t> payload;
+		std::vector<uint8_t> seek_table;
+		bool seekable = options.codec == CODEC_IMA_ADPCM && options.seek_interval != 0;
+
+		switch(options.codec){
+			case CODEC_PCM12:
+				for(float sample : audio.samples){
+					write_le(payload, quantize(sample, DAC_MAX + 1, rng, options.dither), 2);
+				}
+				break;
+
+			case CODEC_IMA_ADPCM:{
+				int32_t predictor = 0;
+				int32_t step_index = 0;
+				for(uint32_t i = 0; i < count; i++){
+
+					//Snapshot the decoder state the player will need to resume at this sample
+					if(seekable && i % options.seek_interval == 0){
+						write_le(seek_table, (uint16_t)predictor, 2);
+						write_le(seek_table, (uint32_t)step_index, 1);
+						write_le(seek_table, 0, 1);
+					}
+
+					uint8_t code = adpcm_encode(quantize_pcm16(audio.samples[i], rng, options.dither), predictor, step_index);
+					if(i & 1){
+						payload.back() |= code;
+					}
+					else{
+						payload.push_back((uint8_t)(code << 4));
+					}
+				}
+				break;
+			}
+
+			case CODEC_ULAW:
+				for(float sample : audio.samples){
+					payload.push_back(ulaw_encode(quantize_pcm16(sample, rng, options.dither)));
+				}
+				break;
+		}
+
+		if(ASSET_HEADER_SIZE + seek_table.size() > UINT16_MAX){
+			throw std::runtime_error("seek table too large for the header, raise --seek");
+		}
+
+		bool loop = options.loop || audio.has_loop;
+		uint32_t loop_start = audio.has_loop ? audio.loop_start : 0;
+		uint32_t loop_end = audio.has_loop ? audio.loop_end : count;
+
+		std::vector<uint8_t> &image = result.image;
+		write_le(image, ASSET_MAGIC, 4);
+		write_le(image, ASSET_VERSION, 1);
+		write_le(image, options.codec, 1);
+		write_le(image, channels, 1);
+		write_le(image, (loop ? ASSET_FLAG_LOOP : 0) | (seekable ? ASSET_FLAG_SEEK_TABLE : 0), 1);
+		write_le(image, audio.sample_rate, 4);
+		write_le(image, count, 4);
+		write_le(image, loop_start, 4);
+		write_le(image, loop_end, 4);
+		write_le(image, options.block_size, 2);
+		write_le(image, ASSET_HEADER_SIZE + (uint32_t)seek_table.size(), 2);
+		write_le(image, (uint32_t)payload.size(), 4);
+		write_le(image, seekable ? options.seek_interval : 0, 2);
+		write_le(image, 0, 2);
+		image.insert(image.end(), seek_table.begin(), seek_table.end());
+		image.insert(image.end(), payload.begin(), payload.end());
+
+		auto encoded = std::chrono::steady_clock::now();
+
+		result.output_rate = audio.sample_rate;
+		result.sample_count = count;
+		result.channels = channels;
+		result.decode_ms = std::chrono::duration<double, std::milli>(decoded - start).count();
+		result.encode_ms = std::chrono::duration<double, std::milli>(encoded - decoded).count();
+	}
+	catch(const std::exception &e){
+		result.error = e.what();
+	}
+
+	return result;
+}
+
+/**
+ * @brief Writes bytes as the body of a C array initializer, twelve per line
+ *
+ * @param out - destination stream
+ * @param data - bytes to write
+ * @param size - number of bytes
+ * @param indent - tabs in front of each line
+ *
+ * @return None
+ */
+static void write_hex_bytes(std::ostream &out, const uint8_t *data, size_t size, const char *indent){
+
+	char hex[8];
+	for(size_t i = 0; i < size; i++){
+		std::snprintf(hex, sizeof(hex), "0x%02X", data[i]);
+		out << ((i % 12 == 0) ? "\n" : " ") << ((i % 12 == 0) ? indent : "") << hex << (i + 1 < size ? "," : "");
+	}
+	out << "\n";
+}
+
+/**
+ * @brief Writes one asset as a C source in the layout of audio_file/BellSound.c
+ *
+ * @param result - compiled asset
+ * @param dir - output directory
+ *
+ * @return None, throws std::runtime_error on I/O failure
+ */
+static void write_c_source(const Result &result, const fs::path &dir){
+
+	static const char *codec_names[] = { "MCP4822_CODEC_PCM12", "MCP4822_CODEC_IMA_ADPCM", "MCP4822_CODEC_ULAW" };
+	const uint8_t *image = result.image.data();
+	uint32_t header_size = read_le(image + 26, 2);
+	uint32_t payload_size = read_le(image + 28, 4);
+	uint32_t seek_entries = (header_size - ASSET_HEADER_SIZE) / ASSET_SEEK_ENTRY_SIZE;
+
+	std::ofstream out(dir / (result.symbol + ".c"));
+	if(!out){
+		throw std::runtime_error("cannot write " + result.symbol + ".c");
+	}
+
+	out << "/* Generated by MCP4822_assetc from " << result.source.filename().string() << ", do not edit */\n";
+	out << "#include \"audio_assets.h\"\n\n";
+	out << "const " << result.symbol << "_Asset_t __attribute__((section(\".myAudioFiles\"), aligned(4)))" << result.symbol << " = {\n";
+	out << "\t.header = {\n";
+	out << "\t\t.magic = MCP4822_ASSET_MAGIC,\n";
+	out << "\t\t.version = MCP4822_ASSET_VERSION,\n";
+	out << "\t\t.codec = " << codec_names[image[5]] << ",\n";
+	out << "\t\t.layout = " << (image[6] == 2 ? "MCP4822_LAYOUT_STEREO" : "MCP4822_LAYOUT_MONO") << ",\n";
+	std::string flags;
+	if(image[7] & ASSET_FLAG_LOOP){
+		flags = "MCP4822_ASSET_FLAG_LOOP";
+	}
+	if(image[7] & ASSET_FLAG_SEEK_TABLE){
+		flags += flags.empty() ? "MCP4822_ASSET_FLAG_SEEK_TABLE" : " | MCP4822_ASSET_FLAG_SEEK_TABLE";
+	}
+	out << "\t\t.flags = " << (flags.empty() ? "0" : flags) << ",\n";
+	out << "\t\t.sample_rate = " << read_le(image + 8, 4) << ",\n";
+	out << "\t\t.sample_count = " << read_le(image + 12, 4) << ",\n";
+	out << "\t\t.loop_start = " << read_le(image + 16, 4) << ",\n";
+	out << "\t\t.loop_end = " << read_le(image + 20, 4) << ",\n";
+	out << "\t\t.block_size = " << read_le(image + 24, 2) << ",\n";
+	out << "\t\t.header_size = offsetof(" << result.symbol << "_Asset_t, data),\n";
+	out << "\t\t.payload_size = " << payload_size << ",\n";
+	out << "\t\t.seek_interval = " << read_le(image + 32, 2) << "\n";
+	out << "\t},\n";
+
+	if(seek_entries != 0){
+		out << "\t.seek = {";
+		for(uint32_t i = 0; i < seek_entries; i++){
+			const uint8_t *entry = image + ASSET_HEADER_SIZE + i * ASSET_SEEK_ENTRY_SIZE;
+			out << ((i % 6 == 0) ? "\n\t" : " ") << "{ " << (int16_t)read_le(entry, 2) << ", " << (unsigned)entry[2] << ", 0 }"
+				<< (i + 1 < seek_entries ? "," : "");
+		}
+		out << "\n\t},\n";
+	}
+
+	out << "\t.data = {";
+	write_hex_bytes(out, image + header_size, payload_size, "\t");
+	out << "\t}\n};\n";
+}
+
+/**
+ * @brief Writes the header declaring every generated asset
+ *
+ * @param results - compiled assets
+ * @param dir - output directory
+ *
+ * @return None, throws std::runtime_error on I/O failure
+ */
+static void write_c_header(const std::vector<Result> &results, const fs::path &dir){
+
+	std::ofstream out(dir / "audio_assets.h");
+	if(!out){
+		throw std::runtime_error("cannot write audio_assets.h");
+	}
+
+	out << "/* Generated by MCP4822_assetc, do not edit */\n\n";
+	out << "#ifndef __AUDIO_ASSETS_H_\n#define __AUDIO_ASSETS_H_\n\n";
+	out << "#include <stddef.h>\n#include \"MCP4822_asset.h\"\n";
+
+	for(const Result &result : results){
+		uint32_t header_size = read_le(result.image.data() + 26, 2);
+
+		out << "\ntypedef struct\n{\n\n\tMCP4822_Asset_Header_t header;\n\n";
+		if(header_size > ASSET_HEADER_SIZE){
+			out << "\tMCP4822_Asset_Seek_t seek[" << (header_size - ASSET_HEADER_SIZE) / ASSET_SEEK_ENTRY_SIZE << "];\n\n";
+		}
+		out << "\tunsigned char data[" << read_le(result.image.data() + 28, 4) << "];\n\n";
+		out << "}" << result.symbol << "_Asset_t;\n\n";
+		out << "extern const " << result.symbol << "_Asset_t " << result.symbol << ";\n";
+	}
+
+	out << "\n#endif /* __AUDIO_ASSETS_H_ */\n";
+}
+
+/**
+ * @brief Writes all assets back to back, each on a word boundary
+ *
+ * @param results - compiled assets
+ * @param path - output file
+ *
+ * @return None, throws std::runtime_error on I/O failure
+ */
+static void write_binary(const std::vector<Result> &results, const fs::path &path){
+
+	std::vector<uint8_t> blob;
+	for(const Result &result : results){
+		std::printf("  0x%08zX  %s\n", blob.size(), result.symbol.c_str());
+		blob.insert(blob.end(), result.image.begin(), result.image.end());
+		blob.resize((blob.size() + ASSET_ALIGN - 1) & ~(size_t)(ASSET_ALIGN - 1), 0);
+	}
+
+	write_file(path, blob);
+}
+
+/**
+ * @brief 32-bit FNV-1a hash, identical to MCP4822_bank_hash
+ *
+ * @param name - asset name
+ *
+ * @return Name hash
+ */
+static uint32_t bank_hash(const std::string &name){
+
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for(char c : name){
+		hash ^= (uint8_t)c;
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+/**
+ * @brief Overwrites a little-endian integer inside a byte buffer
+ *
+ * @param out - destination buffer
+ * @param pos - byte offset
+ * @param value - value to store
+ * @param bytes - integer width, 1 .. 4
+ *
+ * @return None
+ */
+static void patch_le(std::vector<uint8_t> &out, size_t pos, uint32_t value, unsigned bytes){
+
+	for(unsigned i = 0; i < bytes; i++){
+		out[pos + i] = (uint8_t)(value >> (8 * i));
+	}
+}
+
+/**
+ * @brief Builds a bank image: header, table of contents, name hash slots, names, assets
+ *
+ * Asset IDs follow the sorted input order. The slot table is sized to at
+ * most half full so probes stay short.
+ *
+ * @param results - compiled assets
+ *
+ * @return Bank image, throws std::runtime_error on duplicate names or overflow
+ */
+static std::vector<uint8_t> build_bank(const std::vector<Result> &results){
+
+	if(results.size() > BANK_ASSETS_MAX){
+		throw std::runtime_error("too many assets for one bank, the limit is " + std::to_string(BANK_ASSETS_MAX));
+	}
+
+	uint32_t count = (uint32_t)results.size();
+	uint32_t slots = 1;
+	while(slots < count * 2 || slots <= count){
+		slots <<= 1;
+	}
+
+	//The header field is 16 bits wide, a wrapped slot count would produce an unreadable bank
+	if(slots > BANK_SLOTS_MAX){
+		throw std::logic_error("hash slot count " + std::to_string(slots) + " does not fit the bank header");
+	}
+
+	std::vector<uint8_t> bank;
+	write_le(bank, BANK_MAGIC, 4);
+	write_le(bank, BANK_VERSION, 1);
+	write_le(bank, 0, 1);
+	write_le(bank, count, 2);
+	write_le(bank, slots, 2);
+	write_le(bank, BANK_HEADER_SIZE, 2);
+	write_le(bank, 0, 4);    //total size, patched below
+
+	size_t toc = bank.size();
+	bank.resize(toc + (size_t)count * BANK_ENTRY_SIZE, 0);
+
+	//Open addressing with linear probing, mirrored by MCP4822_bank_find
+	std::vector<uint16_t> slot_ids(slots, BANK_SLOT_EMPTY);
+	for(uint32_t id = 0; id < count; id++){
+		uint32_t slot = bank_hash(results[id].symbol) & (slots - 1);
+		while(slot_ids[slot] != BANK_SLOT_EMPTY){
+			if(results[slot_ids[slot]].symbol == results[id].symbol){
+				throw std::runtime_error("duplicate asset name " + results[id].symbol);
+			}
+			slot = (slot + 1) & (slots - 1);
+		}
+		slot_ids[slot] = (uint16_t)id;
+	}
+	for(uint16_t id : slot_ids){
+		write_le(bank, id, 2);
+	}
+
+	std::vector<uint32_t> name_offsets;
+	for(const Result &result : results){
+		name_offsets.push_back((uint32_t)bank.size());
+		bank.insert(bank.end(), result.symbol.begin(), result.symbol.end());
+		bank.push_back(0);
+	}
+
+	for(uint32_t id = 0; id < count; id++){
+		const Result &result = results[id];
+		bank.resize((bank.size() + ASSET_ALIGN - 1) & ~(size_t)(ASSET_ALIGN - 1), 0);
+
+		size_t entry = toc + (size_t)id * BANK_ENTRY_SIZE;
+		patch_le(bank, entry, (uint32_t)bank.size(), 4);
+		patch_le(bank, entry + 4, (uint32_t)result.image.size(), 4);
+		patch_le(bank, entry + 8, bank_hash(result.symbol), 4);
+		patch_le(bank, entry + 12, name_offsets[id], 4);
+		patch_le(bank, entry + 16, result.image[5], 1);
+		patch_le(bank, entry + 17, result.image[6], 1);
+
+		bank.insert(bank.end(), result.image.begin(), result.image.end());
+	}
+
+	bank.resize((bank.size() + ASSET_ALIGN - 1) & ~(size_t)(ASSET_ALIGN - 1), 0);
+	patch_le(bank, 12, (uint32_t)bank.size(), 4);
+
+	return bank;
+}
+
+/**
+ * @brief Checks a bank image the way the firmware will read it
+ *
+ * Validates the header, every table of contents entry against its asset
+ * header, and that every name is found through the hash slots.
+ *
+ * @param bank - bank image
+ *
+ * @return Number of assets, throws std::runtime_error describing the first problem found
+ */
+static uint32_t verify_bank(const std::vector<uint8_t> &bank){
+
+	if(bank.size() < BANK_HEADER_SIZE || read_le(&bank[0], 4) != BANK_MAGIC || bank[4] != BANK_VERSION){
+		throw std::runtime_error("bad bank magic or version");
+	}
+
+	uint32_t count = read_le(&bank[6], 2);
+	uint32_t slots = read_le(&bank[8], 2);
+	uint32_t header_size = read_le(&bank[10], 2);
+	uint32_t total_size = read_le(&bank[12], 4);
+
+	if(total_size > bank.size() || header_size < BANK_HEADER_SIZE || (header_size & 3) != 0){
+		throw std::runtime_error("bad bank header or truncated image");
+	}
+	if(slots == 0 || (slots & (slots - 1)) != 0 || slots <= count){
+		throw std::runtime_error("hash slot count must be a power of two larger than the asset count");
+	}
+
+	size_t slot_table = header_size + (size_t)count * BANK_ENTRY_SIZE;
+	if(slot_table + (size_t)slots * 2 > total_size){
+		throw std::runtime_error("tables overrun the bank");
+	}
+
+	for(uint32_t id = 0; id < count; id++){
+		const uint8_t *entry = &bank[header_size + (size_t)id * BANK_ENTRY_SIZE];
+		uint32_t offset = read_le(entry, 4);
+		uint32_t length = read_le(entry + 4, 4);
+		uint32_t name_hash = read_le(entry + 8, 4);
+		uint32_t name_offset = read_le(entry + 12, 4);
+		std::string where = "asset " + std::to_string(id) + ": ";
+
+		if((offset & 3) != 0 || length < ASSET_HEADER_SIZE || (uint64_t)offset + length > total_size){
+			throw std::runtime_error(where + "offset or length out of range");
+		}
+
+		//Same checks as MCP4822_asset_load
+		const uint8_t *asset = &bank[offset];
+		uint32_t codec = asset[5];
+		uint32_t layout = asset[6];
+		uint32_t count_samples = read_le(asset + 12, 4);
+		uint32_t asset_header_size = read_le(asset + 26, 2);
+		uint32_t payload_size = read_le(asset + 28, 4);
+		uint32_t expected = (codec == CODEC_PCM12) ? count_samples * layout * 2 :
+							(codec == CODEC_IMA_ADPCM) ? (count_samples * layout + 1) / 2 : count_samples * layout;
+
+		if(read_le(asset, 4) != ASSET_MAGIC || asset[4] != ASSET_VERSION || codec > CODEC_ULAW || layout < 1 || layout > 2 ||
+		   (codec == CODEC_IMA_ADPCM && layout != 1) || count_samples == 0 || payload_size != expected ||
+		   asset_header_size < ASSET_HEADER_SIZE || (uint64_t)asset_header_size + payload_size > length){
+			throw std::runtime_error(where + "asset header invalid");
+		}
+		uint32_t seek_interval = read_le(asset + 32, 2);
+		if((asset[7] & ASSET_FLAG_SEEK_TABLE) &&
+		   (codec != CODEC_IMA_ADPCM || seek_interval == 0 ||
+			asset_header_size < ASSET_HEADER_SIZE + (count_samples + seek_interval - 1) / seek_interval * ASSET_SEEK_ENTRY_SIZE)){
+			throw std::runtime_error(where + "seek table does not fit in front of the payload");
+		}
+		if(entry[16] != codec || entry[17] != layout){
+			throw std::runtime_error(where + "table of contents format does not match asset header");
+		}
+
+		size_t name_end = name_offset;
+		while(name_end < total_size && bank[name_end] != 0){
+			name_end++;
+		}
+		if(name_end >= total_size){
+			throw std::runtime_error(where + "name out of range");
+		}
+		std::string name((const char *)&bank[name_offset], name_end - name_offset);
+		if(bank_hash(name) != name_hash){
+			throw std::runtime_error(where + "name hash mismatch for " + name);
+		}
+
+		//Probe exactly as the firmware does
+		uint32_t slot = name_hash & (slots - 1);
+		uint32_t probes = 0;
+		uint32_t found = BANK_SLOT_EMPTY;
+		while(probes++ < slots){
+			uint32_t candidate = read_le(&bank[slot_table + slot * 2], 2);
+			if(candidate == BANK_SLOT_EMPTY || candidate == id){
+				found = candidate;
+				break;
+			}
+			slot = (slot + 1) & (slots - 1);
+		}
+		if(found != id){
+			throw std::runtime_error(where + "name " + name + " not reachable through the hash slots");
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief Writes a bank as audio_bank.c and audio_bank.h with one ID per asset
+ *
+ * @param results - compiled assets, in ID order
+ * @param bank - bank image
+ * @param dir - output directory
+ *
+ * @return None, throws std::runtime_error on I/O failure
+ */
+static void write_bank_c(const std::vector<Result> &results, const std::vector<uint8_t> &bank, const fs::path &dir){
+
+	std::ofstream header(dir / "audio_bank.h");
+	std::ofstream source(dir / "audio_bank.c");
+	if(!header || !source){
+		throw std::runtime_error("cannot write audio_bank.c/.h");
+	}
+
+	header << "/* Generated by MCP4822_assetc, do not edit */\n\n";
+	header << "#ifndef __AUDIO_BANK_H_\n#define __AUDIO_BANK_H_\n\n";
+	header << "#include \"MCP4822_bank.h\"\n\n";
+	header << "#define AUDIO_BANK_SIZE\t\t\t\t   " << bank.size() << "\n\n";
+	header << "/**\n * @brief Asset IDs for MCP4822_bank_get\n */\ntypedef enum\n{\n";
+	for(size_t id = 0; id < results.size(); id++){
+		std::string name = results[id].symbol;
+		std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+		header << "\tAUDIO_ID_" << name << " = " << id << ",\n";
+	}
+	header << "\tAUDIO_ID_COUNT = " << results.size() << "\n\n}AUDIO_ID;\n\n";
+	header << "extern const uint8_t audio_bank[AUDIO_BANK_SIZE];\n\n";
+	header << "#endif /* __AUDIO_BANK_H_ */\n";
+
+	source << "/* Generated by MCP4822_assetc, do not edit */\n";
+	source << "#include \"audio_bank.h\"\n\n";
+	source << "const uint8_t __attribute__((section(\".myAudioFiles\"), aligned(4)))audio_bank[AUDIO_BANK_SIZE] = {";
+	write_hex_bytes(source, bank.data(), bank.size(), "\t");
+	source << "};\n";
+}
+
+/**
+ * @brief Prints usage
+ *
+ * @return None
+ */
+static void usage(void){
+
+	std::fprintf(stderr,
+		"usage: MCP4822_assetc [options] <wav_dir> <output>\n"
+		"       MCP4822_assetc --verify <bank.bin>\n"
+		"  --codec pcm12|adpcm|ulaw  payload codec (default pcm12)\n"
+		"  --format c|bin|bank|bankc C sources or a blob (default c), or a sound bank as a file or C source\n"
+		"  --rate HZ                 resample to HZ (default keeps each file's rate)\n"
+		"  --mono                    downmix to one channel\n"
+		"  --loop                    loop whole files that carry no smpl loop\n"
+		"  --block N                 decode block hint in samples (default 64)\n"
+		"  --seek N                  ADPCM seek snapshot every N samples, 0 for none (default 1024)\n"
+		"  --no-dither               round without TPDF dither\n"
+		"  --jobs N                  worker threads (default: all cores)\n");
+}
+
+/**
+ * @brief Parses a whole unsigned decimal option value
+ *
+ * @param text - option value
+ * @param max - largest accepted value
+ * @param value - filled with the parsed value
+ *
+ * @return true if text is a number in 0 .. max
+ */
+static bool parse_unsigned(const char *text, unsigned long max, unsigned long &value){
+
+	//strtoul would accept a sign, leading spaces and trailing junk
+	if(!std::isdigit((unsigned char)text[0])){
+		return false;
+	}
+
+	char *end = nullptr;
+	errno = 0;
+	value = std::strtoul(text, &end, 10);
+
+	return errno == 0 && *end == '\0' && value <= max;
+}
+
+/**
+ * @brief Parses the command line
+ *
+ * @param argc - argument count
+ * @param argv - arguments
+ * @param options - filled with the parsed options
+ *
+ * @return true if the command line is valid
+ */
+static bool parse_args(int argc, char **argv, Options &options){
+
+	std::vector<std::string> positional;
+	unsigned long value;
+
+	for(int i = 1; i < argc; i++){
+		std::string arg = argv[i];
+		bool has_value = i + 1 < argc;
+
+		if(arg == "--codec" && has_value){
+			std::string codec = argv[++i];
+			if(codec == "pcm12"){
+				options.codec = CODEC_PCM12;
+			}
+			else if(codec == "adpcm"){
+				options.codec = CODEC_IMA_ADPCM;
+			}
+			else if(codec == "ulaw"){
+				options.codec = CODEC_ULAW;
+			}
+			else{
+				return false;
+			}
+		}
+		else if(arg == "--format" && has_value){
+			std::string format = argv[++i];
+			if(format == "c"){
+				options.format = OUTPUT_C;
+			}
+			else if(format == "bin"){
+				options.format = OUTPUT_BINARY;
+			}
+			else if(format == "bank"){
+				options.format = OUTPUT_BANK;
+			}
+			else if(format == "bankc"){
+				options.format = OUTPUT_BANK_C;
+			}
+			else{
+				return false;
+			}
+		}
+		else if(arg == "--rate" && has_value){
+			if(!parse_unsigned(argv[++i], UINT32_MAX, value)){
+				return false;
+			}
+			options.sample_rate = (uint32_t)value;
+		}
+		else if(arg == "--block" && has_value){
+			if(!parse_unsigned(argv[++i], UINT16_MAX, value)){
+				return false;
+			}
+			options.block_size = (uint16_t)value;
+		}
+		else if(arg == "--seek" && has_value){
+			if(!parse_unsigned(argv[++i], UINT16_MAX, value)){
+				return false;
+			}
+			options.seek_interval = (uint16_t)value;
+		}
+		else if(arg == "--jobs" && has_value){
+			if(!parse_unsigned(argv[++i], UINT16_MAX, value)){
+				return false;
+			}
+			options.jobs = (unsigned)value;
+		}
+		else if(arg == "--verify" && has_value){
+			options.verify = argv[++i];
+		}
+		else if(arg == "--mono"){
+			options.mono = true;
+		}
+		else if(arg == "--loop"){
+			options.loop = true;
+		}
+		else if(arg == "--no-dither"){
+			options.dither = false;
+		}
+		else if(arg.rfind("--", 0) == 0){
+			return false;
+		}
+		else{
+			positional.push_back(arg);
+		}
+	}
+
+	if(!options.verify.empty()){
+		return positional.empty();
+	}
+	if(positional.size() != 2 || options.block_size == 0){
+		return false;
+	}
+	options.input_dir = positional[0];
+	options.output = positional[1];
+	return true;
+}
+
+int main(int argc, char **argv){
+
+	Options options;
+	if(!parse_args(argc, argv, options)){
+		usage();
+		return 2;
+	}
+
+	if(!options.verify.empty()){
+		try{
+			uint32_t count = verify_bank(read_file(options.verify));
+			std::printf("%s: ok, %u assets\n", options.verify.string().c_str(), count);
+			return 0;
+		}
+		catch(const std::exception &e){
+			std::fprintf(stderr, "%s: %s\n", options.verify.string().c_str(), e.what());
+			return 1;
+		}
+	}
+
+	std::vector<fs::path> inputs;
+	try{
+		for(const fs::directory_entry &entry : fs::directory_iterator(options.input_dir)){
+			std::string ext = entry.path().extension().string();
+			std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+			if(entry.is_regular_file() && ext == ".wav"){
+				inputs.push_back(entry.path());
+			}
+		}
+	}
+	catch(const std::exception &e){
+		std::fprintf(stderr, "error: %s\n", e.what());
+		return 1;
+	}
+
+	//Sorted input keeps the blob layout and generated header stable
+	std::sort(inputs.begin(), inputs.end());
+	if(inputs.empty()){
+		std::fprintf(stderr, "error: no .wav files in %s\n", options.input_dir.string().c_str());
+		return 1;
+	}
+
+	unsigned jobs = options.jobs ? options.jobs : std::max(1u, std::thread::hardware_concurrency());
+	jobs = std::min<unsigned>(jobs, (unsigned)inputs.size());
+
+	//Workers pull the next file index, each result slot is written by exactly one worker
+	std::vector<Result> results(inputs.size());
+	std::atomic<size_t> next(0);
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> workers;
+	for(unsigned t = 0; t < jobs; t++){
+		workers.emplace_back([&](){
+			for(size_t i = next++; i < inputs.size(); i = next++){
+				results[i] = compile_asset(inputs[i], options);
+			}
+		});
+	}
+	for(std::thread &worker : workers){
+		worker.join();
+	}
+
+	auto compiled = std::chrono::steady_clock::now();
+
+	int failures = 0;
+	double busy_ms = 0.0;
+	uint64_t total_samples = 0;
+	uint64_t total_bytes = 0;
+
+	for(const Result &result : results){
+		if(!result.error.empty()){
+			std::fprintf(stderr, "error: %s: %s\n", result.source.string().c_str(), result.error.c_str());
+			failures++;
+			continue;
+		}
+
+		double ms = result.decode_ms + result.encode_ms;
+		double rate = ms > 0.0 ? result.sample_count * result.channels / ms / 1000.0 : 0.0;
+		std::printf("%-24s %6u -> %6u Hz  %u ch  %9u samples  %8zu bytes  decode %8.2f ms  encode %8.2f ms  %8.2f Msamples/s\n",
+					result.symbol.c_str(), result.input_rate, result.output_rate, result.channels, result.sample_count,
+					result.image.size(), result.decode_ms, result.encode_ms, rate);
+
+		busy_ms += ms;
+		total_samples += (uint64_t)result.sample_count * result.channels;
+		total_bytes += result.image.size();
+	}
+
+	//Every format names assets by symbol, so two files may not map to the same one
+	std::map<std::string, const Result *> symbols;
+	for(const Result &result : results){
+		if(!result.error.empty()){
+			continue;
+		}
+
+		auto inserted = symbols.emplace(result.symbol, &result);
+		if(!inserted.second){
+			std::fprintf(stderr, "error: %s and %s both map to symbol %s\n", inserted.first->second->source.string().c_str(),
+						 result.source.string().c_str(), result.symbol.c_str());
+			failures++;
+		}
+	}
+
+	if(failures != 0){
+		return 1;
+	}
+
+	try{
+		if(options.format == OUTPUT_C){
+			fs::create_directories(options.output);
+			for(const Result &result : results){
+				write_c_source(result, options.output);
+			}
+			write_c_header(results, options.output);
+		}
+		else if(options.format == OUTPUT_BINARY){
+			write_binary(results, options.output);
+		}
+		else{
+			//Every bank is checked before it is written
+			std::vector<uint8_t> bank = build_bank(results);
+			verify_bank(bank);
+
+			if(options.format == OUTPUT_BANK){
+				write_file(options.output, bank);
+			}
+			else{
+				fs::create_directories(options.output);
+				write_bank_c(results, bank, options.output);
+			}
+		}
+	}
+	catch(const std::exception &e){
+		std::fprintf(stderr, "error: %s\n", e.what());
+		return 1;
+	}
+
+	double wall_ms = std::chrono::duration<double, std::milli>(compiled - start).count();
+	std::printf("total: %zu files, %llu samples, %llu bytes in %.2f ms on %u threads (%.2f Msamples/s, %.2fx parallel speedup)\n",
+				results.size(), (unsigned long long)total_samples, (unsigned long long)total_bytes, wall_ms, jobs,
+				wall_ms > 0.0 ? total_samples / wall_ms / 1000.0 : 0.0, wall_ms > 0.0 ? busy_ms / wall_ms : 0.0);
+
+	return 0;
+}